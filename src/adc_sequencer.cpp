@@ -0,0 +1,528 @@
+#include "adc_sequencer.h"
+
+#ifdef ADC_SEQUENCER
+#include <Arduino.h>
+#if !defined(ADC_SEQUENCER_MOCK) && (defined(ESP32_PLATFORM) || defined(ESP32))
+#include <driver/adc.h>
+#endif
+#endif
+
+namespace AdcSequencer {
+
+Sequencer::Sequencer()
+    : m_valid_mask(0)
+    , m_count(0)
+    , m_index(0)
+    , m_discard(true)
+{
+    for (uint8_t i = 0; i < MAX_CHANNELS; i++) {
+        m_channels[i] = 0;
+        m_values[i] = 0;
+        m_sums[i] = 0;
+        m_counts[i] = 0;
+    }
+}
+
+bool Sequencer::setChannels(const uint8_t* channels, uint8_t count)
+{
+    if (count > MAX_CHANNELS) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        m_channels[i] = channels[i];
+        m_sums[i] = 0;
+        m_counts[i] = 0;
+    }
+    m_count = count;
+    m_index = 0;
+    m_valid_mask = 0;
+    m_discard = true; // The mux was just pointed at the first channel
+    return true;
+}
+
+uint8_t Sequencer::onConversion(uint16_t raw)
+{
+    if (m_count == 0) {
+        return 0;
+    }
+
+    if (m_discard) {
+        // First result after a mux switch - convert the same channel again
+        m_discard = false;
+        return m_channels[m_index];
+    }
+
+    store(m_index, raw);
+
+    uint8_t next = (uint8_t)((m_index + 1) % m_count);
+    if (m_channels[next] != m_channels[m_index]) {
+        m_discard = true;
+    }
+    m_index = next;
+    return m_channels[m_index];
+}
+
+void Sequencer::onSample(uint8_t channel, uint16_t raw)
+{
+    for (uint8_t i = 0; i < m_count; i++) {
+        if (m_channels[i] == channel) {
+            store(i, raw);
+        }
+    }
+}
+
+void Sequencer::store(uint8_t slot, uint16_t raw)
+{
+    m_values[slot] = raw;
+    m_valid_mask |= (uint8_t)(1 << slot);
+
+    // Sum for oversampling; restart if nobody took the sum in time
+    if (m_counts[slot] >= MAX_ACCUMULATED) {
+        m_sums[slot] = 0;
+        m_counts[slot] = 0;
+    }
+    m_sums[slot] += raw;
+    m_counts[slot]++;
+}
+
+bool Sequencer::getValue(uint8_t slot, uint16_t& value) const
+{
+    if (slot >= m_count || !(m_valid_mask & (1 << slot))) {
+        return false;
+    }
+    value = m_values[slot];
+    return true;
+}
+
+bool Sequencer::takeAccumulated(uint8_t slot, uint16_t& sum, uint8_t& count)
+{
+    if (slot >= m_count || m_counts[slot] == 0) {
+        return false;
+    }
+    sum = m_sums[slot];
+    count = m_counts[slot];
+    m_sums[slot] = 0;
+    m_counts[slot] = 0;
+    return true;
+}
+
+bool Sequencer::hasAllValues() const
+{
+    return m_count > 0 && m_valid_mask == (uint8_t)((1 << m_count) - 1);
+}
+
+#ifdef ADC_SEQUENCER
+
+// Time begin() waits for the first full cycle before giving up
+constexpr unsigned long FIRST_CYCLE_TIMEOUT_US = 10000;
+
+static Sequencer g_sequencer;
+static uint8_t g_pins[MAX_CHANNELS];
+static uint8_t g_channels[MAX_CHANNELS];
+static uint8_t g_count = 0;
+static volatile bool g_running = false;
+
+#if defined(__AVR__) || defined(ARDUINO_ARCH_SAM)
+// Values are written by the ADC interrupt - read them with interrupts off
+#define SEQUENCER_LOCK() noInterrupts()
+#define SEQUENCER_UNLOCK() interrupts()
+#else
+// Values are drained by poll() in the reading context
+#define SEQUENCER_LOCK() ((void)0)
+#define SEQUENCER_UNLOCK() ((void)0)
+#endif
+
+#if defined(ADC_SEQUENCER_MOCK)
+
+// Conversions queued by mockSample(), as if written by the DMA
+constexpr uint8_t MOCK_BUFFER_SIZE = 64;
+static uint8_t g_mock_channels[MOCK_BUFFER_SIZE];
+static uint16_t g_mock_values[MOCK_BUFFER_SIZE];
+static uint8_t g_mock_count = 0;
+
+// A0 = 14, like the AVR boards
+static bool pinToChannel(uint8_t pin, uint8_t& channel)
+{
+    channel = pin >= 14 ? pin - 14 : pin;
+    return true;
+}
+
+static void hwStart()
+{
+    g_mock_count = 0;
+}
+
+static void hwStop()
+{
+    g_mock_count = 0;
+}
+
+static void poll()
+{
+    for (uint8_t i = 0; i < g_mock_count; i++) {
+        g_sequencer.onSample(g_mock_channels[i], g_mock_values[i]);
+    }
+    g_mock_count = 0;
+}
+
+bool mockSample(uint8_t pin, uint16_t raw)
+{
+    if (!g_running || g_mock_count >= MOCK_BUFFER_SIZE) {
+        return false;
+    }
+    pinToChannel(pin, g_mock_channels[g_mock_count]);
+    g_mock_values[g_mock_count] = raw;
+    g_mock_count++;
+    return true;
+}
+
+#elif defined(__AVR__)
+
+// Map an Arduino analog pin (A0 or 0) to an ADC mux channel (same as analogRead())
+static bool pinToChannel(uint8_t pin, uint8_t& channel)
+{
+#if defined(analogPinToChannel)
+#if defined(__AVR_ATmega32U4__)
+    if (pin >= 18) {
+        pin -= 18;
+    }
+#endif
+    channel = analogPinToChannel(pin);
+#elif defined(__AVR_ATmega1280__) || defined(__AVR_ATmega2560__)
+    if (pin >= 54) {
+        pin -= 54;
+    }
+    channel = pin;
+#else
+    if (pin >= 14) {
+        pin -= 14;
+    }
+    channel = pin;
+#endif
+    return true;
+}
+
+// Point the mux at a channel (AVcc reference, like analogRead()) and start a conversion
+static void startConversion(uint8_t channel)
+{
+#if defined(MUX5)
+    ADCSRB = (ADCSRB & ~(1 << MUX5)) | (((channel >> 3) & 0x01) << MUX5);
+#endif
+    ADMUX = (1 << REFS0) | (channel & 0x07);
+    ADCSRA |= (1 << ADIE) | (1 << ADSC);
+}
+
+ISR(ADC_vect)
+{
+    uint16_t raw = ADC;
+    uint8_t next = g_sequencer.onConversion(raw);
+    if (g_running) {
+        startConversion(next);
+    }
+}
+
+static void hwStart()
+{
+    g_sequencer.discardNext();
+    startConversion(g_sequencer.currentChannel());
+}
+
+static void hwStop()
+{
+    // Let the conversion in progress finish, then disable the interrupt
+    while (ADCSRA & (1 << ADSC)) {
+    }
+    ADCSRA &= ~(1 << ADIE);
+    ADCSRA |= (1 << ADIF); // Clear a pending completion flag
+}
+
+static void poll()
+{
+    // Results arrive by interrupt
+}
+
+#elif defined(ARDUINO_ARCH_SAM)
+
+// Timer-triggered scans of all channels per second (the rate of every channel)
+constexpr uint32_t DMA_SCAN_RATE_HZ = 2000;
+
+// Scans per PDC buffer - one interrupt per buffer
+constexpr uint8_t DMA_SCANS_PER_BUFFER = 8;
+constexpr uint16_t DMA_BUFFER_SIZE = MAX_CHANNELS * DMA_SCANS_PER_BUFFER;
+
+// Double buffer: the PDC fills one while the interrupt unpacks the other
+static uint16_t g_dma_buffers[2][DMA_BUFFER_SIZE];
+static uint8_t g_dma_done = 0; // Buffer that completes next
+static uint16_t g_dma_length = 0; // Samples per buffer (channels x scans)
+
+// Map an Arduino analog pin (A0 or 0) to an ADC channel (same as analogRead())
+static bool pinToChannel(uint8_t pin, uint8_t& channel)
+{
+    if (pin < A0) {
+        pin += A0;
+    }
+    if (pin >= PINS_COUNT || g_APinDescription[pin].ulADCChannelNumber == NO_ADC) {
+        return false;
+    }
+    channel = (uint8_t)g_APinDescription[pin].ulADCChannelNumber;
+    return true;
+}
+
+void ADC_Handler()
+{
+    if (!(ADC->ADC_ISR & ADC_ISR_ENDRX)) {
+        return;
+    }
+
+    // The PDC moved on to the other buffer - unpack the full one and queue it again
+    const uint16_t* samples = g_dma_buffers[g_dma_done];
+    for (uint16_t i = 0; i < g_dma_length; i++) {
+        // Channel tag in bits 12-15; 12-bit result scaled to 10 bits like analogRead()
+        g_sequencer.onSample((uint8_t)(samples[i] >> 12), (uint16_t)((samples[i] & 0x0FFF) >> 2));
+    }
+    ADC->ADC_RNPR = (uint32_t)samples;
+    ADC->ADC_RNCR = g_dma_length;
+    g_dma_done ^= 1;
+}
+
+static void hwStart()
+{
+    uint32_t mask = 0;
+    for (uint8_t i = 0; i < g_count; i++) {
+        mask |= 1UL << g_channels[i];
+    }
+    g_dma_length = g_count * DMA_SCANS_PER_BUFFER;
+
+    // Each TIOA0 rising edge converts all enabled channels; tag each result
+    pmc_enable_periph_clk(ID_ADC);
+    ADC->ADC_CHDR = 0xFFFF;
+    ADC->ADC_CHER = mask;
+    ADC->ADC_EMR |= ADC_EMR_TAG;
+    ADC->ADC_MR = (ADC->ADC_MR & ~(ADC_MR_TRGSEL_Msk | ADC_MR_FREERUN_ON)) | ADC_MR_TRGEN_EN | ADC_MR_TRGSEL_ADC_TRIG1;
+
+    // Double-buffered PDC transfer, interrupt when a buffer is full
+    g_dma_done = 0;
+    ADC->ADC_RPR = (uint32_t)g_dma_buffers[0];
+    ADC->ADC_RCR = g_dma_length;
+    ADC->ADC_RNPR = (uint32_t)g_dma_buffers[1];
+    ADC->ADC_RNCR = g_dma_length;
+    ADC->ADC_PTCR = ADC_PTCR_RXTEN;
+    ADC->ADC_IDR = 0xFFFFFFFF;
+    ADC->ADC_IER = ADC_IER_ENDRX;
+    NVIC_EnableIRQ(ADC_IRQn);
+
+    // TC0 channel 0 drives TIOA0: low at RA, high at RC
+    pmc_set_writeprotect(false);
+    pmc_enable_periph_clk(ID_TC0);
+    TC_Configure(TC0, 0, TC_CMR_WAVE | TC_CMR_WAVSEL_UP_RC | TC_CMR_TCCLKS_TIMER_CLOCK1 | TC_CMR_ACPA_CLEAR | TC_CMR_ACPC_SET); // MCK/2
+    uint32_t rc = VARIANT_MCK / 2 / DMA_SCAN_RATE_HZ;
+    TC_SetRC(TC0, 0, rc);
+    TC_SetRA(TC0, 0, rc / 2);
+    TC_Start(TC0, 0);
+}
+
+static void hwStop()
+{
+    TC_Stop(TC0, 0);
+    NVIC_DisableIRQ(ADC_IRQn);
+    ADC->ADC_IDR = ADC_IDR_ENDRX;
+    ADC->ADC_PTCR = ADC_PTCR_RXTDIS;
+
+    // Back to untagged software-started conversions, as analogRead() expects
+    ADC->ADC_MR &= ~(ADC_MR_TRGEN_EN | ADC_MR_TRGSEL_Msk);
+    ADC->ADC_EMR &= ~ADC_EMR_TAG;
+    for (uint8_t i = 0; i < g_count; i++) {
+        ADC->ADC_CHDR = 1UL << g_channels[i];
+    }
+}
+
+static void poll()
+{
+    // Results arrive by interrupt
+}
+
+#elif defined(ESP32_PLATFORM) || defined(ESP32)
+
+// Total conversion rate of the continuous mode (20 kHz is the ESP32 minimum)
+constexpr uint32_t DMA_SAMPLE_RATE_HZ = 20000;
+
+// Driver buffer (~25 ms of conversions) and DMA frame size in bytes
+constexpr uint32_t DMA_STORE_BYTES = 1024;
+constexpr uint32_t DMA_FRAME_BYTES = 128;
+
+// Map a GPIO to an ADC1 channel - continuous mode only drives ADC1,
+// so ADC2 pins stay on analogRead()
+static bool pinToChannel(uint8_t pin, uint8_t& channel)
+{
+    int8_t ch = digitalPinToAnalogChannel(pin);
+    if (ch < 0 || ch > 7) {
+        return false;
+    }
+    channel = (uint8_t)ch;
+    return true;
+}
+
+static void hwStart()
+{
+    adc_digi_pattern_config_t pattern[MAX_CHANNELS] = {};
+    uint32_t mask = 0;
+    for (uint8_t i = 0; i < g_count; i++) {
+        pattern[i].atten = ADC_ATTEN_DB_11; // Full range, like analogRead()
+        pattern[i].channel = g_channels[i];
+        pattern[i].unit = 0; // ADC1
+        pattern[i].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+        mask |= 1UL << g_channels[i];
+    }
+
+    adc_digi_init_config_t init = {};
+    init.max_store_buf_size = DMA_STORE_BYTES;
+    init.conv_num_each_intr = DMA_FRAME_BYTES;
+    init.adc1_chan_mask = mask;
+    init.adc2_chan_mask = 0;
+    adc_digi_initialize(&init);
+
+    adc_digi_configuration_t config = {};
+    config.conv_limit_en = true; // Required on ESP32
+    config.conv_limit_num = 250;
+    config.pattern_num = g_count;
+    config.adc_pattern = pattern;
+    config.sample_freq_hz = DMA_SAMPLE_RATE_HZ;
+    config.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+    config.format = ADC_DIGI_OUTPUT_FORMAT_TYPE1;
+    adc_digi_controller_configure(&config);
+    adc_digi_start();
+}
+
+static void hwStop()
+{
+    adc_digi_stop();
+    adc_digi_deinitialize();
+}
+
+// Move the conversions the DMA wrote since the last call into the sequencer
+static void poll()
+{
+    static uint8_t frame[DMA_FRAME_BYTES];
+    for (;;) {
+        uint32_t length = 0;
+        // ESP_ERR_INVALID_STATE only reports that old conversions were dropped
+        esp_err_t err = adc_digi_read_bytes(frame, sizeof(frame), &length, 0);
+        if ((err != ESP_OK && err != ESP_ERR_INVALID_STATE) || length == 0) {
+            return;
+        }
+        for (uint32_t i = 0; i + sizeof(adc_digi_output_data_t) <= length; i += sizeof(adc_digi_output_data_t)) {
+            const adc_digi_output_data_t* out = reinterpret_cast<const adc_digi_output_data_t*>(&frame[i]);
+            g_sequencer.onSample(out->type1.channel, out->type1.data); // 12 bits like analogRead()
+        }
+    }
+}
+
+#else
+#error "ADC_SEQUENCER is not supported on this platform"
+#endif
+
+// Find the sequence slot of a pin (-1 if not sequenced)
+static int8_t findSlot(uint8_t pin)
+{
+    for (uint8_t i = 0; i < g_count; i++) {
+        if (g_pins[i] == pin) {
+            return (int8_t)i;
+        }
+    }
+    return -1;
+}
+
+void begin(const uint8_t* pins, uint8_t count)
+{
+    stop();
+
+    // Keep the pins the backend can convert
+    g_count = 0;
+    for (uint8_t i = 0; i < count && g_count < MAX_CHANNELS; i++) {
+        if (pinToChannel(pins[i], g_channels[g_count])) {
+            g_pins[g_count++] = pins[i];
+        }
+    }
+    g_sequencer.setChannels(g_channels, g_count);
+    if (g_count == 0) {
+        return; // No analog pins
+    }
+
+    start();
+
+#ifndef ADC_SEQUENCER_MOCK
+    // Wait for a first value per pin so scans never see an empty table
+    unsigned long start_us = micros();
+    while (!g_sequencer.hasAllValues() && micros() - start_us < FIRST_CYCLE_TIMEOUT_US) {
+        poll();
+    }
+#endif
+}
+
+void stop()
+{
+    if (!g_running) {
+        return;
+    }
+    g_running = false;
+    hwStop();
+}
+
+void start()
+{
+    if (g_running || g_count == 0) {
+        return;
+    }
+    g_running = true;
+    hwStart();
+}
+
+bool isRunning()
+{
+    return g_running;
+}
+
+bool read(uint8_t pin, uint16_t& value)
+{
+    if (!g_running) {
+        return false;
+    }
+
+    int8_t slot = findSlot(pin);
+    if (slot < 0) {
+        return false;
+    }
+    poll();
+
+    // 16-bit value written by the ISR - read it atomically
+    SEQUENCER_LOCK();
+    bool valid = g_sequencer.getValue((uint8_t)slot, value);
+    SEQUENCER_UNLOCK();
+    return valid;
+}
+
+bool readAccumulated(uint8_t pin, uint16_t& sum, uint8_t& count)
+{
+    if (!g_running) {
+        return false;
+    }
+
+    int8_t slot = findSlot(pin);
+    if (slot < 0) {
+        return false;
+    }
+    poll();
+
+    SEQUENCER_LOCK();
+    if (!g_sequencer.takeAccumulated((uint8_t)slot, sum, count)) {
+        sum = 0;
+        count = 0;
+    }
+    SEQUENCER_UNLOCK();
+    return true;
+}
+
+#endif // ADC_SEQUENCER
+
+} // namespace AdcSequencer
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <stdint.h>
+
+// Background ADC sequencer - converts the configured analog pins continuously
+// and keeps the latest value per pin, so AnalogSensor::scan() reads a table
+// instead of waiting for analogRead() (~100 us on AVR, more on ESP32).
+//
+// Backends:
+// - AVR: the ADC-complete interrupt starts the next conversion
+// - SAM (Due): timer-triggered scan of all channels, written by the PDC (DMA)
+// - ESP32: continuous (DMA) mode of ADC1, drained when a value is read
+// - Mock (-D ADC_SEQUENCER_MOCK, native tests): samples queued by the test
+//
+// Enabled by default on these boards; disable with -D NO_ADC_SEQUENCER in
+// build_flags. While running the sequencer owns the ADC - analogRead() must not
+// be used on a sequenced pin until stop() is called.
+#if defined(ADC_SEQUENCER_MOCK)
+#define ADC_SEQUENCER
+#define ADC_SEQUENCER_DMA
+#elif defined(NO_ADC_SEQUENCER)
+// Disabled
+#elif defined(__AVR__)
+#define ADC_SEQUENCER
+#elif defined(ARDUINO_ARCH_SAM) || defined(ESP32_PLATFORM) || defined(ESP32)
+#define ADC_SEQUENCER
+#define ADC_SEQUENCER_DMA
+#endif
+
+namespace AdcSequencer {
+
+// Maximum number of sequenced pins (matches MAX_SENSORS)
+constexpr uint8_t MAX_CHANNELS = 8;
+
+// Bits per conversion, matching analogRead() (12 on ESP32, 10 elsewhere)
+#if !defined(ADC_SEQUENCER_MOCK) && (defined(ESP32_PLATFORM) || defined(ESP32))
+constexpr uint8_t SAMPLE_BITS = 12;
+#else
+constexpr uint8_t SAMPLE_BITS = 10;
+#endif
+
+// Maximum conversions summed per channel between takeAccumulated() calls, so
+// the sum fits 16 bits (64 x 10-bit, enough for 4^3 oversampling; 16 x 12-bit)
+constexpr uint8_t MAX_ACCUMULATED = 1 << (16 - SAMPLE_BITS);
+
+/**
+ * Conversion sequence state machine (hardware independent).
+ *
+ * The ADC-complete interrupt passes each result to onConversion(), which
+ * stores it and returns the channel for the next conversion. The first
+ * conversion after a mux switch is discarded, because the sample-and-hold
+ * capacitor may still carry charge from the previous channel.
+ */
+class Sequencer {
+public:
+    Sequencer();
+
+    /**
+     * Set the channels to cycle through and restart at the first one
+     * @param channels ADC mux channel numbers
+     * @param count Number of channels (at most MAX_CHANNELS, 0 = none)
+     * @return false if count is too large (sequence unchanged)
+     */
+    bool setChannels(const uint8_t* channels, uint8_t count);
+
+    /**
+     * Handle a finished conversion
+     * @param raw Conversion result for currentChannel()
+     * @return Channel to convert next
+     */
+    uint8_t onConversion(uint16_t raw);
+
+    /**
+     * Handle a conversion tagged with its channel (DMA backends - the
+     * hardware sequences the channels and lets each one settle, so nothing
+     * is discarded)
+     * @param channel ADC channel the result belongs to
+     * @param raw Conversion result
+     */
+    void onSample(uint8_t channel, uint16_t raw);
+
+    /**
+     * Discard the next result (the mux was changed outside the sequence,
+     * e.g. by analogRead() while the sequencer was stopped)
+     */
+    void discardNext() { m_discard = true; }
+
+    /**
+     * Get the channel of the conversion in progress
+     * @return ADC mux channel number
+     */
+    uint8_t currentChannel() const { return m_channels[m_index]; }
+
+    /**
+     * Get the latest value of a channel
+     * @param slot Channel index in the order given to setChannels()
+     * @param value Receives the latest conversion result
+     * @return false if the slot is invalid or has no sample yet
+     */
+    bool getValue(uint8_t slot, uint16_t& value) const;
+
+    /**
+     * Take the sum of all conversions of a channel since the last call
+     * (for oversampling - no conversion is counted twice or lost, up to
+     * MAX_ACCUMULATED per call; beyond that the sum restarts)
+     * @param slot Channel index in the order given to setChannels()
+     * @param sum Receives the sum of the conversions
+     * @param count Receives the number of conversions summed
+     * @return false if the slot is invalid or has no new conversion
+     */
+    bool takeAccumulated(uint8_t slot, uint16_t& sum, uint8_t& count);
+
+    /**
+     * Check if every channel has at least one sample
+     * @return true once a full cycle has completed since setChannels()
+     */
+    bool hasAllValues() const;
+
+    /**
+     * Get the number of channels in the sequence
+     * @return Channel count
+     */
+    uint8_t getChannelCount() const { return m_count; }
+
+private:
+    // Store a result for a slot
+    void store(uint8_t slot, uint16_t raw);
+
+    uint8_t m_channels[MAX_CHANNELS];
+    volatile uint16_t m_values[MAX_CHANNELS];
+    volatile uint16_t m_sums[MAX_CHANNELS]; // Conversions since takeAccumulated()
+    volatile uint8_t m_counts[MAX_CHANNELS];
+    volatile uint8_t m_valid_mask; // Bit per slot: has a sample
+    uint8_t m_count;
+    uint8_t m_index;
+    bool m_discard; // Next result follows a mux switch
+};
+
+#ifdef ADC_SEQUENCER
+
+// Start sequencing the given analog pins (e.g. A0); replaces any previous set.
+// Blocks until every pin has a first sample (~2 ms for 8 pins).
+// Pins the backend can't convert (ADC2 pins on ESP32) are left to analogRead().
+void begin(const uint8_t* pins, uint8_t count);
+
+// Stop after the conversion in progress - analogRead() works again afterwards
+void stop();
+
+// Resume sequencing the pins given to begin() (keeps the old values until refreshed)
+void start();
+
+// Check if the sequencer is running
+bool isRunning();
+
+// Get the latest value of a pin
+// Returns false if the sequencer isn't running or the pin isn't sequenced
+// (the caller then falls back to analogRead())
+bool read(uint8_t pin, uint16_t& value);
+
+// Take the sum and count of a pin's conversions since the last call
+// Returns false if the sequencer isn't running or the pin isn't sequenced
+// (count is 0 when there was no new conversion)
+bool readAccumulated(uint8_t pin, uint16_t& sum, uint8_t& count);
+
+#ifdef ADC_SEQUENCER_MOCK
+// Queue a conversion as the DMA would deliver it (SAMPLE_BITS, picked up by the next read)
+// Returns false if the mock buffer is full or the sequencer isn't running
+bool mockSample(uint8_t pin, uint16_t raw);
+#endif
+
+#endif // ADC_SEQUENCER
+
+} // namespace AdcSequencer
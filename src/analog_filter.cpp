@@ -0,0 +1,104 @@
+#include "analog_filter.h"
+
+namespace Sensor {
+
+AnalogFilter::AnalogFilter(FilterType type, uint8_t param1, uint8_t param2)
+    : m_type(type)
+    , m_alpha(0)
+    , m_beta(0)
+{
+    switch (type) {
+    case FilterType::Ema:
+        m_alpha = param1 != 0 ? param1 : DEFAULT_EMA_ALPHA;
+        break;
+    case FilterType::OneEuro:
+        m_alpha = param1 != 0 ? param1 : DEFAULT_MIN_ALPHA;
+        m_beta = param2 != 0 ? param2 : DEFAULT_BETA;
+        break;
+    case FilterType::Median3:
+        break;
+    default:
+        m_type = FilterType::None; // Unknown filter - pass samples through
+        break;
+    }
+
+    reset();
+}
+
+void AnalogFilter::reset()
+{
+    m_primed = false;
+    m_state = 0;
+    m_slope = 0;
+    m_history[0] = 0;
+    m_history[1] = 0;
+    m_history[2] = 0;
+}
+
+uint16_t AnalogFilter::update(uint16_t sample)
+{
+    int32_t x = (int32_t)sample << 8;
+
+    // First sample: start from it instead of ramping up from 0
+    if (!m_primed) {
+        m_primed = true;
+        m_state = x;
+        m_slope = 0;
+        m_history[0] = sample;
+        m_history[1] = sample;
+        m_history[2] = sample;
+        return sample;
+    }
+
+    switch (m_type) {
+    case FilterType::Ema:
+        return smooth(x, m_alpha);
+
+    case FilterType::OneEuro: {
+        // Track how fast the input moves, then open the filter accordingly
+        m_slope += ((int32_t)SLOPE_ALPHA * ((x - m_state) - m_slope)) / 256;
+        uint32_t speed = (uint32_t)(m_slope < 0 ? -m_slope : m_slope);
+        uint32_t alpha = m_alpha + ((m_beta * speed) >> 8);
+        return smooth(x, alpha > 256 ? 256 : (uint16_t)alpha);
+    }
+
+    case FilterType::Median3:
+        return median3(sample);
+
+    default:
+        return sample;
+    }
+}
+
+uint16_t AnalogFilter::smooth(int32_t x, uint16_t alpha)
+{
+    m_state += ((int32_t)alpha * (x - m_state)) / 256;
+    return (uint16_t)((m_state + 128) >> 8);
+}
+
+uint16_t AnalogFilter::median3(uint16_t sample)
+{
+    m_history[0] = m_history[1];
+    m_history[1] = m_history[2];
+    m_history[2] = sample;
+
+    uint16_t a = m_history[0];
+    uint16_t b = m_history[1];
+    uint16_t c = m_history[2];
+
+    if (a > b) {
+        uint16_t t = a;
+        a = b;
+        b = t;
+    }
+    // With a <= b, the median is c clamped to [a, b]
+    if (c < a) {
+        return a;
+    }
+    if (c > b) {
+        return b;
+    }
+    return c;
+}
+
+} // namespace Sensor
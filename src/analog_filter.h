@@ -0,0 +1,79 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace Sensor {
+
+// Analog filter algorithms (matches protocol ANALOG_FILTER_* constants)
+enum class FilterType : uint8_t {
+    None = 0,
+    Ema = 1, // Exponential moving average
+    OneEuro = 2, // Adaptive EMA - smooth when still, responsive when moving
+    Median3 = 3 // Median of the last 3 samples (spike rejection)
+};
+
+/**
+ * Fixed-point smoothing filter for analog samples (no floating point).
+ *
+ * Smoothing factors are in 1/256 units: alpha 256 passes samples through,
+ * alpha 16 moves 1/16 of the way to each new sample. The filter state keeps
+ * 8 fractional bits, so samples must stay below 2^14.
+ *
+ * One-Euro is implemented in the alpha domain for the fixed scan rate:
+ * alpha = min_alpha + beta * |filtered slope in counts per scan|.
+ */
+class AnalogFilter {
+public:
+    // Default EMA alpha (1/4) when the configured value is 0
+    static constexpr uint8_t DEFAULT_EMA_ALPHA = 64;
+
+    // Default One-Euro parameters when the configured values are 0
+    static constexpr uint8_t DEFAULT_MIN_ALPHA = 16;
+    static constexpr uint8_t DEFAULT_BETA = 32;
+
+    // Smoothing of the One-Euro slope estimate (1/4)
+    static constexpr uint8_t SLOPE_ALPHA = 64;
+
+    /**
+     * Constructor
+     * @param type Filter algorithm
+     * @param param1 EMA: alpha, One-Euro: min_alpha (1/256 units, 0 = default)
+     * @param param2 One-Euro: beta (alpha increase per count/scan of slope, 0 = default)
+     */
+    explicit AnalogFilter(FilterType type = FilterType::None, uint8_t param1 = 0, uint8_t param2 = 0);
+
+    /**
+     * Forget all history (the next sample primes the filter)
+     */
+    void reset();
+
+    /**
+     * Add a sample and get the filtered value
+     * @param sample Raw sample
+     * @return Filtered value (rounded)
+     */
+    uint16_t update(uint16_t sample);
+
+    /**
+     * Get the filter algorithm
+     * @return Filter type
+     */
+    FilterType getType() const { return m_type; }
+
+private:
+    // Move the state towards x by alpha/256 and return the rounded value
+    uint16_t smooth(int32_t x, uint16_t alpha);
+
+    // Median of the last three samples
+    uint16_t median3(uint16_t sample);
+
+    FilterType m_type;
+    uint16_t m_alpha; // EMA alpha or One-Euro min alpha
+    uint16_t m_beta; // One-Euro slope gain
+    bool m_primed;
+    int32_t m_state; // Filtered value with 8 fractional bits
+    int32_t m_slope; // One-Euro filtered slope with 8 fractional bits
+    uint16_t m_history[3]; // Median3 samples, oldest first
+};
+
+} // namespace Sensor
@@ -1,14 +1,41 @@
 #include "analog_sensor.h"
+#include "adc_sequencer.h"
+#include "input_events.h"
 
 namespace Sensor {
 
-AnalogSensor::AnalogSensor(uint8_t pin_number, uint8_t sensitivity_level)
+AnalogSensor::AnalogSensor(uint8_t pin_number, uint8_t sensitivity_level,
+    FilterType filter_type, uint8_t filter_param1, uint8_t filter_param2,
+    uint8_t oversample_bits_count, uint8_t deadband, uint8_t hysteresis_counts,
+    uint8_t jump, uint8_t keepalive)
     : pin(pin_number)
     , sensitivity(sensitivity_level)
+    , filter(filter_type, filter_param1, filter_param2)
+    , oversample_bits(oversample_bits_count > MAX_OVERSAMPLE_BITS ? MAX_OVERSAMPLE_BITS : oversample_bits_count)
+    , deadband_setting(deadband)
+    , dead_zone(computeDeadZone())
+    , hysteresis((uint16_t)hysteresis_counts << oversample_bits)
     , current_value(0)
+    , oversample_sum(0)
+    , oversample_count(0)
+    , capturing(false)
+    , capture_min(0)
+    , capture_max(0)
     , last_sent(0)
-    , scans_since_send(0)
-    , min_send_interval(computeMinSendInterval())
+    , last_direction(0)
+    , min_interval_ms(computeMinSendInterval())
+    , jump_threshold(computeJumpThreshold(jump))
+    , keepalive_ms(keepalive == 0 ? DEFAULT_KEEPALIVE_MS : (uint16_t)(keepalive * KEEPALIVE_STEP_MS))
+    , last_scan_ms(0)
+    , last_send_ms(0)
+    , last_update_ms(0)
+    , previous_value(0)
+    , has_previous(false)
+    , speed(0)
+    , noise_first(0)
+    , noise_min(0)
+    , noise_max(0)
+    , noise_samples(0)
 {
 }
 
@@ -19,63 +46,276 @@ void AnalogSensor::begin()
     // incorrectly configure the wrong digital pin (e.g., RX/TX on Nano).
 
     // Reset state
+    filter.reset();
     current_value = 0;
+    oversample_sum = 0;
+    oversample_count = 0;
     last_sent = 0;
-    scans_since_send = 0;
+    last_direction = 0;
+    dead_zone = computeDeadZone();
+    noise_samples = 0;
+    last_scan_ms = millis();
+    last_send_ms = last_scan_ms;
+    last_update_ms = last_scan_ms;
+    previous_value = 0;
+    has_previous = false;
+    speed = 0;
 }
 
 void AnalogSensor::scan()
+{
+    last_scan_ms = millis();
+
+    bool updated = true;
+    if (oversample_bits == 0) {
+        current_value = filter.update(readSample());
+    } else if (oversample()) {
+        // Decimate: average of >= 4^n samples, scaled up by n bits
+        uint16_t value = (uint16_t)((oversample_sum << oversample_bits) / oversample_count);
+        current_value = filter.update(value);
+        oversample_sum = 0;
+        oversample_count = 0;
+    } else {
+        updated = false;
+    }
+
+    if (updated) {
+        trackSpeed(current_value, last_scan_ms);
+    }
+    if (deadband_setting == DEADBAND_AUTO && updated) {
+        trackNoise(current_value);
+    }
+
+    // Track the swept range while capturing a calibration
+    if (capturing && updated) {
+        if (current_value < capture_min) {
+            capture_min = current_value;
+        }
+        if (current_value > capture_max) {
+            capture_max = current_value;
+        }
+    }
+
+    report();
+}
+
+uint16_t AnalogSensor::readSample()
 {
     // Read raw analog value (0-1023)
-    current_value = (uint16_t)analogRead(pin);
+#ifdef ADC_SEQUENCER
+    // Latest background conversion; analogRead() if the pin isn't sequenced
+    uint16_t raw;
+    if (AdcSequencer::read(pin, raw)) {
+        return raw;
+    }
+#endif
+    return (uint16_t)analogRead(pin);
+}
 
-    // Increment scan counter
-    scans_since_send++;
+bool AnalogSensor::oversample()
+{
+    uint16_t needed = (uint16_t)1 << (2 * oversample_bits);
+
+#ifdef ADC_SEQUENCER
+    // Every background conversion since the last scan counts - no extra ADC time
+    uint16_t sum;
+    uint8_t count;
+    if (AdcSequencer::readAccumulated(pin, sum, count)) {
+        oversample_sum += sum;
+        oversample_count += count;
+        return oversample_count >= needed;
+    }
+#endif
+
+    // A few blocking reads per scan, so a block is spread over several scans
+    for (uint8_t i = 0; i < OVERSAMPLE_READS_PER_SCAN && oversample_count < needed; i++) {
+        oversample_sum += (uint16_t)analogRead(pin);
+        oversample_count++;
+    }
+    return oversample_count >= needed;
 }
 
-Reading AnalogSensor::getReading()
+void AnalogSensor::report()
 {
     // Check if we should send
     if (!shouldSend()) {
-        return Reading(); // Not ready to send yet
+        return; // Not ready to send yet
     }
 
-    // Send the current raw value
-    int16_t value = (int16_t)current_value;
+    // Send the calibrated value (raw while capturing, so the host can follow the sweep)
+    int16_t value = capturing ? (int16_t)current_value : calibration.apply(current_value);
+
+    // A forced send without a change beyond the dead zone is only a keepalive
+    uint16_t delta = (current_value > last_sent) ? (current_value - last_sent) : (last_sent - current_value);
+    bool keepalive = delta <= dead_zone;
+
+    // Ring full: state unchanged, so the next scan tries again
+    if (!InputEvents::push(Reading(value, InputType::Analog, pin, micros(), keepalive))) {
+        return;
+    }
 
     // Update state
+    if (!keepalive) {
+        last_direction = (current_value > last_sent) ? 1 : -1;
+    }
     last_sent = current_value;
-    scans_since_send = 0;
+    last_send_ms = last_scan_ms;
+}
+
+void AnalogSensor::startCapture()
+{
+    capturing = true;
+    capture_min = 0xFFFF;
+    capture_max = 0;
+}
+
+bool AnalogSensor::stopCapture(uint8_t flags)
+{
+    if (!capturing) {
+        return false;
+    }
+    capturing = false;
+
+    Calibration cal;
+    cal.flags = CALIBRATION_FLAG_VALID | (flags & (CALIBRATION_FLAG_CENTER | CALIBRATION_FLAG_INVERT));
+    cal.min = capture_min;
+    cal.max = capture_max;
+    cal.center = current_value; // Axis is expected to be at rest when capture stops
+
+    if (!cal.isValid()) {
+        return false; // Not swept, or rest position at an end
+    }
+    calibration = cal;
+    return true;
+}
 
-    return Reading(value, InputType::Analog, pin);
+void AnalogSensor::trackSpeed(uint16_t value, unsigned long now)
+{
+    if (!has_previous) {
+        // The first value isn't a movement from 0
+        previous_value = value;
+        last_update_ms = now;
+        has_previous = true;
+        return;
+    }
+
+    unsigned long elapsed = now - last_update_ms;
+    if (elapsed == 0) {
+        elapsed = 1;
+    }
+    uint16_t delta = (value > previous_value) ? (value - previous_value) : (previous_value - value);
+    uint32_t instant = (uint32_t)delta * 1000UL / elapsed;
+    if (instant > 0xFFFF) {
+        instant = 0xFFFF;
+    }
+
+    // EMA with alpha 1/4: follows a throw within a few samples, ignores a single step
+    speed = (uint16_t)((int32_t)speed + ((int32_t)instant - (int32_t)speed) / 4);
+
+    previous_value = value;
+    last_update_ms = now;
+}
+
+void AnalogSensor::trackNoise(uint16_t value)
+{
+    if (noise_samples == 0) {
+        noise_first = value;
+        noise_min = value;
+        noise_max = value;
+    } else if (value < noise_min) {
+        noise_min = value;
+    } else if (value > noise_max) {
+        noise_max = value;
+    }
+    if (++noise_samples < NOISE_WINDOW) {
+        return;
+    }
+    noise_samples = 0;
+
+    // Only windows where the input stood still measure noise: a wide spread, or
+    // a drift from the first to the last value, means it was moving
+    uint16_t spread = noise_max - noise_min;
+    uint16_t drift = (value > noise_first) ? (value - noise_first) : (noise_first - value);
+    if (spread > (NOISE_MAX_SPREAD << oversample_bits) || drift > spread / 2) {
+        return;
+    }
+
+    // Values at rest stay within the spread of the last sent one, so a dead zone
+    // of the spread keeps a still input silent. Rise at once so noise never gets
+    // through; fall slowly so one quiet window doesn't undo it
+    if (spread == 0) {
+        spread = 1;
+    }
+    if (spread >= dead_zone) {
+        dead_zone = spread;
+    } else {
+        dead_zone -= (uint16_t)((dead_zone - spread + 3) / 4);
+    }
+}
+
+uint16_t AnalogSensor::computeDeadZone() const
+{
+    // An auto deadband starts at the default until the first still window
+    if (deadband_setting == 0 || deadband_setting == DEADBAND_AUTO) {
+        return (uint16_t)(filter.getType() == FilterType::None ? DEAD_ZONE : FILTERED_DEAD_ZONE) << oversample_bits;
+    }
+    return (uint16_t)deadband_setting << oversample_bits;
 }
 
 uint16_t AnalogSensor::computeMinSendInterval() const
 {
     // Sensitivity 0-10 maps to send interval
     // Higher sensitivity = lower interval = send more frequently
-    // sensitivity 10: 1 scan (~10ms minimum)
-    // sensitivity 5:  6 scans (~60ms minimum)
-    // sensitivity 0:  11 scans (~110ms minimum)
-    return (uint16_t)(11 - sensitivity);
+    // sensitivity 10: 10ms minimum
+    // sensitivity 5:  60ms minimum
+    // sensitivity 0:  110ms minimum
+    uint8_t level = sensitivity > 10 ? 10 : sensitivity;
+    return (uint16_t)((11 - level) * SEND_INTERVAL_STEP_MS);
 }
 
-bool AnalogSensor::shouldSend()
+uint16_t AnalogSensor::computeJumpThreshold(uint8_t jump) const
 {
-    // Simple algorithm:
-    // 1. Force send every MAX_SEND_INTERVAL scans (~2 seconds) to ensure we don't go silent
-    if (scans_since_send >= MAX_SEND_INTERVAL) {
+    if (jump == JUMP_OFF) {
+        return 0xFFFF;
+    }
+    return (uint16_t)(jump == 0 ? DEFAULT_JUMP_THRESHOLD : jump) << oversample_bits;
+}
+
+uint16_t AnalogSensor::currentMinInterval() const
+{
+    // Faster movement = shorter interval: half at SPEED_REFERENCE, a third at twice that...
+    uint32_t reference = (uint32_t)SPEED_REFERENCE << oversample_bits;
+    return (uint16_t)((uint32_t)min_interval_ms * reference / (reference + speed));
+}
+
+bool AnalogSensor::shouldSend() const
+{
+    unsigned long elapsed = last_scan_ms - last_send_ms;
+    uint16_t delta = (current_value > last_sent) ? (current_value - last_sent) : (last_sent - current_value);
+
+    // 1. Force send every keepalive_ms (~2 seconds) to ensure we don't go silent
+    if (elapsed >= keepalive_ms) {
+        return true;
+    }
+
+    // 2. A large jump goes out at once
+    if (delta > jump_threshold && delta > dead_zone) {
         return true;
     }
 
-    // 2. Rate limit: don't send faster than min_send_interval
-    if (scans_since_send < min_send_interval) {
+    // 3. Rate limit: don't send faster than the minimum interval for the current speed
+    if (elapsed < currentMinInterval()) {
         return false;
     }
 
-    // 3. Send if value changed beyond dead zone (filters analog noise/jitter)
-    uint16_t delta = (current_value > last_sent) ? (current_value - last_sent) : (last_sent - current_value);
-    return delta > DEAD_ZONE;
+    // 4. Send if value changed beyond dead zone (filters analog noise/jitter);
+    //    turning back needs the hysteresis as well, so a lever settling doesn't chatter
+    int8_t direction = (current_value > last_sent) ? 1 : -1;
+    uint16_t threshold = dead_zone;
+    if (last_direction != 0 && direction != last_direction) {
+        threshold += hysteresis;
+    }
+    return delta > threshold;
 }
 
 } // namespace Sensor
@@ -1,44 +1,148 @@
 #pragma once
 
+#include "analog_filter.h"
+#include "calibration.h"
 #include "sensor.h"
 #include <Arduino.h>
 
 namespace Sensor {
 
 // Analog sensor implementation
-// Uses EMA (Exponential Moving Average) for smoothing
-// Reports based on sensitivity, change threshold, and time-based forcing
+// Smooths samples with a configurable fixed-point filter (EMA, One-Euro, median-of-3)
+// Reports based on a minimum interval (from sensitivity, shortened while the value
+// moves fast), change threshold (deadband), large jumps (sent at once) and a keepalive
+// All timing is in milliseconds, so it doesn't depend on the scan rate
+// The deadband is fixed, or follows the noise floor measured while the input is at rest
+// Reversing direction needs an extra hysteresis on top of the deadband
+// With a calibration the reported value is normalized to the full int16 range
+// (the change threshold still works on the raw value)
 class AnalogSensor : public ISensor {
 private:
     uint8_t pin; // Arduino pin number
     uint8_t sensitivity; // Sensitivity level (0-10, where 10 = most sensitive/sends most frequently)
 
+    AnalogFilter filter; // Smoothing applied to every sample
+    uint8_t oversample_bits; // Extra resolution bits from oversampling (0-3)
+    uint8_t deadband_setting; // Configured deadband in counts (0 = default, DEADBAND_AUTO = measured)
+    uint16_t dead_zone; // Change threshold (smaller when filtered, scaled by oversampling)
+    uint16_t hysteresis; // Extra change needed to reverse direction (scaled by oversampling)
+
     // State
-    uint16_t current_value; // Current raw analog value (0-1023)
+    uint16_t current_value; // Current filtered analog value (0-1023, << oversample_bits)
+    uint32_t oversample_sum; // Sum of the samples in the current oversampling block
+    uint16_t oversample_count; // Number of samples in the current oversampling block
+
+    // Calibration
+    Calibration calibration; // Applied to reported values when valid
+    bool capturing; // Tracking extremes while the user sweeps the axis
+    uint16_t capture_min; // Lowest value seen during capture
+    uint16_t capture_max; // Highest value seen during capture
     uint16_t last_sent; // Last sent value
-    uint16_t scans_since_send; // Number of scans since last send
-    uint16_t min_send_interval; // Minimum scans between sends (computed from sensitivity)
+    int8_t last_direction; // Direction of the last change sent (1 up, -1 down, 0 none)
+
+    // Reporting policy
+    uint16_t min_interval_ms; // Minimum time between sends at rest (computed from sensitivity)
+    uint16_t jump_threshold; // Change sent at once, whatever the interval (scaled by oversampling)
+    uint16_t keepalive_ms; // Resend after this long even without a change
+    unsigned long last_scan_ms; // millis() of the latest scan
+    unsigned long last_send_ms; // millis() scan time of the last send
+    unsigned long last_update_ms; // millis() of the last new value (for the speed)
+    uint16_t previous_value; // Value before the latest update (for the speed)
+    bool has_previous; // False until the first value (the speed starts from it)
+    uint16_t speed; // Smoothed speed of the value in counts per second
+
+    // Noise floor estimation (auto deadband)
+    uint16_t noise_first; // First value of the current window
+    uint16_t noise_min; // Lowest value in the current window
+    uint16_t noise_max; // Highest value in the current window
+    uint8_t noise_samples; // Values in the current window
 
     // Algorithm constants
-    static constexpr uint16_t MAX_SEND_INTERVAL = 200; // Maximum 200 scans (~2s) - force send even if no change
+    static constexpr uint16_t DEFAULT_KEEPALIVE_MS = 2000; // Force send even if no change
+    static constexpr uint16_t DEFAULT_JUMP_THRESHOLD = 64; // Changes this large skip the interval
+    static constexpr uint16_t SEND_INTERVAL_STEP_MS = 10; // Minimum interval per sensitivity step below 10
+    static constexpr uint16_t SPEED_REFERENCE = 500; // Counts/s at which the minimum interval halves
     static constexpr uint16_t DEAD_ZONE = 2; // Ignore changes smaller than this (filters analog noise/jitter)
+    static constexpr uint16_t FILTERED_DEAD_ZONE = 1; // Dead zone when a filter already removes the jitter
+    static constexpr uint8_t OVERSAMPLE_READS_PER_SCAN = 4; // analogRead() calls per scan when oversampling
+    static constexpr uint8_t NOISE_WINDOW = 32; // Values per noise floor window (~320 ms)
+    static constexpr uint16_t NOISE_MAX_SPREAD = 16; // Wider windows are movement, not noise (10-bit counts)
 
 public:
-    AnalogSensor(uint8_t pin_number, uint8_t sensitivity_level);
+    // Maximum oversampling: 4^3 = 64 samples for 13 effective bits
+    static constexpr uint8_t MAX_OVERSAMPLE_BITS = 3;
+
+    // Deadband setting that measures the noise floor (matches Protocol::ANALOG_DEADBAND_AUTO)
+    static constexpr uint8_t DEADBAND_AUTO = 0xFF;
+
+    // Jump setting that never skips the interval (matches Protocol::ANALOG_JUMP_OFF)
+    static constexpr uint8_t JUMP_OFF = 0xFF;
+
+    // Keepalive setting unit (Protocol analog keepalive field)
+    static constexpr uint16_t KEEPALIVE_STEP_MS = 100;
+
+    AnalogSensor(uint8_t pin_number, uint8_t sensitivity_level,
+        FilterType filter_type = FilterType::None, uint8_t filter_param1 = 0, uint8_t filter_param2 = 0,
+        uint8_t oversample_bits_count = 0, uint8_t deadband = 0, uint8_t hysteresis_counts = 0,
+        uint8_t jump = 0, uint8_t keepalive = 0);
 
     // ISensor interface implementation
     void begin() override;
     void scan() override;
-    Reading getReading() override;
     InputType getType() const override { return InputType::Analog; }
     uint8_t getPin() const override { return pin; }
 
+    // Set the calibration applied to reported values
+    void setCalibration(const Calibration& cal) { calibration = cal; }
+    const Calibration& getCalibration() const { return calibration; }
+
+    // Start tracking min/max (reports raw values until stopCapture())
+    void startCapture();
+
+    // Stop tracking and calibrate to the captured range
+    // CALIBRATION_FLAG_CENTER in flags uses the current value as center,
+    // CALIBRATION_FLAG_INVERT reverses the axis
+    // Returns false (calibration unchanged) if no usable range was captured
+    bool stopCapture(uint8_t flags);
+
+    bool isCapturing() const { return capturing; }
+
+    // Get the current change threshold (in reported raw units)
+    uint16_t getDeadZone() const { return dead_zone; }
+
+    // Get the smoothed speed of the value (reported raw units per second)
+    uint16_t getSpeed() const { return speed; }
+
 private:
-    // Check if we should send a value (simple rate limiting + periodic updates)
-    bool shouldSend();
+    // Read one raw sample (0-1023)
+    uint16_t readSample();
+
+    // Add samples to the oversampling block; returns true when the block is complete
+    bool oversample();
+
+    // Track the spread of values at rest and follow it with the dead zone (auto deadband)
+    void trackNoise(uint16_t value);
+
+    // Update the smoothed speed with a new value
+    void trackSpeed(uint16_t value, unsigned long now);
+
+    // Check if we should send a value (jump, keepalive, speed-adapted rate limit)
+    bool shouldSend() const;
+
+    // Push the current value to InputEvents if it should be sent
+    void report();
+
+    // Minimum interval for the current speed
+    uint16_t currentMinInterval() const;
+
+    // Compute the starting dead zone from the deadband setting
+    uint16_t computeDeadZone() const;
 
     // Compute minimum send interval from sensitivity
     uint16_t computeMinSendInterval() const;
+
+    // Compute the jump threshold from its setting
+    uint16_t computeJumpThreshold(uint8_t jump) const;
 };
 
 } // namespace Sensor
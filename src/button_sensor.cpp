@@ -1,18 +1,24 @@
 #include "button_sensor.h"
+#include "edge_capture.h"
+#include "input_events.h"
 
 namespace Sensor {
 
-ButtonSensor::ButtonSensor(uint8_t pin_number, uint8_t debounce_scans)
+ButtonSensor::ButtonSensor(uint8_t pin_number, uint8_t debounce_ms,
+    uint8_t press_lockout, uint8_t release_lockout)
     : pin(pin_number)
-    , debounce_threshold(debounce_scans)
-    , current_state(false)
+    , timing(DebounceTiming::fromMs(debounce_ms, press_lockout, release_lockout))
     , last_reported(false)
-    , raw_state(false)
-    , debounce_count(0)
-    , has_pending_event(false)
+    , edge_slot(EdgeCapture::NO_SLOT)
+    , last_edge_us(0)
 {
 }
 
+ButtonSensor::~ButtonSensor()
+{
+    EdgeCapture::detach(edge_slot);
+}
+
 void ButtonSensor::begin()
 {
     // Configure pin as input with pullup
@@ -20,57 +26,49 @@ void ButtonSensor::begin()
     pinMode(pin, INPUT_PULLUP);
 
     // Reset state
-    current_state = false;
+    debouncer.reset();
     last_reported = false;
-    raw_state = false;
-    debounce_count = 0;
-    has_pending_event = false;
+
+    // Capture edges by interrupt when the pin supports it
+    EdgeCapture::detach(edge_slot);
+    edge_slot = EdgeCapture::attach(pin);
+    last_edge_us = 0;
 }
 
 void ButtonSensor::scan()
 {
-    // Read raw state (LOW = pressed due to INPUT_PULLUP)
-    bool new_raw = (digitalRead(pin) == LOW);
-
-    // Counter-based debounce algorithm:
-    // Only change state after seeing consistent readings for debounce_threshold scans
-    if (new_raw == current_state) {
-        // Reading matches current state, reset counter
-        debounce_count = 0;
-    } else {
-        // Reading differs from current state
-        debounce_count++;
+    // An edge since the last scan means the contact moved (or is still bouncing):
+    // the state must be stable for the full debounce time after the last one.
+    // Bounces can span several scans: the change is stamped with the first edge
+    unsigned long first_us, last_us;
+    if (EdgeCapture::takeEdge(edge_slot, first_us, last_us)) {
+        if (last_edge_us == 0) {
+            last_edge_us = first_us;
+        }
+        debouncer.restart(debounceTicks(last_us));
+    }
 
-        if (debounce_count >= debounce_threshold) {
-            // Stable new state detected
-            current_state = new_raw;
-            debounce_count = 0;
+    // Read raw state (LOW = pressed due to INPUT_PULLUP)
+    uint8_t raw = (digitalRead(pin) == LOW) ? 0x01 : 0x00;
+    unsigned long now_us = micros();
+    debouncer.update(raw, debounceTicks(now_us), timing);
 
-            // Check if this is a new edge event
-            if (current_state != last_reported) {
-                has_pending_event = true;
-            }
+    // Report the edge event (value = 1 for press, 0 for release), stamped with
+    // the captured edge when there is one; if the ring is full the next scan
+    // tries again
+    bool pressed = isPressed();
+    if (pressed != last_reported) {
+        uint32_t time_us = last_edge_us != 0 ? last_edge_us : now_us;
+        if (InputEvents::push(Reading(pressed ? 1 : 0, InputType::Button, pin, time_us))) {
+            last_reported = pressed;
+            last_edge_us = 0; // A change the poll sees first isn't stamped with this edge
         }
     }
-
-    raw_state = new_raw;
 }
 
-Reading ButtonSensor::getReading()
+bool ButtonSensor::usesInterrupt() const
 {
-    if (!has_pending_event) {
-        return Reading(); // No event to report
-    }
-
-    // Report the edge event
-    // value = 1 for press, 0 for release
-    int16_t value = current_state ? 1 : 0;
-
-    // Update state
-    last_reported = current_state;
-    has_pending_event = false;
-
-    return Reading(value, InputType::Button, pin);
+    return edge_slot != EdgeCapture::NO_SLOT;
 }
 
 } // namespace Sensor
@@ -1,33 +1,55 @@
 #pragma once
 
+#include "debounce.h"
 #include "sensor.h"
 #include <Arduino.h>
 
 namespace Sensor {
 
 // Button sensor implementation
-// Uses counter-based debouncing and reports edge events (press/release)
+// Uses time-based debouncing (see debounce.h) and reports edge events (press/release)
+// Eager mode (per edge direction): the first reading of a new state is reported
+// at once, then the pin is ignored for a lockout window while it bounces
+// When the pin supports an interrupt, edges are captured the moment they happen
+// (see edge_capture.h) and the debounce time restarts at every edge; pins
+// without an interrupt fall back to plain polling.
 class ButtonSensor : public ISensor {
+public:
+    // Lockout setting that keeps integrated debouncing for that edge direction
+    static constexpr uint8_t LOCKOUT_OFF = 0;
+
 private:
     uint8_t pin;               // Arduino pin number
-    uint8_t debounce_threshold; // Number of scans for debounce
+    DebounceTiming timing;     // Debounce time and lockouts
 
     // State
-    bool current_state;        // Current debounced state (true = pressed)
+    Debouncer debouncer;       // Debounced state (bit 0 = pressed)
     bool last_reported;        // Last reported state
-    bool raw_state;            // Raw reading from pin
-    uint8_t debounce_count;    // Counter for debounce
-    bool has_pending_event;    // True if there's an event to report
+
+    // Interrupt fast path
+    uint8_t edge_slot;         // EdgeCapture slot (EdgeCapture::NO_SLOT = polling only)
+    unsigned long last_edge_us; // micros() timestamp of the first edge of the unreported change (0 = none)
 
 public:
-    ButtonSensor(uint8_t pin_number, uint8_t debounce_scans);
+    ButtonSensor(uint8_t pin_number, uint8_t debounce_ms,
+        uint8_t press_lockout = LOCKOUT_OFF, uint8_t release_lockout = LOCKOUT_OFF);
+    ~ButtonSensor() override;
 
     // ISensor interface implementation
     void begin() override;
     void scan() override;
-    Reading getReading() override;
     InputType getType() const override { return InputType::Button; }
     uint8_t getPin() const override { return pin; }
+
+    // Check if edges are captured by interrupt (false = polling fallback)
+    bool usesInterrupt() const;
+
+    // micros() timestamp of the first edge not yet reported (interrupt mode only)
+    unsigned long getLastEdgeMicros() const { return last_edge_us; }
+
+private:
+    // Debounced state (true = pressed)
+    bool isPressed() const { return debouncer.getState() & 0x01; }
 };
 
 } // namespace Sensor
@@ -0,0 +1,56 @@
+#include "calibration.h"
+
+namespace Sensor {
+
+// Scale offset/span onto 0..CALIBRATED_MAX (span > 0, offset clamped to 0..span)
+static int16_t scale(int32_t offset, int32_t span)
+{
+    if (offset <= 0) {
+        return 0;
+    }
+    if (offset >= span) {
+        return CALIBRATED_MAX;
+    }
+    return (int16_t)((offset * CALIBRATED_MAX + span / 2) / span);
+}
+
+bool Calibration::isValid() const
+{
+    if (!(flags & CALIBRATION_FLAG_VALID) || max <= min) {
+        return false;
+    }
+    if ((flags & CALIBRATION_FLAG_CENTER) && (center <= min || center >= max)) {
+        return false;
+    }
+    return true;
+}
+
+int16_t Calibration::apply(uint16_t raw) const
+{
+    if (!isValid()) {
+        return (int16_t)raw;
+    }
+
+    int32_t value = raw;
+    int16_t out;
+
+    if (flags & CALIBRATION_FLAG_CENTER) {
+        if (value < center) {
+            out = (int16_t)-scale((int32_t)center - value, (int32_t)center - min);
+        } else {
+            out = scale(value - center, (int32_t)max - center);
+        }
+        if (flags & CALIBRATION_FLAG_INVERT) {
+            out = (int16_t)-out;
+        }
+    } else {
+        out = scale(value - min, (int32_t)max - min);
+        if (flags & CALIBRATION_FLAG_INVERT) {
+            out = (int16_t)(CALIBRATED_MAX - out);
+        }
+    }
+
+    return out;
+}
+
+} // namespace Sensor
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace Sensor {
+
+// Calibration flags (matches protocol CALIBRATION_FLAG_* constants)
+constexpr uint8_t CALIBRATION_FLAG_VALID = 0x01; // Record holds a calibration
+constexpr uint8_t CALIBRATION_FLAG_CENTER = 0x02; // Bipolar axis around center
+constexpr uint8_t CALIBRATION_FLAG_INVERT = 0x04; // Reverse the direction
+
+// Full-scale output of a calibrated axis
+constexpr int16_t CALIBRATED_MAX = 32767;
+
+/**
+ * Axis calibration - maps a raw analog value onto the full int16 range.
+ *
+ * Without a center the axis is unipolar: min..max -> 0..32767.
+ * With a center it is bipolar: min..center..max -> -32767..0..32767
+ * (each half scaled on its own, so an off-center rest position still reads 0).
+ * Values outside the calibrated range are clamped. Integer math only.
+ */
+struct Calibration {
+    uint8_t flags;
+    uint16_t min;
+    uint16_t max;
+    uint16_t center;
+
+    Calibration()
+        : flags(0)
+        , min(0)
+        , max(0)
+        , center(0)
+    {
+    }
+
+    // Check if the record holds a usable calibration
+    bool isValid() const;
+
+    // Map a raw value (returned unchanged when not valid)
+    int16_t apply(uint16_t raw) const;
+};
+
+} // namespace Sensor
@@ -104,6 +104,11 @@ bool handleConfigure(const Protocol::Configure& cfg, bool& complete, bool& error
 
     // Check if configuration is complete
     if (g_config_state.isComplete()) {
+        // Calibrations belong to the inputs of the previous configuration
+        if (g_config_state.getConfigId() != g_current_config_id) {
+            clearCalibrations();
+        }
+
         // Store to EEPROM
         storeToEEPROM(
             g_config_state.getConfigId(),
@@ -165,6 +170,22 @@ void storeToEEPROM(uint32_t config_id, const InputConfig* inputs, uint8_t num_in
             addr += sizeof(uint8_t);
             eeprom_put(addr, inputs[i].analog.sensitivity);
             addr += sizeof(uint8_t);
+            eeprom_put(addr, inputs[i].analog.filter_type);
+            addr += sizeof(uint8_t);
+            eeprom_put(addr, inputs[i].analog.filter_param1);
+            addr += sizeof(uint8_t);
+            eeprom_put(addr, inputs[i].analog.filter_param2);
+            addr += sizeof(uint8_t);
+            eeprom_put(addr, inputs[i].analog.oversample_bits);
+            addr += sizeof(uint8_t);
+            eeprom_put(addr, inputs[i].analog.deadband);
+            addr += sizeof(uint8_t);
+            eeprom_put(addr, inputs[i].analog.hysteresis);
+            addr += sizeof(uint8_t);
+            eeprom_put(addr, inputs[i].analog.jump);
+            addr += sizeof(uint8_t);
+            eeprom_put(addr, inputs[i].analog.keepalive);
+            addr += sizeof(uint8_t);
             break;
 
         case Protocol::INPUT_TYPE_BUTTON:
@@ -172,6 +193,10 @@ void storeToEEPROM(uint32_t config_id, const InputConfig* inputs, uint8_t num_in
             addr += sizeof(uint8_t);
             eeprom_put(addr, inputs[i].button.debounce);
             addr += sizeof(uint8_t);
+            eeprom_put(addr, inputs[i].button.press_lockout);
+            addr += sizeof(uint8_t);
+            eeprom_put(addr, inputs[i].button.release_lockout);
+            addr += sizeof(uint8_t);
             break;
 
         case Protocol::INPUT_TYPE_MATRIX: {
@@ -184,8 +209,46 @@ void storeToEEPROM(uint32_t config_id, const InputConfig* inputs, uint8_t num_in
                 eeprom_put(addr, inputs[i].matrix.pins[p]);
                 addr += sizeof(uint8_t);
             }
+            eeprom_put(addr, inputs[i].matrix.settle_us);
+            addr += sizeof(uint8_t);
+            eeprom_put(addr, inputs[i].matrix.rows_per_tick);
+            addr += sizeof(uint8_t);
+            eeprom_put(addr, inputs[i].matrix.diode_direction);
+            addr += sizeof(uint8_t);
+            eeprom_put(addr, inputs[i].matrix.press_lockout);
+            addr += sizeof(uint8_t);
+            eeprom_put(addr, inputs[i].matrix.release_lockout);
+            addr += sizeof(uint8_t);
+            eeprom_put(addr, inputs[i].matrix.debounce);
+            addr += sizeof(uint8_t);
             break;
         }
+
+        case Protocol::INPUT_TYPE_NOTCHED:
+            eeprom_put(addr, inputs[i].notched.pin);
+            addr += sizeof(uint8_t);
+            eeprom_put(addr, inputs[i].notched.hysteresis);
+            addr += sizeof(uint8_t);
+            eeprom_put(addr, inputs[i].notched.button_base);
+            addr += sizeof(uint8_t);
+            eeprom_put(addr, inputs[i].notched.num_boundaries);
+            addr += sizeof(uint8_t);
+            for (uint8_t b = 0; b < inputs[i].notched.num_boundaries; b++) {
+                eeprom_put(addr, inputs[i].notched.boundaries[b]);
+                addr += sizeof(uint16_t);
+            }
+            break;
+
+        case Protocol::INPUT_TYPE_ENCODER:
+            eeprom_put(addr, inputs[i].encoder.pin_a);
+            addr += sizeof(uint8_t);
+            eeprom_put(addr, inputs[i].encoder.pin_b);
+            addr += sizeof(uint8_t);
+            eeprom_put(addr, inputs[i].encoder.steps_per_detent);
+            addr += sizeof(uint8_t);
+            eeprom_put(addr, inputs[i].encoder.acceleration);
+            addr += sizeof(uint8_t);
+            break;
         }
     }
 
@@ -237,6 +300,22 @@ bool loadFromEEPROM()
             addr += sizeof(uint8_t);
             eeprom_get(addr, g_current_inputs[i].analog.sensitivity);
             addr += sizeof(uint8_t);
+            eeprom_get(addr, g_current_inputs[i].analog.filter_type);
+            addr += sizeof(uint8_t);
+            eeprom_get(addr, g_current_inputs[i].analog.filter_param1);
+            addr += sizeof(uint8_t);
+            eeprom_get(addr, g_current_inputs[i].analog.filter_param2);
+            addr += sizeof(uint8_t);
+            eeprom_get(addr, g_current_inputs[i].analog.oversample_bits);
+            addr += sizeof(uint8_t);
+            eeprom_get(addr, g_current_inputs[i].analog.deadband);
+            addr += sizeof(uint8_t);
+            eeprom_get(addr, g_current_inputs[i].analog.hysteresis);
+            addr += sizeof(uint8_t);
+            eeprom_get(addr, g_current_inputs[i].analog.jump);
+            addr += sizeof(uint8_t);
+            eeprom_get(addr, g_current_inputs[i].analog.keepalive);
+            addr += sizeof(uint8_t);
             break;
 
         case Protocol::INPUT_TYPE_BUTTON:
@@ -244,6 +323,10 @@ bool loadFromEEPROM()
             addr += sizeof(uint8_t);
             eeprom_get(addr, g_current_inputs[i].button.debounce);
             addr += sizeof(uint8_t);
+            eeprom_get(addr, g_current_inputs[i].button.press_lockout);
+            addr += sizeof(uint8_t);
+            eeprom_get(addr, g_current_inputs[i].button.release_lockout);
+            addr += sizeof(uint8_t);
             break;
 
         case Protocol::INPUT_TYPE_MATRIX: {
@@ -259,9 +342,52 @@ bool loadFromEEPROM()
                 eeprom_get(addr, g_current_inputs[i].matrix.pins[p]);
                 addr += sizeof(uint8_t);
             }
+            eeprom_get(addr, g_current_inputs[i].matrix.settle_us);
+            addr += sizeof(uint8_t);
+            eeprom_get(addr, g_current_inputs[i].matrix.rows_per_tick);
+            addr += sizeof(uint8_t);
+            eeprom_get(addr, g_current_inputs[i].matrix.diode_direction);
+            addr += sizeof(uint8_t);
+            eeprom_get(addr, g_current_inputs[i].matrix.press_lockout);
+            addr += sizeof(uint8_t);
+            eeprom_get(addr, g_current_inputs[i].matrix.release_lockout);
+            addr += sizeof(uint8_t);
+            eeprom_get(addr, g_current_inputs[i].matrix.debounce);
+            addr += sizeof(uint8_t);
+            break;
+        }
+
+        case Protocol::INPUT_TYPE_NOTCHED: {
+            eeprom_get(addr, g_current_inputs[i].notched.pin);
+            addr += sizeof(uint8_t);
+            eeprom_get(addr, g_current_inputs[i].notched.hysteresis);
+            addr += sizeof(uint8_t);
+            eeprom_get(addr, g_current_inputs[i].notched.button_base);
+            addr += sizeof(uint8_t);
+            eeprom_get(addr, g_current_inputs[i].notched.num_boundaries);
+            addr += sizeof(uint8_t);
+            uint8_t num_boundaries = g_current_inputs[i].notched.num_boundaries;
+            if (num_boundaries == 0 || num_boundaries > MAX_NOTCH_BOUNDARIES) {
+                return false; // Invalid notched config
+            }
+            for (uint8_t b = 0; b < num_boundaries; b++) {
+                eeprom_get(addr, g_current_inputs[i].notched.boundaries[b]);
+                addr += sizeof(uint16_t);
+            }
             break;
         }
 
+        case Protocol::INPUT_TYPE_ENCODER:
+            eeprom_get(addr, g_current_inputs[i].encoder.pin_a);
+            addr += sizeof(uint8_t);
+            eeprom_get(addr, g_current_inputs[i].encoder.pin_b);
+            addr += sizeof(uint8_t);
+            eeprom_get(addr, g_current_inputs[i].encoder.steps_per_detent);
+            addr += sizeof(uint8_t);
+            eeprom_get(addr, g_current_inputs[i].encoder.acceleration);
+            addr += sizeof(uint8_t);
+            break;
+
         default:
             return false; // Unknown input type
         }
@@ -281,4 +407,70 @@ const InputConfig* getCurrentConfig(uint8_t& num_inputs)
     return g_current_inputs;
 }
 
+// Check byte for a calibration record (detects erased or stale EEPROM)
+static uint8_t calibrationCheck(const Sensor::Calibration& cal)
+{
+    return (uint8_t)(0x5A ^ cal.flags ^ (cal.min & 0xFF) ^ (cal.min >> 8) ^ (cal.max & 0xFF) ^ (cal.max >> 8)
+        ^ (cal.center & 0xFF) ^ (cal.center >> 8));
+}
+
+static void writeCalibration(uint8_t input_index, const Sensor::Calibration& cal)
+{
+    int addr = EEPROM_CALIBRATION_ADDR + input_index * EEPROM_CALIBRATION_RECORD_SIZE;
+    eeprom_put(addr, cal.flags);
+    addr += sizeof(uint8_t);
+    eeprom_put(addr, cal.min);
+    addr += sizeof(uint16_t);
+    eeprom_put(addr, cal.max);
+    addr += sizeof(uint16_t);
+    eeprom_put(addr, cal.center);
+    addr += sizeof(uint16_t);
+    eeprom_put(addr, calibrationCheck(cal));
+}
+
+void storeCalibration(uint8_t input_index, const Sensor::Calibration& cal)
+{
+    if (input_index >= MAX_INPUTS) {
+        return;
+    }
+    writeCalibration(input_index, cal);
+    eeprom_commit();
+}
+
+bool loadCalibration(uint8_t input_index, Sensor::Calibration& cal)
+{
+    cal = Sensor::Calibration();
+    if (input_index >= MAX_INPUTS) {
+        return false;
+    }
+
+    Sensor::Calibration stored;
+    uint8_t check;
+    int addr = EEPROM_CALIBRATION_ADDR + input_index * EEPROM_CALIBRATION_RECORD_SIZE;
+    eeprom_get(addr, stored.flags);
+    addr += sizeof(uint8_t);
+    eeprom_get(addr, stored.min);
+    addr += sizeof(uint16_t);
+    eeprom_get(addr, stored.max);
+    addr += sizeof(uint16_t);
+    eeprom_get(addr, stored.center);
+    addr += sizeof(uint16_t);
+    eeprom_get(addr, check);
+
+    if (check != calibrationCheck(stored) || !stored.isValid()) {
+        return false;
+    }
+    cal = stored;
+    return true;
+}
+
+void clearCalibrations()
+{
+    Sensor::Calibration none;
+    for (uint8_t i = 0; i < MAX_INPUTS; i++) {
+        writeCalibration(i, none);
+    }
+    eeprom_commit();
+}
+
 } // namespace ConfigManager
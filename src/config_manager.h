@@ -1,5 +1,6 @@
 #pragma once
 
+#include "calibration.h"
 #include "protocol.h"
 #include <Arduino.h>
 #include <stdint.h>
@@ -31,6 +32,20 @@ constexpr int EEPROM_VERSION_ADDR = 4; // 1 byte - device version that created t
 constexpr int EEPROM_CONFIG_ID_ADDR = 5; // 4 bytes - config_id
 constexpr int EEPROM_NUM_INPUTS_ADDR = 9; // 1 byte - number of inputs
 constexpr int EEPROM_INPUTS_ADDR = 10; // Start of input configurations
+constexpr int EEPROM_INPUTS_MAX_SIZE = 256; // Space reserved for input configurations
+constexpr int EEPROM_CALIBRATION_ADDR = EEPROM_INPUTS_ADDR + EEPROM_INPUTS_MAX_SIZE; // Calibration records (one per input)
+constexpr int EEPROM_CALIBRATION_RECORD_SIZE = 8; // flags, min, max, center, check byte
+
+// Calibration records must fit the smallest EEPROM (512 bytes on ESP32)
+static_assert(EEPROM_CALIBRATION_ADDR + MAX_INPUTS * EEPROM_CALIBRATION_RECORD_SIZE <= 512,
+    "Calibration records don't fit in EEPROM");
+
+// Maximum notch boundaries per notched input
+constexpr uint8_t MAX_NOTCH_BOUNDARIES = Protocol::MAX_NOTCH_BOUNDARIES;
+
+// The largest input record (type + notched payload) must fit for every input
+static_assert(MAX_INPUTS * (1 + 4 + MAX_NOTCH_BOUNDARIES * 2) <= EEPROM_INPUTS_MAX_SIZE,
+    "Input configurations don't fit in EEPROM");
 
 // Magic number to validate EEPROM data
 constexpr uint32_t EEPROM_MAGIC = 0xC0FF1234;
@@ -47,12 +62,22 @@ struct InputConfig {
         struct {
             uint8_t pin;
             uint8_t sensitivity;
+            uint8_t filter_type;
+            uint8_t filter_param1;
+            uint8_t filter_param2;
+            uint8_t oversample_bits;
+            uint8_t deadband;
+            uint8_t hysteresis;
+            uint8_t jump;
+            uint8_t keepalive;
         } analog;
 
         // INPUT_TYPE_BUTTON
         struct {
             uint8_t pin;
             uint8_t debounce;
+            uint8_t press_lockout;
+            uint8_t release_lockout;
         } button;
 
         // INPUT_TYPE_MATRIX
@@ -60,7 +85,30 @@ struct InputConfig {
             uint8_t num_row_pins;
             uint8_t num_col_pins;
             uint8_t pins[MAX_MATRIX_PINS]; // row_pins followed by col_pins
+            uint8_t settle_us;
+            uint8_t rows_per_tick;
+            uint8_t diode_direction;
+            uint8_t press_lockout;
+            uint8_t release_lockout;
+            uint8_t debounce;
         } matrix;
+
+        // INPUT_TYPE_NOTCHED
+        struct {
+            uint8_t pin;
+            uint8_t hysteresis;
+            uint8_t button_base;
+            uint8_t num_boundaries;
+            uint16_t boundaries[MAX_NOTCH_BOUNDARIES];
+        } notched;
+
+        // INPUT_TYPE_ENCODER
+        struct {
+            uint8_t pin_a;
+            uint8_t pin_b;
+            uint8_t steps_per_detent;
+            uint8_t acceleration;
+        } encoder;
     };
 
     InputConfig()
@@ -68,6 +116,14 @@ struct InputConfig {
     {
         analog.pin = 0;
         analog.sensitivity = 0;
+        analog.filter_type = Protocol::ANALOG_FILTER_NONE;
+        analog.filter_param1 = 0;
+        analog.filter_param2 = 0;
+        analog.oversample_bits = 0;
+        analog.deadband = Protocol::ANALOG_DEADBAND_DEFAULT;
+        analog.hysteresis = 0;
+        analog.jump = Protocol::ANALOG_JUMP_DEFAULT;
+        analog.keepalive = 0;
     }
 };
 
@@ -124,11 +180,21 @@ public:
         case Protocol::INPUT_TYPE_ANALOG:
             inputs[cfg.part_number].analog.pin = cfg.analog.pin;
             inputs[cfg.part_number].analog.sensitivity = cfg.analog.sensitivity;
+            inputs[cfg.part_number].analog.filter_type = cfg.analog.filter_type;
+            inputs[cfg.part_number].analog.filter_param1 = cfg.analog.filter_param1;
+            inputs[cfg.part_number].analog.filter_param2 = cfg.analog.filter_param2;
+            inputs[cfg.part_number].analog.oversample_bits = cfg.analog.oversample_bits;
+            inputs[cfg.part_number].analog.deadband = cfg.analog.deadband;
+            inputs[cfg.part_number].analog.hysteresis = cfg.analog.hysteresis;
+            inputs[cfg.part_number].analog.jump = cfg.analog.jump;
+            inputs[cfg.part_number].analog.keepalive = cfg.analog.keepalive;
             break;
 
         case Protocol::INPUT_TYPE_BUTTON:
             inputs[cfg.part_number].button.pin = cfg.button.pin;
             inputs[cfg.part_number].button.debounce = cfg.button.debounce;
+            inputs[cfg.part_number].button.press_lockout = cfg.button.press_lockout;
+            inputs[cfg.part_number].button.release_lockout = cfg.button.release_lockout;
             break;
 
         case Protocol::INPUT_TYPE_MATRIX:
@@ -137,6 +203,48 @@ public:
             for (uint8_t i = 0; i < cfg.matrix.num_row_pins + cfg.matrix.num_col_pins; i++) {
                 inputs[cfg.part_number].matrix.pins[i] = cfg.matrix.pins[i];
             }
+            inputs[cfg.part_number].matrix.settle_us = cfg.matrix.settle_us;
+            inputs[cfg.part_number].matrix.rows_per_tick = cfg.matrix.rows_per_tick;
+            inputs[cfg.part_number].matrix.diode_direction = cfg.matrix.diode_direction;
+            inputs[cfg.part_number].matrix.press_lockout = cfg.matrix.press_lockout;
+            inputs[cfg.part_number].matrix.release_lockout = cfg.matrix.release_lockout;
+            inputs[cfg.part_number].matrix.debounce = cfg.matrix.debounce;
+            break;
+
+        case Protocol::INPUT_TYPE_NOTCHED:
+            // Needs at least two notches, with strictly ascending boundaries
+            if (cfg.notched.num_boundaries == 0 || cfg.notched.num_boundaries > MAX_NOTCH_BOUNDARIES) {
+                return false;
+            }
+            for (uint8_t i = 1; i < cfg.notched.num_boundaries; i++) {
+                if (cfg.notched.boundaries[i] <= cfg.notched.boundaries[i - 1]) {
+                    return false;
+                }
+            }
+            // Notch buttons must not wrap onto physical pins or reach the matrix keys
+            if (cfg.notched.button_base != 0
+                && (cfg.notched.button_base < Protocol::NOTCH_BUTTON_PIN_MIN
+                    || (uint16_t)cfg.notched.button_base + cfg.notched.num_boundaries >= Protocol::NOTCH_BUTTON_PIN_END)) {
+                return false;
+            }
+            inputs[cfg.part_number].notched.pin = cfg.notched.pin;
+            inputs[cfg.part_number].notched.hysteresis = cfg.notched.hysteresis;
+            inputs[cfg.part_number].notched.button_base = cfg.notched.button_base;
+            inputs[cfg.part_number].notched.num_boundaries = cfg.notched.num_boundaries;
+            for (uint8_t i = 0; i < cfg.notched.num_boundaries; i++) {
+                inputs[cfg.part_number].notched.boundaries[i] = cfg.notched.boundaries[i];
+            }
+            break;
+
+        case Protocol::INPUT_TYPE_ENCODER:
+            // A detent is one, two or four quadrature steps
+            if (cfg.encoder.steps_per_detent == 3 || cfg.encoder.steps_per_detent > 4) {
+                return false;
+            }
+            inputs[cfg.part_number].encoder.pin_a = cfg.encoder.pin_a;
+            inputs[cfg.part_number].encoder.pin_b = cfg.encoder.pin_b;
+            inputs[cfg.part_number].encoder.steps_per_detent = cfg.encoder.steps_per_detent;
+            inputs[cfg.part_number].encoder.acceleration = cfg.encoder.acceleration;
             break;
 
         default:
@@ -228,4 +336,14 @@ uint32_t getCurrentConfigId();
 // Get current configuration
 const InputConfig* getCurrentConfig(uint8_t& num_inputs);
 
+// Store the calibration of an input (by input index)
+void storeCalibration(uint8_t input_index, const Sensor::Calibration& cal);
+
+// Load the calibration of an input
+// Returns false if there is no valid record (cal is left uncalibrated)
+bool loadCalibration(uint8_t input_index, Sensor::Calibration& cal);
+
+// Remove all stored calibrations (a new configuration may use different axes)
+void clearCalibrations();
+
 } // namespace ConfigManager
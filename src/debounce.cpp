@@ -0,0 +1,140 @@
+#include "debounce.h"
+
+namespace Sensor {
+
+DebounceTiming DebounceTiming::fromMs(uint8_t debounce_ms, uint8_t press_lockout_ms, uint8_t release_lockout_ms)
+{
+    // 255 ms is 15937 ticks, so the conversion can't overflow
+    DebounceTiming timing;
+    timing.eager_press = press_lockout_ms != 0;
+    timing.eager_release = release_lockout_ms != 0;
+    timing.press_ticks = debounceTicks((unsigned long)(timing.eager_press ? press_lockout_ms : debounce_ms) * 1000UL);
+    timing.release_ticks = debounceTicks((unsigned long)(timing.eager_release ? release_lockout_ms : debounce_ms) * 1000UL);
+    return timing;
+}
+
+Debouncer::Debouncer()
+    : m_state(0)
+    , m_pending(0)
+    , m_count_lo(0)
+    , m_count_hi(0)
+    , m_locked(0)
+    , m_press_step(0)
+    , m_release_step(0)
+    , m_lock_until(0)
+{
+}
+
+void Debouncer::reset()
+{
+    m_state = 0;
+    m_pending = 0;
+    m_count_lo = 0;
+    m_count_hi = 0;
+    m_locked = 0;
+    m_press_step = 0;
+    m_release_step = 0;
+    m_lock_until = 0;
+}
+
+uint8_t Debouncer::update(uint8_t raw, uint16_t now, const DebounceTiming& timing)
+{
+    // Lockout over: the locked inputs are debounced again
+    if (m_locked != 0 && (int16_t)(now - m_lock_until) >= 0) {
+        m_locked = 0;
+    }
+
+    // Inputs whose reading differs from the debounced state
+    uint8_t delta = (raw ^ m_state) & (uint8_t)~m_locked;
+    uint8_t pressing = delta & raw;
+    uint8_t releasing = delta & (uint8_t)~raw;
+
+    // Eager edges count at once
+    uint8_t eager = (timing.eager_press ? pressing : 0) | (timing.eager_release ? releasing : 0);
+    delta &= (uint8_t)~eager;
+
+    // Integrated edges: inputs that bounced back drop out and lose their count
+    m_pending &= delta;
+    m_count_lo &= m_pending;
+    m_count_hi &= m_pending;
+
+    uint8_t stable = 0;
+    if (delta != 0) {
+        stable = integrate(delta & pressing, now, timing.press_ticks, m_press_step)
+            | integrate(delta & releasing, now, timing.release_ticks, m_release_step);
+        m_pending &= (uint8_t)~stable;
+        m_count_lo &= m_pending;
+        m_count_hi &= m_pending;
+    }
+
+    if (eager != 0) {
+        // The longest lockout of these edges wins, and extends earlier ones
+        uint16_t lockout = 0;
+        if (eager & pressing) {
+            lockout = timing.press_ticks;
+        }
+        if ((eager & releasing) && timing.release_ticks > lockout) {
+            lockout = timing.release_ticks;
+        }
+        uint16_t until = now + lockout;
+        if (m_locked == 0 || (int16_t)(until - m_lock_until) > 0) {
+            m_lock_until = until;
+        }
+        m_locked |= eager;
+    }
+
+    uint8_t changed = stable | eager;
+    m_state ^= changed;
+    return changed;
+}
+
+uint8_t Debouncer::integrate(uint8_t changing, uint16_t now, uint16_t ticks, uint16_t& step_at)
+{
+    if (changing == 0) {
+        return 0;
+    }
+    if (ticks < DEBOUNCE_STEPS) {
+        return changing; // No debounce time
+    }
+    uint16_t step = ticks / DEBOUNCE_STEPS;
+
+    uint8_t counting = changing & m_pending;
+    uint8_t joining = changing & (uint8_t)~m_pending;
+    uint8_t stable = 0;
+
+    if (counting == 0) {
+        // First input of this direction: the step clock starts with it, so
+        // it has already counted one step
+        step_at = now;
+        m_count_lo |= joining;
+    } else {
+        // Step the counters once per elapsed step; an input already at 3 is stable
+        uint16_t steps = (uint16_t)(now - step_at) / step;
+        step_at += steps * step;
+        for (uint8_t i = 0; i < steps && i <= DEBOUNCE_STEPS && counting != 0; i++) {
+            uint8_t done = counting & m_count_lo & m_count_hi;
+            stable |= done;
+            counting &= (uint8_t)~done;
+            m_count_hi ^= m_count_lo & counting;
+            m_count_lo ^= counting;
+        }
+        // Joining inputs start between two steps: at 0, one step more
+    }
+
+    m_pending |= joining;
+    return stable;
+}
+
+void Debouncer::restart(uint16_t at)
+{
+    // Mark every input pending from the edge, with the step clocks started
+    // there, so update() doesn't start counting at the (later) scan that first
+    // sees the change
+    m_press_step = at;
+    m_release_step = at;
+    m_pending = 0xFF;
+    m_count_lo = 0xFF;
+    m_count_hi = 0;
+}
+
+} // namespace Sensor
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace Sensor {
+
+// Debounce time unit: micros() >> DEBOUNCE_TICK_SHIFT (16 us ticks, so a
+// 16-bit timestamp spans about 1 s - plenty for lockouts up to 255 ms)
+constexpr uint8_t DEBOUNCE_TICK_SHIFT = 4;
+
+// Integrated debounce time is counted per input in this many steps (the 2-bit
+// counters reach 3)
+constexpr uint8_t DEBOUNCE_STEPS = 3;
+
+/**
+ * Convert a micros() timestamp to debounce ticks
+ */
+inline uint16_t debounceTicks(unsigned long us)
+{
+    return (uint16_t)(us >> DEBOUNCE_TICK_SHIFT);
+}
+
+/**
+ * Debounce timing of a sensor, set per edge direction.
+ *
+ * Integrate: a new state counts once it has been read continuously for the
+ * edge's time. Eager: the first reading of a new state counts at once, and
+ * the input is then ignored for the edge's time (lockout). Mixing the two
+ * gives asymmetric debouncing, e.g. an eager press with an integrated release.
+ */
+struct DebounceTiming {
+    uint16_t press_ticks; // Stable time (integrate) or lockout (eager) for presses
+    uint16_t release_ticks; // Same for releases
+    bool eager_press;
+    bool eager_release;
+
+    DebounceTiming()
+        : press_ticks(0)
+        , release_ticks(0)
+        , eager_press(false)
+        , eager_release(false)
+    {
+    }
+
+    /**
+     * Timing from the Configure settings
+     * @param debounce_ms Stable time before a counted edge is reported
+     * @param press_lockout_ms Eager press lockout (0 = integrated press)
+     * @param release_lockout_ms Eager release lockout (0 = integrated release)
+     */
+    static DebounceTiming fromMs(uint8_t debounce_ms, uint8_t press_lockout_ms, uint8_t release_lockout_ms);
+};
+
+/**
+ * Time-based debouncer for up to 8 inputs read together (one bit each,
+ * 1 = active), used by ButtonSensor (1 input) and MatrixSensor (one per row).
+ *
+ * Each integrated input has its own 2-bit vertical counter (bit n of
+ * m_count_hi:m_count_lo is input n's counter), stepped once per elapsed third
+ * of the debounce time, so a chattering input can't hold back the others.
+ * The step clock of each direction restarts when its first input starts
+ * changing; inputs that join while it runs wait one extra step, so every
+ * input is stable for at least the debounce time (less one 16 us tick per
+ * step). A second eager edge extends the lockout of the inputs already
+ * locked, which keeps the state at 11 bytes.
+ */
+class Debouncer {
+public:
+    Debouncer();
+
+    /**
+     * Forget all state (all inputs inactive)
+     */
+    void reset();
+
+    /**
+     * Feed a reading of the inputs
+     * @param raw Raw input bits (1 = active)
+     * @param now Current time in debounce ticks
+     * @param timing Debounce timing
+     * @return Inputs whose debounced state changed
+     */
+    uint8_t update(uint8_t raw, uint16_t now, const DebounceTiming& timing);
+
+    /**
+     * Restart integration from a known edge time (e.g. from an interrupt)
+     * @param at Edge time in debounce ticks
+     */
+    void restart(uint16_t at);
+
+    /**
+     * Get the debounced state
+     * @return Input bits (1 = active)
+     */
+    uint8_t getState() const { return m_state; }
+
+private:
+    // Step the counters of the inputs changing in one direction
+    // Returns the inputs that have been stable for the debounce time
+    uint8_t integrate(uint8_t changing, uint16_t now, uint16_t ticks, uint16_t& step_at);
+
+    uint8_t m_state; // Debounced state
+    uint8_t m_pending; // Integrated inputs reading the new state
+    uint8_t m_count_lo; // Counters of the pending inputs, bit 0 plane
+    uint8_t m_count_hi; // Counters of the pending inputs, bit 1 plane
+    uint8_t m_locked; // Inputs ignored after an eager edge
+    uint16_t m_press_step; // Last counter step of pressing inputs
+    uint16_t m_release_step; // Last counter step of releasing inputs
+    uint16_t m_lock_until; // When the lockout ends
+};
+
+} // namespace Sensor
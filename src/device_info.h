@@ -4,9 +4,10 @@
 
 // Device version (semantic versioning)
 constexpr uint8_t DEVICE_VERSION_MAJOR = 2;
-constexpr uint8_t DEVICE_VERSION_MINOR = 2;
+constexpr uint8_t DEVICE_VERSION_MINOR = 3;
 constexpr uint8_t DEVICE_VERSION_PATCH = 0;
 
 // EEPROM format version - increment when EEPROM layout changes
 // Version 2: Added button and matrix input types with union-based storage
-constexpr uint8_t EEPROM_FORMAT_VERSION = 2;
+// Version 3: Input settings of the 2.x series and calibration records (see CHANGELOG)
+constexpr uint8_t EEPROM_FORMAT_VERSION = 3;
@@ -0,0 +1,128 @@
+#include "edge_capture.h"
+#include <Arduino.h>
+
+#if defined(ESP32_PLATFORM) || defined(ESP32)
+#include <esp_attr.h>
+#include <freertos/FreeRTOS.h>
+#endif
+
+namespace EdgeCapture {
+
+#if defined(ESP32_PLATFORM) || defined(ESP32)
+// Handlers live in IRAM so an edge during a flash write (EEPROM commit) can't
+// fault, and noInterrupts() only masks the local core: with ESP32_DUAL_CORE
+// takeEdge() runs on the other core than the interrupt, so a spinlock guards
+// the slots
+static portMUX_TYPE g_edge_mux = portMUX_INITIALIZER_UNLOCKED;
+#define EDGE_ISR_ATTR IRAM_ATTR
+#define EDGE_LOCK() portENTER_CRITICAL(&g_edge_mux)
+#define EDGE_UNLOCK() portEXIT_CRITICAL(&g_edge_mux)
+#define EDGE_ISR_LOCK() portENTER_CRITICAL_ISR(&g_edge_mux)
+#define EDGE_ISR_UNLOCK() portEXIT_CRITICAL_ISR(&g_edge_mux)
+#else
+// Single core - the interrupt can't run while it is masked
+#define EDGE_ISR_ATTR
+#define EDGE_LOCK() noInterrupts()
+#define EDGE_UNLOCK() interrupts()
+#define EDGE_ISR_LOCK() ((void)0)
+#define EDGE_ISR_UNLOCK() ((void)0)
+#endif
+
+struct Slot {
+    bool in_use;
+    uint8_t pin;
+    volatile bool pending; // Edge seen since the last takeEdge()
+    volatile unsigned long first_edge_us; // Time of the first pending edge
+    volatile unsigned long last_edge_us; // Time of the latest pending edge (bounces)
+};
+
+static Slot g_slots[MAX_SLOTS];
+static volatile bool g_any_edge = false;
+
+// Record an edge - runs in interrupt context
+static void EDGE_ISR_ATTR onEdge(uint8_t slot)
+{
+    Slot& s = g_slots[slot];
+    unsigned long now = micros();
+    EDGE_ISR_LOCK();
+    if (!s.pending) {
+        s.first_edge_us = now;
+        s.pending = true;
+    }
+    s.last_edge_us = now;
+    EDGE_ISR_UNLOCK();
+    g_any_edge = true;
+}
+
+// attachInterrupt() callbacks take no arguments, so each slot gets its own trampoline
+template <uint8_t S>
+static void EDGE_ISR_ATTR slotIsr()
+{
+    onEdge(S);
+}
+
+typedef void (*IsrFunction)();
+static const IsrFunction g_isrs[MAX_SLOTS] = {
+    slotIsr<0>, slotIsr<1>, slotIsr<2>, slotIsr<3>,
+    slotIsr<4>, slotIsr<5>, slotIsr<6>, slotIsr<7>
+};
+
+uint8_t attach(uint8_t pin)
+{
+    int irq = digitalPinToInterrupt(pin);
+    if (irq == NOT_AN_INTERRUPT) {
+        return NO_SLOT; // Pin has no interrupt - caller falls back to polling
+    }
+
+    for (uint8_t i = 0; i < MAX_SLOTS; i++) {
+        if (!g_slots[i].in_use) {
+            g_slots[i].in_use = true;
+            g_slots[i].pin = pin;
+            g_slots[i].pending = false;
+            g_slots[i].first_edge_us = 0;
+            g_slots[i].last_edge_us = 0;
+            attachInterrupt(irq, g_isrs[i], CHANGE);
+            return i;
+        }
+    }
+
+    return NO_SLOT; // All slots in use
+}
+
+void detach(uint8_t slot)
+{
+    if (slot >= MAX_SLOTS || !g_slots[slot].in_use) {
+        return;
+    }
+    detachInterrupt(digitalPinToInterrupt(g_slots[slot].pin));
+    g_slots[slot].in_use = false;
+    g_slots[slot].pending = false;
+}
+
+bool takeEdge(uint8_t slot, unsigned long& first_us, unsigned long& last_us)
+{
+    if (slot >= MAX_SLOTS) {
+        return false;
+    }
+
+    Slot& s = g_slots[slot];
+    EDGE_LOCK();
+    bool pending = s.pending;
+    first_us = s.first_edge_us;
+    last_us = s.last_edge_us;
+    s.pending = false;
+    EDGE_UNLOCK();
+
+    return pending;
+}
+
+bool takeAnyEdge()
+{
+    if (!g_any_edge) {
+        return false;
+    }
+    g_any_edge = false;
+    return true;
+}
+
+} // namespace EdgeCapture
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stdint.h>
+
+// Pin edge capture using external/pin-change interrupts (attachInterrupt).
+// The interrupt only records that an edge happened and when (micros());
+// sensors consume the edge in their scan() and confirm it with their debounce.
+namespace EdgeCapture {
+
+// Maximum number of pins with edge capture (matches MAX_SENSORS)
+constexpr uint8_t MAX_SLOTS = 8;
+
+// Returned by attach() when the pin can't use an interrupt
+constexpr uint8_t NO_SLOT = 0xFF;
+
+// Attach a CHANGE interrupt to a pin
+// Returns a slot id, or NO_SLOT if the pin has no interrupt or all slots are in use
+uint8_t attach(uint8_t pin);
+
+// Detach the interrupt and free the slot
+void detach(uint8_t slot);
+
+// Consume the edge flag for a slot
+// Returns true if at least one edge happened since the last call;
+// first_us and last_us receive the micros() timestamps of the first and the
+// last of those edges (equal for a single edge)
+bool takeEdge(uint8_t slot, unsigned long& first_us, unsigned long& last_us);
+
+// Check and clear the "any edge happened" flag (used to trigger an immediate scan)
+bool takeAnyEdge();
+
+} // namespace EdgeCapture
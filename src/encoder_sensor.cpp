@@ -0,0 +1,166 @@
+#include "encoder_sensor.h"
+#include "input_events.h"
+
+#if defined(ESP32_PLATFORM) || defined(ESP32)
+#include <esp_attr.h>
+#include <freertos/FreeRTOS.h>
+#endif
+
+namespace Sensor {
+
+#if defined(ESP32_PLATFORM) || defined(ESP32)
+// The decoding path lives in IRAM so a step during a flash write (EEPROM
+// commit) can't fault, and noInterrupts() only masks the local core: with
+// ESP32_DUAL_CORE scan() runs on the other core than the interrupt, so a
+// spinlock guards the pending detents
+static portMUX_TYPE g_encoder_mux = portMUX_INITIALIZER_UNLOCKED;
+#define ENCODER_ISR_ATTR IRAM_ATTR
+#define ENCODER_LOCK() portENTER_CRITICAL(&g_encoder_mux)
+#define ENCODER_UNLOCK() portEXIT_CRITICAL(&g_encoder_mux)
+#define ENCODER_ISR_LOCK() portENTER_CRITICAL_ISR(&g_encoder_mux)
+#define ENCODER_ISR_UNLOCK() portEXIT_CRITICAL_ISR(&g_encoder_mux)
+#else
+// Single core - the interrupt can't run while it is masked
+#define ENCODER_ISR_ATTR
+#define ENCODER_LOCK() noInterrupts()
+#define ENCODER_UNLOCK() interrupts()
+#define ENCODER_ISR_LOCK() ((void)0)
+#define ENCODER_ISR_UNLOCK() ((void)0)
+#endif
+
+// Encoder of each interrupt slot
+static EncoderSensor* volatile g_slots[EncoderSensor::MAX_INTERRUPT_ENCODERS];
+
+// attachInterrupt() callbacks take no arguments, so each slot gets its own trampoline
+template <uint8_t S>
+static void ENCODER_ISR_ATTR slotIsr()
+{
+    EncoderSensor* encoder = g_slots[S];
+    if (encoder != nullptr) {
+        ENCODER_ISR_LOCK();
+        encoder->decode();
+        ENCODER_ISR_UNLOCK();
+    }
+}
+
+typedef void (*IsrFunction)();
+static const IsrFunction g_isrs[EncoderSensor::MAX_INTERRUPT_ENCODERS] = {
+    slotIsr<0>, slotIsr<1>, slotIsr<2>, slotIsr<3>
+};
+
+EncoderSensor::EncoderSensor(uint8_t pin_a_number, uint8_t pin_b_number, uint8_t steps, uint8_t accel)
+    : pin_a(pin_a_number)
+    , pin_b(pin_b_number)
+    , steps_per_detent(steps != 0 ? steps : DEFAULT_STEPS_PER_DETENT)
+    , acceleration(accel)
+    , pending_detents(0)
+    , last_detent_us(0)
+    , last_report_us(0)
+    , reported_detent_us(0)
+    , slot(NO_SLOT)
+{
+}
+
+EncoderSensor::~EncoderSensor()
+{
+    detachInterrupts();
+}
+
+void EncoderSensor::begin()
+{
+    // Encoder contacts connect the pins to GND (common pin grounded)
+    pinMode(pin_a, INPUT_PULLUP);
+    pinMode(pin_b, INPUT_PULLUP);
+
+    // Reset state, starting from the current position
+    detachInterrupts();
+    decoder.reset(readPins(), steps_per_detent);
+    pending_detents = 0;
+    last_detent_us = 0;
+    last_report_us = 0;
+    reported_detent_us = 0;
+
+    attachInterrupts();
+}
+
+void ENCODER_ISR_ATTR EncoderSensor::decode()
+{
+    int8_t detent = decoder.update(readPins());
+    if (detent != 0) {
+        pending_detents = pending_detents + detent;
+        last_detent_us = micros();
+    }
+}
+
+void EncoderSensor::scan()
+{
+    if (!usesInterrupt()) {
+        decode();
+    }
+
+    // Take the detents turned so far; the interrupt may add more meanwhile
+    ENCODER_LOCK();
+    int16_t detents = pending_detents;
+    unsigned long detent_us = last_detent_us;
+    ENCODER_UNLOCK();
+
+    // One delta per interval, however many detents it holds
+    unsigned long now_us = micros();
+    if (detents == 0 || (last_report_us != 0 && now_us - last_report_us < REPORT_INTERVAL_US)) {
+        return;
+    }
+
+    // Speed is measured from the last detent of the previous report, so the
+    // first detent after a pause counts 1
+    int16_t delta = reported_detent_us != 0
+        ? accelerateDetents(detents, detent_us - reported_detent_us, acceleration)
+        : detents;
+
+    // If the ring is full the detents stay pending for the next scan
+    if (InputEvents::push(Reading(delta, InputType::Encoder, pin_a, detent_us))) {
+        ENCODER_LOCK();
+        pending_detents = pending_detents - detents;
+        ENCODER_UNLOCK();
+        last_report_us = now_us;
+        reported_detent_us = detent_us;
+    }
+}
+
+uint8_t EncoderSensor::readPins() const
+{
+    return (digitalRead(pin_a) == HIGH ? 0x02 : 0x00) | (digitalRead(pin_b) == HIGH ? 0x01 : 0x00);
+}
+
+bool EncoderSensor::attachInterrupts()
+{
+    int irq_a = digitalPinToInterrupt(pin_a);
+    int irq_b = digitalPinToInterrupt(pin_b);
+    if (irq_a == NOT_AN_INTERRUPT || irq_b == NOT_AN_INTERRUPT) {
+        return false; // Decoded in scan() instead
+    }
+
+    for (uint8_t i = 0; i < MAX_INTERRUPT_ENCODERS; i++) {
+        if (g_slots[i] == nullptr) {
+            g_slots[i] = this;
+            slot = i;
+            attachInterrupt(irq_a, g_isrs[i], CHANGE);
+            attachInterrupt(irq_b, g_isrs[i], CHANGE);
+            return true;
+        }
+    }
+
+    return false; // All slots in use
+}
+
+void EncoderSensor::detachInterrupts()
+{
+    if (slot == NO_SLOT) {
+        return;
+    }
+    detachInterrupt(digitalPinToInterrupt(pin_a));
+    detachInterrupt(digitalPinToInterrupt(pin_b));
+    g_slots[slot] = nullptr;
+    slot = NO_SLOT;
+}
+
+} // namespace Sensor
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "quadrature.h"
+#include "sensor.h"
+#include <Arduino.h>
+
+namespace Sensor {
+
+// Quadrature rotary encoder implementation
+// Both pins are decoded in their CHANGE interrupts (see quadrature.h), so no
+// step is missed between scans; pins without an interrupt (or once all
+// interrupt slots are taken) fall back to decoding in scan()
+// Reports the detents turned since the last report as one signed delta
+// (positive = A leads B), at most every REPORT_INTERVAL_US, optionally scaled
+// up when turned fast
+class EncoderSensor : public ISensor {
+public:
+    // Maximum number of encoders decoded by interrupt
+    static constexpr uint8_t MAX_INTERRUPT_ENCODERS = 4;
+
+    // Returned by getSlot() for a polled encoder
+    static constexpr uint8_t NO_SLOT = 0xFF;
+
+    // Steps per detent used for the Configure default (0)
+    static constexpr uint8_t DEFAULT_STEPS_PER_DETENT = 4;
+
+    // Shortest time between two reports of the same encoder
+    static constexpr unsigned long REPORT_INTERVAL_US = 10000;
+
+private:
+    uint8_t pin_a; // Arduino pin numbers
+    uint8_t pin_b;
+    uint8_t steps_per_detent; // Quadrature steps per detent (1, 2 or 4)
+    uint8_t acceleration; // Extra counts per detent at full speed (0 = off)
+
+    // Decoder state, owned by the interrupt (or by scan() when polling)
+    QuadratureDecoder decoder;
+    volatile int16_t pending_detents; // Detents not yet reported
+    volatile unsigned long last_detent_us; // micros() of the latest detent
+
+    // Report state
+    unsigned long last_report_us; // micros() of the last report
+    unsigned long reported_detent_us; // Latest detent included in the last report
+
+    uint8_t slot; // Interrupt slot (NO_SLOT = polling)
+
+public:
+    EncoderSensor(uint8_t pin_a_number, uint8_t pin_b_number,
+        uint8_t steps = 0, uint8_t accel = 0);
+    ~EncoderSensor() override;
+
+    // ISensor interface implementation
+    void begin() override;
+    void scan() override;
+    InputType getType() const override { return InputType::Encoder; }
+    uint8_t getPin() const override { return pin_a; }
+
+    // Check if the pins are decoded by interrupt (false = polling fallback)
+    bool usesInterrupt() const { return slot != NO_SLOT; }
+
+    // Read both pins and count the step - runs in interrupt context (or from
+    // scan() when polling)
+    void decode();
+
+private:
+    // Pin levels for the decoder (bit 1 = A, bit 0 = B)
+    uint8_t readPins() const;
+
+    // Attach CHANGE interrupts to both pins; false if not possible
+    bool attachInterrupts();
+    void detachInterrupts();
+};
+
+} // namespace Sensor
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <stdint.h>
+
+// Memory barrier between writing a slot and publishing its index.
+// AVR is single-core, so a compiler barrier is enough; ESP32/SAM need a real fence.
+#if defined(__AVR__)
+#define EVENT_RING_BARRIER() __asm__ __volatile__("" ::: "memory")
+#else
+#define EVENT_RING_BARRIER() __sync_synchronize()
+#endif
+
+/**
+ * Lock-free single-producer/single-consumer ring buffer.
+ *
+ * One context (e.g. a timer ISR) may call push() while another (e.g. the main
+ * loop) calls pop(), without disabling interrupts. Head and tail are 8-bit
+ * free-running counters, so every index update is a single atomic byte write.
+ *
+ * @tparam T Element type (copied by value)
+ * @tparam N Capacity - must be a power of two, at most 128
+ */
+template <typename T, uint8_t N>
+class EventRing {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "EventRing size must be a power of two");
+    static_assert(N <= 128, "EventRing size must fit 8-bit counters");
+
+public:
+    EventRing()
+        : m_head(0)
+        , m_tail(0)
+    {
+    }
+
+    /**
+     * Append an element (producer side)
+     * @param item Element to copy into the ring
+     * @return false if the ring is full (item not stored)
+     */
+    bool push(const T& item)
+    {
+        uint8_t tail = m_tail;
+        if ((uint8_t)(tail - m_head) >= N) {
+            return false;
+        }
+        m_items[tail & (N - 1)] = item;
+        EVENT_RING_BARRIER();
+        m_tail = tail + 1;
+        return true;
+    }
+
+    /**
+     * Remove the oldest element (consumer side)
+     * @param item Receives the element
+     * @return false if the ring is empty
+     */
+    bool pop(T& item)
+    {
+        uint8_t head = m_head;
+        if (head == m_tail) {
+            return false;
+        }
+        EVENT_RING_BARRIER();
+        item = m_items[head & (N - 1)];
+        EVENT_RING_BARRIER();
+        m_head = head + 1;
+        return true;
+    }
+
+    // Number of stored elements
+    uint8_t size() const { return (uint8_t)(m_tail - m_head); }
+
+    bool empty() const { return m_head == m_tail; }
+
+    bool full() const { return size() >= N; }
+
+    static constexpr uint8_t capacity() { return N; }
+
+    // Discard all elements - only safe while the producer is stopped
+    void clear() { m_head = m_tail; }
+
+private:
+    T m_items[N];
+    volatile uint8_t m_head; // Written only by the consumer
+    volatile uint8_t m_tail; // Written only by the producer
+};
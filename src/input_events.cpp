@@ -0,0 +1,46 @@
+#include "input_events.h"
+#include "event_ring.h"
+
+namespace InputEvents {
+
+static EventRing<Sensor::Reading, RING_SIZE> g_ring;
+
+// Written only by the producer
+static volatile uint16_t g_overflows = 0;
+
+bool push(const Sensor::Reading& reading)
+{
+    if (!g_ring.push(reading)) {
+        g_overflows = g_overflows + 1;
+        return false;
+    }
+    return true;
+}
+
+bool hasRoom(uint8_t count)
+{
+    return (uint8_t)(RING_SIZE - g_ring.size()) >= count;
+}
+
+bool pop(Sensor::Reading& reading)
+{
+    return g_ring.pop(reading);
+}
+
+uint16_t getOverflowCount()
+{
+    // The producer may be an interrupt: read until two reads agree, so a
+    // 16-bit value isn't torn on 8-bit boards
+    uint16_t count;
+    do {
+        count = g_overflows;
+    } while (count != g_overflows);
+    return count;
+}
+
+void clear()
+{
+    g_ring.clear();
+}
+
+} // namespace InputEvents
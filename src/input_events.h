@@ -0,0 +1,53 @@
+#pragma once
+
+#include "sensor.h"
+#include <stdint.h>
+
+#if defined(__AVR__)
+#include <avr/io.h> // RAMEND
+#endif
+
+// Device-wide input event ring.
+// Sensors push their changes from scan() with the micros() timestamp of the
+// change; MessageHandler pops them in order and sends them to the host.
+// One producer (the scan tasks, or the sampling timer with TIMER_SAMPLING)
+// and one consumer (the main loop), so neither side disables interrupts.
+// Ring size follows the board's RAM; -D INPUT_EVENT_RING_SIZE=<n> overrides it
+// (power of two, at most 128).
+#ifndef INPUT_EVENT_RING_SIZE
+#if defined(__AVR__) && RAMEND < 0x900
+#define INPUT_EVENT_RING_SIZE 16 // ATmega328P (2 KB)
+#elif defined(__AVR__) && RAMEND < 0x2000
+#define INPUT_EVENT_RING_SIZE 32 // ATmega32U4 (2.5 KB)
+#elif defined(__AVR__)
+#define INPUT_EVENT_RING_SIZE 64 // ATmega2560 (8 KB)
+#else
+#define INPUT_EVENT_RING_SIZE 128 // Due, ESP32
+#endif
+#endif
+
+namespace InputEvents {
+
+constexpr uint8_t RING_SIZE = INPUT_EVENT_RING_SIZE;
+
+// Append a reading (producer side)
+// Returns false if the ring is full; the reading is not stored and the
+// overflow counter goes up
+bool push(const Sensor::Reading& reading);
+
+// Check that count readings fit (producer side)
+// Only the producer takes space, so pushes that follow all succeed; lets a
+// sensor push a group of related readings all or nothing
+bool hasRoom(uint8_t count);
+
+// Remove the oldest reading (consumer side)
+// Returns false if the ring is empty
+bool pop(Sensor::Reading& reading);
+
+// Number of pushes rejected because the ring was full (free-running, wraps)
+uint16_t getOverflowCount();
+
+// Discard all readings - only safe while no sensor is scanned
+void clear();
+
+} // namespace InputEvents
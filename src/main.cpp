@@ -1,16 +1,74 @@
+#include "adc_sequencer.h"
 #include "config_manager.h"
+#include "edge_capture.h"
 #include "message_handler.h"
 #include "output_manager.h"
+#include "power_manager.h"
+#include "profiler.h"
+#include "scheduler.h"
+#include "sensor_sampler.h"
 #include "sensor_manager.h"
 #include <Arduino.h>
 #include <PacketSerial.h>
 
+// Task periods and deadlines in microseconds
+// Button and matrix debounce is timed in microseconds, so 1 kHz only sets its resolution.
+// Encoders are decoded by interrupt (or polled at 1 kHz with the buttons) and report at most every 10 ms.
+// Analog stays at 100 Hz (its filters and noise floor window count samples).
+constexpr unsigned long SEND_READINGS_PERIOD_US = 1000;
+constexpr unsigned long SEND_READINGS_DEADLINE_US = 1000;
+constexpr unsigned long BUTTON_SCAN_PERIOD_US = 1000;
+constexpr unsigned long BUTTON_SCAN_DEADLINE_US = 500;
+constexpr unsigned long MATRIX_SCAN_PERIOD_US = 1000;
+constexpr unsigned long MATRIX_SCAN_DEADLINE_US = 500;
+constexpr unsigned long ANALOG_SCAN_PERIOD_US = 10000;
+constexpr unsigned long ANALOG_SCAN_DEADLINE_US = 5000;
+constexpr unsigned long HEARTBEAT_PERIOD_US = 10000;
+constexpr unsigned long HEARTBEAT_DEADLINE_US = 10000;
+constexpr unsigned long CONFIG_TIMEOUT_PERIOD_US = 100000;
+constexpr unsigned long CONFIG_TIMEOUT_DEADLINE_US = 100000;
+
 // Global packet serial instance
 PacketSerial_<COBS> g_packet_serial;
 
+// Global task scheduler
+Scheduler::TaskScheduler g_scheduler;
+
+// Button scan task id (triggered early when a button interrupt fires)
+uint8_t g_button_scan_task = Scheduler::TaskScheduler::INVALID_TASK;
+
+// Task ids of the tasks slowed down while idle
+uint8_t g_matrix_scan_task = Scheduler::TaskScheduler::INVALID_TASK;
+uint8_t g_analog_scan_task = Scheduler::TaskScheduler::INVALID_TASK;
+uint8_t g_send_readings_task = Scheduler::TaskScheduler::INVALID_TASK;
+uint8_t g_heartbeat_task = Scheduler::TaskScheduler::INVALID_TASK;
+
+// True while in the idle low-power state
+bool g_idle = false;
+
 // Forward declaration for packet callback
 void onPacketReceived(const uint8_t* buffer, size_t size);
 
+// Scheduler task callbacks
+void serialRxTask()
+{
+    PROFILE_PHASE(Profiler::PHASE_SERIAL_RX);
+    g_packet_serial.update();
+}
+#ifndef TIMER_SAMPLING
+void buttonScanTask()
+{
+    SensorManager::scan(Sensor::InputType::Button);
+    SensorManager::scan(Sensor::InputType::Encoder);
+}
+void matrixScanTask() { SensorManager::scan(Sensor::InputType::Matrix); }
+void analogScanTask()
+{
+    SensorManager::scan(Sensor::InputType::Analog);
+    SensorManager::scan(Sensor::InputType::Notched);
+}
+#endif
+
 void setup()
 {
     // Initialize serial communication
@@ -21,26 +79,91 @@ void setup()
     ConfigManager::init();
     SensorManager::init();
     OutputManager::init();
-    MessageHandler::init(&g_packet_serial);
+    MessageHandler::init(&g_packet_serial, &g_scheduler);
 
     // Apply loaded configuration to sensors
     uint8_t num_inputs = 0;
     const ConfigManager::InputConfig* inputs = ConfigManager::getCurrentConfig(num_inputs);
     SensorManager::applyConfiguration(inputs, num_inputs);
+
+    // Register tasks (serial RX runs on every pass, so it has no period)
+    g_scheduler.addTask(serialRxTask, 0, 0);
+#ifdef TIMER_SAMPLING
+    // Sensors are scanned by the hardware timer instead of scheduler tasks
+    SensorSampler::begin(SENSOR_SAMPLE_RATE_HZ);
+#else
+    g_button_scan_task = g_scheduler.addTask(buttonScanTask, BUTTON_SCAN_PERIOD_US, BUTTON_SCAN_DEADLINE_US);
+    g_matrix_scan_task = g_scheduler.addTask(matrixScanTask, MATRIX_SCAN_PERIOD_US, MATRIX_SCAN_DEADLINE_US);
+    g_analog_scan_task = g_scheduler.addTask(analogScanTask, ANALOG_SCAN_PERIOD_US, ANALOG_SCAN_DEADLINE_US);
+#endif
+    g_send_readings_task = g_scheduler.addTask(MessageHandler::update, SEND_READINGS_PERIOD_US, SEND_READINGS_DEADLINE_US);
+    g_heartbeat_task = g_scheduler.addTask(MessageHandler::updateHeartbeat, HEARTBEAT_PERIOD_US, HEARTBEAT_DEADLINE_US);
+    g_scheduler.addTask(MessageHandler::checkConfigTimeout, CONFIG_TIMEOUT_PERIOD_US, CONFIG_TIMEOUT_DEADLINE_US);
+}
+
+// Slow the periodic tasks down to coarse checks while idle, or restore their
+// full rate. Buttons with a pin interrupt wake the MCU and end idle on their
+// own; buttons and encoders that are only polled keep their full rate so a
+// short tap isn't missed
+void setIdle(bool idle)
+{
+    bool coarse_buttons = idle && !SensorManager::hasPolledPins();
+    g_scheduler.setPeriod(g_button_scan_task, PowerManager::taskPeriod(BUTTON_SCAN_PERIOD_US, coarse_buttons));
+    g_scheduler.setPeriod(g_matrix_scan_task, PowerManager::taskPeriod(MATRIX_SCAN_PERIOD_US, idle));
+    g_scheduler.setPeriod(g_analog_scan_task, PowerManager::taskPeriod(ANALOG_SCAN_PERIOD_US, idle));
+    g_scheduler.setPeriod(g_send_readings_task, PowerManager::taskPeriod(SEND_READINGS_PERIOD_US, idle));
+    g_scheduler.setPeriod(g_heartbeat_task, PowerManager::taskPeriod(HEARTBEAT_PERIOD_US, idle));
 }
 
 void loop()
 {
-    // Update packet serial (processes incoming packets)
-    g_packet_serial.update();
+    PROFILE_LOOP(micros());
+
+    // A button edge was captured by interrupt - scan buttons now instead of
+    // waiting for the next release. The edge is activity: leaving idle first
+    // brings the scans back to full rate for its debounce
+    if (EdgeCapture::takeAnyEdge()) {
+        PowerManager::notifyActivity(millis());
+        g_scheduler.trigger(g_button_scan_task);
+    }
+
+    // Enter/leave idle
+    bool idle = PowerManager::isIdle(millis());
+    if (idle != g_idle) {
+        g_idle = idle;
+        setIdle(idle);
+#ifdef TIMER_SAMPLING
+        // The sampling tick reads the ADC sequencer - stop it while the
+        // sequencer is switched, as applyConfiguration() does
+        SensorSampler::stop();
+#endif
+#if defined(ADC_SEQUENCER) && !defined(ADC_SEQUENCER_DMA)
+        // Every conversion interrupt would wake the MCU - use analogRead() while idle
+        // (the DMA backends interrupt once per buffer at most and keep running)
+        if (idle) {
+            AdcSequencer::stop();
+        } else {
+            AdcSequencer::start();
+        }
+#endif
+#ifdef TIMER_SAMPLING
+        // Polled buttons and encoders keep the full rate, like the button task
+        bool coarse = idle && !SensorManager::hasPolledPins();
+        SensorSampler::begin(coarse ? SensorSampler::IDLE_SAMPLE_RATE_HZ : SENSOR_SAMPLE_RATE_HZ);
+#endif
+    }
 
-    // Update message handler (handles timeouts, etc.)
-    MessageHandler::update();
+    // Run every task that is due; no fixed delay, so each task keeps its own rate
+    g_scheduler.update(micros());
 
-    // Control scan rate: delay to achieve ~100 Hz scan rate
-    // This makes MIN_GAP_SCANS = 200 equal to ~2 seconds
-    // analogRead() takes ~100us, so we add 10ms delay for ~100 Hz total
-    delay(10);
+    // While idle, sleep until the next interrupt (timer tick, pin change or
+    // incoming bytes) instead of spinning until the next task release
+    if (g_idle) {
+        unsigned long wait_us = g_scheduler.timeUntilNextRelease(micros());
+        if (wait_us > 0) {
+            PowerManager::sleep(wait_us);
+        }
+    }
 }
 
 // Packet received callback - delegates to message handler
@@ -1,28 +1,180 @@
 #include "matrix_sensor.h"
+#include "input_events.h"
 #include <string.h>
 
+#if defined(MATRIX_PORT_IO) && !defined(MATRIX_PORT_IO_MOCK) && (defined(ESP32_PLATFORM) || defined(ESP32))
+#include <soc/gpio_reg.h>
+#endif
+
 namespace Sensor {
 
+#if defined(MATRIX_PORT_IO_MOCK)
+// rowPort(), columnPort(), driveRowLow() and driveRowHigh() are provided by the test
+
+#elif defined(MATRIX_PORT_IO) && defined(__AVR__)
+
+// PORTx for a row pin - AVR has no set/clear registers, so both are PORTx
+static bool rowPort(uint8_t pin, volatile MatrixPortValue*& clear_reg,
+    volatile MatrixPortValue*& set_reg, MatrixPortValue& mask)
+{
+    uint8_t port = digitalPinToPort(pin);
+    if (port == NOT_A_PIN) {
+        return false;
+    }
+    clear_reg = portOutputRegister(port);
+    set_reg = clear_reg;
+    mask = digitalPinToBitMask(pin);
+    return true;
+}
+
+// PINx for a column pin
+static bool columnPort(uint8_t pin, const volatile MatrixPortValue*& in_reg, MatrixPortValue& mask)
+{
+    uint8_t port = digitalPinToPort(pin);
+    if (port == NOT_A_PIN) {
+        return false;
+    }
+    in_reg = portInputRegister(port);
+    mask = digitalPinToBitMask(pin);
+    return true;
+}
+
+// Read-modify-write with interrupts off, like digitalWrite() (an ISR may use the same port)
+static inline void driveRowLow(volatile MatrixPortValue* reg, MatrixPortValue mask)
+{
+    uint8_t sreg = SREG;
+    cli();
+    *reg &= (MatrixPortValue)~mask;
+    SREG = sreg;
+}
+
+static inline void driveRowHigh(volatile MatrixPortValue* reg, MatrixPortValue mask)
+{
+    uint8_t sreg = SREG;
+    cli();
+    *reg |= mask;
+    SREG = sreg;
+}
+
+#elif defined(MATRIX_PORT_IO) && defined(ARDUINO_ARCH_SAM)
+
+// PIO_CODR/PIO_SODR for a row pin (atomic clear/set)
+static bool rowPort(uint8_t pin, volatile MatrixPortValue*& clear_reg,
+    volatile MatrixPortValue*& set_reg, MatrixPortValue& mask)
+{
+    if (pin >= PINS_COUNT || g_APinDescription[pin].pPort == NULL) {
+        return false;
+    }
+    Pio* port = g_APinDescription[pin].pPort;
+    clear_reg = &port->PIO_CODR;
+    set_reg = &port->PIO_SODR;
+    mask = g_APinDescription[pin].ulPin;
+    return true;
+}
+
+// PIO_PDSR for a column pin
+static bool columnPort(uint8_t pin, const volatile MatrixPortValue*& in_reg, MatrixPortValue& mask)
+{
+    if (pin >= PINS_COUNT || g_APinDescription[pin].pPort == NULL) {
+        return false;
+    }
+    in_reg = &g_APinDescription[pin].pPort->PIO_PDSR;
+    mask = g_APinDescription[pin].ulPin;
+    return true;
+}
+
+static inline void driveRowLow(volatile MatrixPortValue* reg, MatrixPortValue mask)
+{
+    *reg = mask;
+}
+
+static inline void driveRowHigh(volatile MatrixPortValue* reg, MatrixPortValue mask)
+{
+    *reg = mask;
+}
+
+#elif defined(MATRIX_PORT_IO)
+
+// GPIO_OUT_W1TC/W1TS for a row pin (atomic clear/set, pins 32+ in the second bank)
+static bool rowPort(uint8_t pin, volatile MatrixPortValue*& clear_reg,
+    volatile MatrixPortValue*& set_reg, MatrixPortValue& mask)
+{
+    if (pin >= 40) {
+        return false;
+    }
+    bool high_bank = pin >= 32;
+    clear_reg = (volatile MatrixPortValue*)(high_bank ? GPIO_OUT1_W1TC_REG : GPIO_OUT_W1TC_REG);
+    set_reg = (volatile MatrixPortValue*)(high_bank ? GPIO_OUT1_W1TS_REG : GPIO_OUT_W1TS_REG);
+    mask = 1UL << (pin & 31);
+    return true;
+}
+
+// GPIO_IN for a column pin
+static bool columnPort(uint8_t pin, const volatile MatrixPortValue*& in_reg, MatrixPortValue& mask)
+{
+    if (pin >= 40) {
+        return false;
+    }
+    in_reg = (const volatile MatrixPortValue*)(pin >= 32 ? GPIO_IN1_REG : GPIO_IN_REG);
+    mask = 1UL << (pin & 31);
+    return true;
+}
+
+static inline void driveRowLow(volatile MatrixPortValue* reg, MatrixPortValue mask)
+{
+    *reg = mask;
+}
+
+static inline void driveRowHigh(volatile MatrixPortValue* reg, MatrixPortValue mask)
+{
+    *reg = mask;
+}
+
+#endif
+
 MatrixSensor::MatrixSensor(uint8_t rows, uint8_t cols,
-                           const uint8_t* row_pin_array, const uint8_t* col_pin_array)
+                           const uint8_t* row_pin_array, const uint8_t* col_pin_array,
+                           uint8_t settle_time_us, uint8_t rows_per_tick,
+                           uint8_t diode_direction,
+                           uint8_t press_lockout, uint8_t release_lockout,
+                           uint8_t debounce_ms)
     : num_rows(rows < MAX_ROWS ? rows : MAX_ROWS)
     , num_cols(cols < MAX_COLS ? cols : MAX_COLS)
-    , queue_head(0)
-    , queue_tail(0)
-    , debounce_threshold(DEFAULT_DEBOUNCE)
+    , transposed(false)
+    , settle_us(settle_time_us != 0 ? settle_time_us : DEFAULT_SETTLE_US)
+    , rows_per_scan(rows_per_tick)
+    , next_row(0)
+    , anti_ghost(diode_direction == DIODES_NONE)
+#ifdef MATRIX_PORT_IO
+    , num_col_ports(0)
+    , port_io(false)
+#endif
+    , timing(DebounceTiming::fromMs(debounce_ms != 0 ? debounce_ms : DEFAULT_DEBOUNCE_MS,
+          press_lockout, release_lockout))
 {
-    // Copy pin arrays
+    // Drive the side the diodes allow, or the smaller side without diodes
+    // (each driven line costs a settle time per frame)
+    if (diode_direction == DIODES_ROW_TO_COL) {
+        transposed = true;
+    } else if (diode_direction == DIODES_NONE) {
+        transposed = num_cols < num_rows;
+    }
+
+    if (transposed) {
+        uint8_t configured_rows = num_rows;
+        num_rows = num_cols;
+        num_cols = configured_rows;
+    }
+
+    // Copy pin arrays (rows are the driven lines)
     for (uint8_t i = 0; i < num_rows; i++) {
-        row_pins[i] = row_pin_array[i];
+        row_pins[i] = transposed ? col_pin_array[i] : row_pin_array[i];
     }
     for (uint8_t i = 0; i < num_cols; i++) {
-        col_pins[i] = col_pin_array[i];
+        col_pins[i] = transposed ? row_pin_array[i] : col_pin_array[i];
     }
 
-    // Initialize state arrays
-    memset(current_state, 0, sizeof(current_state));
-    memset(last_reported, 0, sizeof(last_reported));
-    memset(debounce_count, 0, sizeof(debounce_count));
+    resetState();
 }
 
 void MatrixSensor::begin()
@@ -38,97 +190,262 @@ void MatrixSensor::begin()
         pinMode(col_pins[c], INPUT_PULLUP);
     }
 
+#ifdef MATRIX_PORT_IO
+    port_io = mapPorts();
+#endif
+
     // Reset state
-    memset(current_state, 0, sizeof(current_state));
-    memset(last_reported, 0, sizeof(last_reported));
-    memset(debounce_count, 0, sizeof(debounce_count));
-    queue_head = 0;
-    queue_tail = 0;
+    resetState();
+    next_row = 0;
+
+    // Tell the host the rollover of a matrix without diodes
+    resync_pending = anti_ghost;
 }
 
 void MatrixSensor::scan()
 {
-    // Scan each row
-    for (uint8_t row = 0; row < num_rows; row++) {
-        // Activate current row (drive LOW)
-        digitalWrite(row_pins[row], LOW);
+    if (num_rows == 0) {
+        return;
+    }
 
-        // Small delay for signal to settle
-        delayMicroseconds(10);
+    // Rows of this call: the whole frame, or the next slice of it
+    uint8_t first = next_row;
+    uint8_t last = num_rows;
+    if (rows_per_scan != ROWS_PER_TICK_ALL && num_rows - first > rows_per_scan) {
+        last = first + rows_per_scan;
+    }
 
-        // Read all columns
-        for (uint8_t col = 0; col < num_cols; col++) {
-            // Button is pressed if column reads LOW (pulled down by row)
-            bool raw_pressed = (digitalRead(col_pins[col]) == LOW);
-            scanButton(row, col, raw_pressed);
+    unsigned long now_us = micros();
+
+    // Pipelined: row N+1 is driven as soon as row N is read, and settles
+    // while row N is debounced
+    setRowActive(first, true);
+    unsigned long driven_at = micros();
+
+    for (uint8_t row = first; row < last; row++) {
+        waitSettled(driven_at);
+
+        // Read all columns at once, then move on to the next row
+        uint8_t pressed = readColumns();
+        setRowActive(row, false);
+        if (row + 1 < last) {
+            setRowActive(row + 1, true);
+            driven_at = micros();
         }
 
-        // Deactivate row (drive HIGH)
-        digitalWrite(row_pins[row], HIGH);
+        debounceRow(row, pressed, now_us);
     }
+
+    next_row = last < num_rows ? last : 0;
+
+    if (anti_ghost && next_row == 0) {
+        reportFrame(now_us);
+    }
+}
+
+void MatrixSensor::waitSettled(unsigned long driven_at) const
+{
+    // Only wait for what the debounce work of the previous row didn't cover
+    unsigned long elapsed = micros() - driven_at;
+    if (elapsed < settle_us) {
+        delayMicroseconds((unsigned int)(settle_us - elapsed));
+    }
+}
+
+void MatrixSensor::resetState()
+{
+    for (uint8_t r = 0; r < MAX_ROWS; r++) {
+        debouncers[r].reset();
+    }
+    memset(last_reported, 0, sizeof(last_reported));
+    memset(frame_raw, 0, sizeof(frame_raw));
+    memset(blocked, 0, sizeof(blocked));
+    resync_pending = false;
 }
 
-void MatrixSensor::scanButton(uint8_t row, uint8_t col, bool raw_pressed)
+bool MatrixSensor::takeResync()
 {
-    uint8_t idx = buttonIndex(row, col);
+    // Cleared before the caller reads the state, so a drop after this
+    // point either is in that state or flags the next resync
+    if (!resync_pending) {
+        return false;
+    }
+    resync_pending = false;
+    return true;
+}
 
-    // Counter-based debounce algorithm
-    if (raw_pressed == current_state[idx]) {
-        // Reading matches current state, reset counter
-        debounce_count[idx] = 0;
-    } else {
-        // Reading differs from current state
-        debounce_count[idx]++;
+uint8_t MatrixSensor::getReportedState(uint8_t* pressed, uint8_t* blocked_keys) const
+{
+    fillBitmap(last_reported, pressed);
+    fillBitmap(blocked, blocked_keys);
+    return num_rows * num_cols;
+}
 
-        if (debounce_count[idx] >= debounce_threshold) {
-            // Stable new state detected
-            current_state[idx] = raw_pressed;
-            debounce_count[idx] = 0;
+void MatrixSensor::fillBitmap(const uint8_t* rows, uint8_t* bitmap) const
+{
+    memset(bitmap, 0, (num_rows * num_cols + 7) / 8);
 
-            // Check if this is a new edge event
-            if (current_state[idx] != last_reported[idx]) {
-                enqueueEvent(idx, current_state[idx]);
+    for (uint8_t row = 0; row < num_rows; row++) {
+        uint8_t state = rows[row];
+        for (uint8_t col = 0; state != 0; col++, state >>= 1) {
+            if (state & 0x01) {
+                uint8_t index = buttonIndex(row, col);
+                bitmap[index >> 3] |= (uint8_t)(1 << (index & 0x07));
             }
         }
     }
 }
 
-void MatrixSensor::enqueueEvent(uint8_t button_index, bool pressed)
+#ifdef MATRIX_PORT_IO
+bool MatrixSensor::mapPorts()
 {
-    // Calculate next tail position
-    uint8_t next_tail = (queue_tail + 1) % EVENT_QUEUE_SIZE;
+    for (uint8_t r = 0; r < num_rows; r++) {
+        if (!rowPort(row_pins[r], row_clear_reg[r], row_set_reg[r], row_mask[r])) {
+            return false;
+        }
+    }
 
-    // Check if queue is full
-    if (next_tail == queue_head) {
-        // Queue full, drop oldest event
-        queue_head = (queue_head + 1) % EVENT_QUEUE_SIZE;
+    // Columns on the same port share one register read
+    num_col_ports = 0;
+    for (uint8_t c = 0; c < num_cols; c++) {
+        const volatile MatrixPortValue* reg;
+        if (!columnPort(col_pins[c], reg, col_mask[c])) {
+            return false;
+        }
+        uint8_t p = 0;
+        while (p < num_col_ports && col_port_reg[p] != reg) {
+            p++;
+        }
+        if (p == num_col_ports) {
+            col_port_reg[num_col_ports++] = reg;
+        }
+        col_port[c] = p;
     }
+    return true;
+}
+#endif
 
-    // Add event to queue
-    event_queue[queue_tail].button_index = button_index;
-    event_queue[queue_tail].pressed = pressed;
-    queue_tail = next_tail;
+void MatrixSensor::setRowActive(uint8_t row, bool active)
+{
+#ifdef MATRIX_PORT_IO
+    if (port_io) {
+        if (active) {
+            driveRowLow(row_clear_reg[row], row_mask[row]);
+        } else {
+            driveRowHigh(row_set_reg[row], row_mask[row]);
+        }
+        return;
+    }
+#endif
+    digitalWrite(row_pins[row], active ? LOW : HIGH);
 }
 
-Reading MatrixSensor::getReading()
+uint8_t MatrixSensor::readColumns() const
 {
-    if (isQueueEmpty()) {
-        return Reading(); // No events to report
+    // Button is pressed if column reads LOW (pulled down by row)
+    uint8_t pressed = 0;
+
+#ifdef MATRIX_PORT_IO
+    if (port_io) {
+        // One read per port, then pick each column's bit out of it
+        MatrixPortValue ports[MAX_COLS];
+        for (uint8_t p = 0; p < num_col_ports; p++) {
+            ports[p] = *col_port_reg[p];
+        }
+        for (uint8_t col = 0; col < num_cols; col++) {
+            if (!(ports[col_port[col]] & col_mask[col])) {
+                pressed |= (uint8_t)(1 << col);
+            }
+        }
+        return pressed;
     }
+#endif
 
-    // Get event from queue head
-    PendingEvent& event = event_queue[queue_head];
-    queue_head = (queue_head + 1) % EVENT_QUEUE_SIZE;
+    for (uint8_t col = 0; col < num_cols; col++) {
+        if (digitalRead(col_pins[col]) == LOW) {
+            pressed |= (uint8_t)(1 << col);
+        }
+    }
+    return pressed;
+}
 
-    // Update last reported state
-    last_reported[event.button_index] = event.pressed;
+void MatrixSensor::debounceRow(uint8_t row, uint8_t raw_pressed, unsigned long now_us)
+{
+    uint8_t changed = debouncers[row].update(raw_pressed, debounceTicks(now_us), timing);
+    if (anti_ghost) {
+        frame_raw[row] = raw_pressed;
+        return;
+    }
+    if (changed == 0) {
+        return;
+    }
 
-    // Create reading with virtual pin
-    // value = 1 for press, 0 for release
-    int16_t value = event.pressed ? 1 : 0;
-    uint8_t pin = virtualPin(event.button_index);
+    // Push the buttons whose new state hasn't been reported yet
+    uint8_t state = debouncers[row].getState();
+    uint8_t edges = changed & (state ^ last_reported[row]);
+    for (uint8_t col = 0; edges != 0; col++, edges >>= 1) {
+        if (!(edges & 0x01)) {
+            continue;
+        }
+        pushButton(row, col, state & (1 << col), now_us);
+    }
+}
+
+void MatrixSensor::reportFrame(unsigned long now_us)
+{
+    // Keys that read as pressed now, debounced or not: a ghost shows up in
+    // the raw reading as soon as the third key of its L does
+    uint8_t down[MAX_ROWS];
+    for (uint8_t row = 0; row < num_rows; row++) {
+        down[row] = debouncers[row].getState() | frame_raw[row];
+    }
 
-    return Reading(value, InputType::Matrix, pin);
+    // Two rows sharing two or more pressed columns form a rectangle, and any
+    // of its corners could be a ghost of the other three
+    uint8_t ambiguous[MAX_ROWS] = { 0 };
+    for (uint8_t a = 0; a + 1 < num_rows; a++) {
+        if ((down[a] & (down[a] - 1)) == 0) {
+            continue; // Fewer than two keys
+        }
+        for (uint8_t b = a + 1; b < num_rows; b++) {
+            uint8_t shared = down[a] & down[b];
+            if (shared & (shared - 1)) {
+                ambiguous[a] |= shared;
+                ambiguous[b] |= shared;
+            }
+        }
+    }
+
+    for (uint8_t row = 0; row < num_rows; row++) {
+        // Keys already reported stay pressed; new presses in a rectangle wait.
+        // A blocked key stays blocked until its reading agrees with its
+        // debounced state: a ghost's release can settle a frame after the
+        // real key's that broke the rectangle
+        uint8_t state = debouncers[row].getState();
+        uint8_t hold = (ambiguous[row] & state & (uint8_t)~last_reported[row]) |
+                       (blocked[row] & state & (uint8_t)(frame_raw[row] ^ state));
+        if (hold != blocked[row]) {
+            blocked[row] = hold;
+            resync_pending = true;
+        }
+
+        uint8_t edges = (state ^ last_reported[row]) & (uint8_t)~hold;
+        for (uint8_t col = 0; edges != 0; col++, edges >>= 1) {
+            if (edges & 0x01) {
+                pushButton(row, col, state & (1 << col), now_us);
+            }
+        }
+    }
+}
+
+void MatrixSensor::pushButton(uint8_t row, uint8_t col, bool pressed, unsigned long now_us)
+{
+    // value = 1 for press, 0 for release
+    if (!InputEvents::push(Reading(pressed ? 1 : 0, InputType::Matrix, virtualPin(buttonIndex(row, col)), now_us))) {
+        // Ring full: the change goes out with the full state instead
+        resync_pending = true;
+    }
+    last_reported[row] ^= (uint8_t)(1 << col);
 }
 
 } // namespace Sensor
@@ -1,13 +1,48 @@
 #pragma once
 
+#include "debounce.h"
 #include "sensor.h"
 #include <Arduino.h>
 
+// Direct port register access for the matrix scan - begin() looks up each
+// pin's port register and bit mask once, and a row's columns are read with one
+// register read per port instead of a digitalRead() per column.
+// Other boards (and -D NO_MATRIX_PORT_IO) use digitalRead()/digitalWrite().
+// -D MATRIX_PORT_IO_MOCK takes the register accessors from the native tests.
+#if defined(MATRIX_PORT_IO_MOCK)
+#define MATRIX_PORT_IO
+typedef uint8_t MatrixPortValue;
+#elif defined(NO_MATRIX_PORT_IO)
+// Disabled
+#elif defined(__AVR__)
+#define MATRIX_PORT_IO
+typedef uint8_t MatrixPortValue;
+#elif defined(ARDUINO_ARCH_SAM) || defined(ESP32_PLATFORM) || defined(ESP32)
+#define MATRIX_PORT_IO
+typedef uint32_t MatrixPortValue;
+#endif
+
 namespace Sensor {
 
 // Matrix sensor implementation
-// Uses row/column scanning with per-button debouncing
-// Reports edge events for each button with virtual pin scheme
+// Uses row/column scanning with time-based debouncing (see debounce.h; a row's
+// buttons are debounced together as one bitset)
+// A frame (all rows) can be split over several scan() calls, so a large matrix
+// doesn't add one long block to every loop iteration; the debounce time doesn't
+// depend on the scan or frame rate
+// Eager mode (per edge direction) reports a key's first reading of a new state
+// at once and then ignores the key for a lockout window
+// Without diodes the smaller side is driven: the configured columns then act as
+// rows below (rows are always the driven lines), and buttonIndex() maps back
+// Pushes edge events for each button with virtual pin scheme (NKRO: every key
+// goes through the device-wide InputEvents ring)
+// An event the ring has no room for is dropped and flags a resync: the main
+// loop then sends the whole matrix state (getReportedState()) to the host
+// Without diodes, three pressed keys in an L make the fourth corner read as
+// pressed too. Such matrices report once per frame instead of per row: keys
+// of a rectangle of pressed keys are ambiguous, and their new presses are
+// blocked until the rectangle breaks (a change in the blocked set also flags a
+// resync, so the host learns of it)
 class MatrixSensor : public ISensor {
 public:
     // Maximum matrix size (to avoid dynamic allocation)
@@ -18,58 +53,127 @@ public:
     // Virtual pin base (matrix buttons use pins 128+)
     static constexpr uint8_t VIRTUAL_PIN_BASE = 128;
 
-    // Default debounce threshold
-    static constexpr uint8_t DEFAULT_DEBOUNCE = 3;
+    // Default debounce time (ms) when Configure leaves it at 0
+    static constexpr uint8_t DEFAULT_DEBOUNCE_MS = 3;
 
-    // Event queue size for NKRO
-    static constexpr uint8_t EVENT_QUEUE_SIZE = 8;
+    // Default time for the columns to settle after a row is driven
+    static constexpr uint8_t DEFAULT_SETTLE_US = 10;
 
-private:
-    uint8_t num_rows;
-    uint8_t num_cols;
-    uint8_t row_pins[MAX_ROWS];
-    uint8_t col_pins[MAX_COLS];
+    // Scan all rows in every scan() call (rows_per_tick = 0)
+    static constexpr uint8_t ROWS_PER_TICK_ALL = 0;
+
+    // Diode direction (matches Protocol::MATRIX_DIODES_*)
+    static constexpr uint8_t DIODES_COL_TO_ROW = 0; // Cathodes on the rows: rows driven
+    static constexpr uint8_t DIODES_ROW_TO_COL = 1; // Cathodes on the columns: columns driven
+    static constexpr uint8_t DIODES_NONE = 2; // Either side works: the smaller one is driven
 
-    // Per-button state
-    bool current_state[MAX_BUTTONS];    // Debounced state (true = pressed)
-    bool last_reported[MAX_BUTTONS];    // Last reported state
-    uint8_t debounce_count[MAX_BUTTONS]; // Debounce counter per button
+    // Lockout setting that keeps integrated debouncing for that edge direction
+    static constexpr uint8_t LOCKOUT_OFF = 0;
 
-    // Event queue for NKRO support
-    struct PendingEvent {
-        uint8_t button_index;
-        bool pressed;
-    };
-    PendingEvent event_queue[EVENT_QUEUE_SIZE];
-    uint8_t queue_head;
-    uint8_t queue_tail;
+    // Keys that can always be pressed together without ghosting (MatrixState rollover)
+    static constexpr uint8_t ROLLOVER_NKRO = 0; // All of them (diodes)
+    static constexpr uint8_t ROLLOVER_NO_DIODES = 2; // Any 2; a third can complete a rectangle
 
-    // Debounce threshold
-    uint8_t debounce_threshold;
+private:
+    uint8_t num_rows; // Driven lines
+    uint8_t num_cols; // Sensed lines
+    uint8_t row_pins[MAX_ROWS];
+    uint8_t col_pins[MAX_COLS];
+    bool transposed; // Configured columns are driven (rows and cols swapped)
+    uint8_t settle_us; // Time from driving a row to reading its columns
+    uint8_t rows_per_scan; // Rows scanned per scan() call (a frame spans several calls)
+    uint8_t next_row; // First row of the next slice
+    bool anti_ghost; // No diodes: report per frame and block ghost rectangles
+
+#ifdef MATRIX_PORT_IO
+    // Port registers and bit masks (looked up by begin())
+    volatile MatrixPortValue* row_clear_reg[MAX_ROWS]; // Drives the row low
+    volatile MatrixPortValue* row_set_reg[MAX_ROWS]; // Drives the row high
+    MatrixPortValue row_mask[MAX_ROWS];
+    const volatile MatrixPortValue* col_port_reg[MAX_COLS]; // Distinct input registers of the columns
+    uint8_t num_col_ports;
+    uint8_t col_port[MAX_COLS]; // Index into col_port_reg per column
+    MatrixPortValue col_mask[MAX_COLS];
+    bool port_io; // False if a pin has no port (falls back to digitalRead())
+#endif
+
+    // Button state as one bit per column for each row (1 = pressed)
+    DebounceTiming timing; // Debounce time and lockouts
+    Debouncer debouncers[MAX_ROWS]; // Debounced state, one per row (counter per key)
+    uint8_t last_reported[MAX_ROWS]; // Last state reported (pushed, or left to a resync)
+    uint8_t frame_raw[MAX_ROWS]; // Raw reading of the current frame (anti-ghost only)
+    uint8_t blocked[MAX_ROWS]; // Pressed keys held back as possible ghosts
+    volatile bool resync_pending; // An event was dropped since the last takeResync()
 
 public:
     MatrixSensor(uint8_t rows, uint8_t cols,
-                 const uint8_t* row_pin_array, const uint8_t* col_pin_array);
+                 const uint8_t* row_pin_array, const uint8_t* col_pin_array,
+                 uint8_t settle_time_us = 0, uint8_t rows_per_tick = 0,
+                 uint8_t diode_direction = DIODES_COL_TO_ROW,
+                 uint8_t press_lockout = LOCKOUT_OFF, uint8_t release_lockout = LOCKOUT_OFF,
+                 uint8_t debounce_ms = 0);
 
     // ISensor interface implementation
     void begin() override;
     void scan() override;
-    Reading getReading() override;
     InputType getType() const override { return InputType::Matrix; }
+
+    // True if the last scan() finished a frame (all rows scanned)
+    bool frameComplete() const { return next_row == 0; }
+
+    // True if the configured columns are driven instead of the rows
+    bool isTransposed() const { return transposed; }
+
     uint8_t getPin() const override { return VIRTUAL_PIN_BASE; } // Base pin identifier
 
+    // True (once) if an event was dropped since the last call, so the host
+    // needs the full state; clears the flag
+    bool takeResync();
+
+    // Reported and blocked (possible ghost) keys as bitmaps by button index
+    // (bit i of byte i / 8 is virtual pin VIRTUAL_PIN_BASE + i, 1 = pressed)
+    // Returns the number of buttons; each bitmap must hold MAX_BUTTONS / 8 bytes
+    uint8_t getReportedState(uint8_t* pressed, uint8_t* blocked_keys) const;
+
+    // Keys that can always be pressed together (ROLLOVER_*)
+    uint8_t getRollover() const { return anti_ghost ? ROLLOVER_NO_DIODES : ROLLOVER_NKRO; }
+
 private:
-    // Scan a single button and handle debouncing
-    void scanButton(uint8_t row, uint8_t col, bool raw_pressed);
+#ifdef MATRIX_PORT_IO
+    // Look up the port registers and masks of all pins (false if a pin has none)
+    bool mapPorts();
+#endif
+
+    // Drive a row low (active) or high (inactive)
+    void setRowActive(uint8_t row, bool active);
+
+    // Wait until the active row has settled (time since it was driven counts)
+    void waitSettled(unsigned long driven_at) const;
+
+    // Read the columns of the active row (bit per column, 1 = pressed)
+    uint8_t readColumns() const;
+
+    // Debounce a row's columns at once and push the buttons that changed
+    // (anti-ghost: only debounce, reportFrame() pushes)
+    void debounceRow(uint8_t row, uint8_t raw_pressed, unsigned long now_us);
+
+    // Push the changes of a full frame, holding back keys of ghost rectangles
+    void reportFrame(unsigned long now_us);
+
+    // Push a button's new state; flags a resync if the ring is full
+    void pushButton(uint8_t row, uint8_t col, bool pressed, unsigned long now_us);
 
-    // Add event to queue
-    void enqueueEvent(uint8_t button_index, bool pressed);
+    // Set a bit per button index in bitmap for each set bit of rows[]
+    void fillBitmap(const uint8_t* rows, uint8_t* bitmap) const;
 
-    // Check if queue is empty
-    bool isQueueEmpty() const { return queue_head == queue_tail; }
+    // Reset debounced/reported state
+    void resetState();
 
-    // Get button index from row/col
-    uint8_t buttonIndex(uint8_t row, uint8_t col) const { return row * num_cols + col; }
+    // Get button index from row/col (configured order: row * configured columns + col)
+    uint8_t buttonIndex(uint8_t row, uint8_t col) const
+    {
+        return transposed ? col * num_rows + row : row * num_cols + col;
+    }
 
     // Get virtual pin for a button
     uint8_t virtualPin(uint8_t button_index) const { return VIRTUAL_PIN_BASE + button_index; }
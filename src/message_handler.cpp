@@ -1,7 +1,10 @@
 #include "message_handler.h"
 #include "config_manager.h"
 #include "heartbeat.h"
+#include "input_events.h"
 #include "output_manager.h"
+#include "power_manager.h"
+#include "profiler.h"
 #include "sensor_manager.h"
 
 namespace MessageHandler {
@@ -12,6 +15,9 @@ static PacketSerial_<COBS>* g_packet_serial = nullptr;
 // Heartbeat manager
 static Heartbeat::HeartbeatManager* g_heartbeat_manager = nullptr;
 
+// Main loop scheduler (missed deadlines for Stats)
+static Scheduler::TaskScheduler* g_scheduler = nullptr;
+
 // Template implementation - sends any protocol message and notifies heartbeat
 template <typename T>
 void sendMessage(const T& message)
@@ -20,6 +26,8 @@ void sendMessage(const T& message)
         return;
     }
 
+    PROFILE_PHASE(Profiler::PHASE_SEND);
+
     uint8_t buffer[128];
     size_t encoded_size = message.encode(buffer, sizeof(buffer));
 
@@ -33,9 +41,10 @@ void sendMessage(const T& message)
     }
 }
 
-void init(PacketSerial_<COBS>* serial)
+void init(PacketSerial_<COBS>* serial, Scheduler::TaskScheduler* scheduler)
 {
     g_packet_serial = serial;
+    g_scheduler = scheduler;
 
     // Initialize heartbeat manager with 2 second interval and callback
     g_heartbeat_manager = new Heartbeat::HeartbeatManager(HEARTBEAT_INTERVAL_MS, sendHeartbeat);
@@ -50,6 +59,9 @@ void onPacketReceived(const uint8_t* buffer, size_t size)
         return;
     }
 
+    // Host traffic keeps the device awake
+    PowerManager::notifyActivity(millis());
+
     // Handle different message types
     if (msg.isIdentityRequest()) {
         handleIdentityRequest(msg.identity_request.request_id);
@@ -57,27 +69,50 @@ void onPacketReceived(const uint8_t* buffer, size_t size)
         handleConfigure(msg.configure);
     } else if (msg.isSetOutput()) {
         handleSetOutput(msg.set_output);
+    } else if (msg.isGetStats()) {
+        handleGetStats(msg.get_stats);
+    } else if (msg.isCalibrate()) {
+        handleCalibrate(msg.calibrate);
     }
 }
 
 void update()
+{
+    // Check for sensor readings and send them
+    // (sensors are scanned by their own scheduler tasks)
+    PROFILE_PHASE(Profiler::PHASE_DRAIN);
+
+    Sensor::Reading reading;
+    while (InputEvents::pop(reading)) {
+        // Only real changes keep the device out of idle, not analog keepalives
+        if (!reading.keepalive) {
+            PowerManager::notifyActivity(millis());
+        }
+        sendInputValue(reading);
+    }
+
+    // A matrix that dropped events sends its full state. The ring is empty
+    // now, so no event older than this state can follow it.
+    for (uint8_t i = 0; i < SensorManager::getSensorCount(); i++) {
+        uint8_t input_index;
+        const Sensor::MatrixSensor* matrix = SensorManager::takeMatrixResync(i, input_index);
+        if (matrix != nullptr) {
+            sendMatrixState(input_index, *matrix);
+        }
+    }
+}
+
+void updateHeartbeat()
 {
     // Update heartbeat manager (automatically sends heartbeat if needed)
     g_heartbeat_manager->update(millis());
+}
 
-    // Check for configuration timeout
+void checkConfigTimeout()
+{
     if (ConfigManager::checkTimeout()) {
         sendConfigurationError(ConfigManager::g_config_state.getConfigId());
     }
-
-    // Scan all sensors
-    SensorManager::scan();
-
-    // Check for sensor readings and send them
-    Sensor::Reading reading;
-    while (SensorManager::getNextReading(reading)) {
-        sendInputValue(reading);
-    }
 }
 
 void handleIdentityRequest(uint32_t request_id)
@@ -110,6 +145,106 @@ void handleSetOutput(const Protocol::SetOutput& cmd)
     OutputManager::setOutput(cmd.pin, cmd.value);
 }
 
+void handleGetStats(const Protocol::GetStats& req)
+{
+    Protocol::Stats stats;
+    stats.loop_max_us = 0;
+    stats.num_phases = 0;
+    stats.num_sensors = 0;
+    stats.event_overflows = InputEvents::getOverflowCount();
+    stats.missed_deadlines = 0;
+    stats.first_sensor = req.first_sensor;
+    stats.total_sensors = 0;
+    if (g_scheduler) {
+        uint32_t missed = g_scheduler->getTotalMissedDeadlines();
+        stats.missed_deadlines = missed > 0xFFFF ? 0xFFFF : (uint16_t)missed;
+    }
+
+#ifdef ENABLE_PROFILER
+    Profiler::fillStats(stats, SensorManager::getSensorCount(), req.first_sensor);
+#endif
+
+    sendMessage(stats);
+
+    // Each query covers the time since the previous one; the pages of one
+    // query share its window, so only the last page starts a new one
+    if (stats.first_sensor + stats.num_sensors < stats.total_sensors) {
+        return;
+    }
+    if (g_scheduler) {
+        g_scheduler->resetMissedDeadlines();
+    }
+#ifdef ENABLE_PROFILER
+    Profiler::reset();
+#endif
+}
+
+void handleCalibrate(const Protocol::Calibrate& cmd)
+{
+    uint8_t status = Protocol::CALIBRATION_STATUS_OK;
+    bool found = false;
+    Sensor::Calibration cal;
+
+    switch (cmd.command) {
+    case Protocol::CALIBRATE_SET:
+        cal.flags = cmd.flags | Protocol::CALIBRATION_FLAG_VALID;
+        cal.min = cmd.min;
+        cal.max = cmd.max;
+        cal.center = cmd.center;
+        if (!cal.isValid()) {
+            found = SensorManager::getCalibration(cmd.input_index, cal);
+            status = Protocol::CALIBRATION_STATUS_INVALID_RANGE;
+            break;
+        }
+        found = SensorManager::setCalibration(cmd.input_index, cal);
+        if (found) {
+            ConfigManager::storeCalibration(cmd.input_index, cal);
+        }
+        break;
+
+    case Protocol::CALIBRATE_START_CAPTURE:
+        found = SensorManager::startCalibrationCapture(cmd.input_index);
+        if (found) {
+            SensorManager::getCalibration(cmd.input_index, cal);
+        }
+        break;
+
+    case Protocol::CALIBRATE_STOP_CAPTURE: {
+        bool captured = false;
+        found = SensorManager::stopCalibrationCapture(cmd.input_index, cmd.flags, captured);
+        if (found) {
+            SensorManager::getCalibration(cmd.input_index, cal);
+            if (captured) {
+                ConfigManager::storeCalibration(cmd.input_index, cal);
+            } else {
+                status = Protocol::CALIBRATION_STATUS_INVALID_RANGE;
+            }
+        }
+        break;
+    }
+
+    case Protocol::CALIBRATE_CLEAR:
+        found = SensorManager::setCalibration(cmd.input_index, cal);
+        if (found) {
+            ConfigManager::storeCalibration(cmd.input_index, cal);
+        }
+        break;
+
+    case Protocol::CALIBRATE_GET:
+        found = SensorManager::getCalibration(cmd.input_index, cal);
+        break;
+
+    default:
+        break;
+    }
+
+    if (!found) {
+        status = Protocol::CALIBRATION_STATUS_INVALID_INPUT;
+        cal = Sensor::Calibration();
+    }
+    sendCalibrationData(cmd.input_index, status, cal);
+}
+
 void sendIdentityResponse(uint32_t request_id, uint32_t config_id)
 {
     Protocol::IdentityResponse response;
@@ -143,10 +278,36 @@ void sendInputValue(const Sensor::Reading& reading)
     Protocol::InputValue input_value;
     input_value.pin = reading.pin;
     input_value.value = reading.value;
+    input_value.time_us = reading.time_us;
 
     sendMessage(input_value);
 }
 
+void sendCalibrationData(uint8_t input_index, uint8_t status, const Sensor::Calibration& cal)
+{
+    Protocol::CalibrationData data;
+    data.input_index = input_index;
+    data.status = status;
+    data.flags = cal.flags;
+    data.min = cal.min;
+    data.max = cal.max;
+    data.center = cal.center;
+
+    sendMessage(data);
+}
+
+static_assert(Sensor::MatrixSensor::MAX_BUTTONS <= Protocol::MAX_MATRIX_STATE_BUTTONS, "Matrix too large for MatrixState");
+
+void sendMatrixState(uint8_t input_index, const Sensor::MatrixSensor& matrix)
+{
+    Protocol::MatrixState state;
+    state.input_index = input_index;
+    state.rollover = matrix.getRollover();
+    state.num_buttons = matrix.getReportedState(state.pressed, state.blocked);
+
+    sendMessage(state);
+}
+
 void sendHeartbeat()
 {
     Protocol::Heartbeat heartbeat;
@@ -1,7 +1,10 @@
 #pragma once
 
+#include "calibration.h"
 #include "device_info.h"
+#include "matrix_sensor.h"
 #include "protocol.h"
+#include "scheduler.h"
 #include "sensor.h"
 #include <PacketSerial.h>
 #include <stdint.h>
@@ -12,18 +15,27 @@ namespace MessageHandler {
 constexpr unsigned long HEARTBEAT_INTERVAL_MS = 2000;
 
 // Initialize message handler
-void init(PacketSerial_<COBS>* serial);
+// scheduler: main loop scheduler whose missed deadlines are reported in Stats
+void init(PacketSerial_<COBS>* serial, Scheduler::TaskScheduler* scheduler);
 
 // Main packet received callback
 void onPacketReceived(const uint8_t* buffer, size_t size);
 
-// Update message handler (call in loop)
+// Send pending sensor readings (scheduled task)
 void update();
 
+// Update heartbeat manager - sends heartbeat when idle (scheduled task)
+void updateHeartbeat();
+
+// Check for configuration timeout - sends error on timeout (scheduled task)
+void checkConfigTimeout();
+
 // Message handlers for specific message types
 void handleIdentityRequest(uint32_t request_id);
 void handleConfigure(const Protocol::Configure& cfg);
 void handleSetOutput(const Protocol::SetOutput& cmd);
+void handleGetStats(const Protocol::GetStats& req);
+void handleCalibrate(const Protocol::Calibrate& cmd);
 
 // Internal helper - sends a message and notifies heartbeat manager
 // Template function to handle any protocol message type
@@ -36,5 +48,7 @@ void sendConfigurationStored(uint32_t config_id);
 void sendConfigurationError(uint32_t config_id);
 void sendInputValue(const Sensor::Reading& reading);
 void sendHeartbeat();
+void sendCalibrationData(uint8_t input_index, uint8_t status, const Sensor::Calibration& cal);
+void sendMatrixState(uint8_t input_index, const Sensor::MatrixSensor& matrix);
 
 } // namespace MessageHandler
@@ -0,0 +1,117 @@
+#include "notched_sensor.h"
+#include "adc_sequencer.h"
+#include "input_events.h"
+
+namespace Sensor {
+
+NotchedSensor::NotchedSensor(uint8_t pin_number, uint8_t hysteresis_counts, uint8_t button_pin_base,
+    const uint16_t* boundary_array, uint8_t boundary_count)
+    : pin(pin_number)
+    , hysteresis(hysteresis_counts)
+    , button_base(button_pin_base)
+    , num_boundaries(boundary_count < MAX_BOUNDARIES ? boundary_count : MAX_BOUNDARIES)
+    , filter(FilterType::Median3)
+    , notch(0)
+    , primed(false)
+    , last_send_ms(0)
+{
+    // Copy boundaries
+    for (uint8_t i = 0; i < num_boundaries; i++) {
+        boundaries[i] = boundary_array[i];
+    }
+}
+
+void NotchedSensor::begin()
+{
+    // No pinMode needed for analog inputs (see AnalogSensor::begin())
+
+    // Reset state
+    filter.reset();
+    notch = 0;
+    primed = false;
+    last_send_ms = 0;
+}
+
+void NotchedSensor::scan()
+{
+    uint16_t value = filter.update(readSample());
+
+    if (!primed) {
+        // First sample: report the notch the lever starts in
+        if (changeNotch(notchOf(value))) {
+            primed = true;
+        }
+        return;
+    }
+
+    // Only move once the value is past a boundary by the hysteresis,
+    // so a lever resting on a boundary doesn't chatter
+    uint8_t new_notch = notch;
+    while (new_notch < num_boundaries && value >= (uint32_t)boundaries[new_notch] + hysteresis) {
+        new_notch++;
+    }
+    while (new_notch > 0 && (uint32_t)value + hysteresis < boundaries[new_notch - 1]) {
+        new_notch--;
+    }
+
+    if (new_notch != notch) {
+        changeNotch(new_notch);
+        return;
+    }
+
+    // Lever at rest: resend the notch now and then, flagged as a keepalive so
+    // it doesn't count as activity; if the ring is full the next scan tries again
+    unsigned long now_ms = millis();
+    if (now_ms - last_send_ms >= KEEPALIVE_MS
+        && InputEvents::push(Reading(notch, InputType::Notched, pin, micros(), true))) {
+        last_send_ms = now_ms;
+    }
+}
+
+uint16_t NotchedSensor::readSample()
+{
+#ifdef ADC_SEQUENCER
+    // Latest background conversion; analogRead() if the pin isn't sequenced
+    uint16_t raw;
+    if (AdcSequencer::read(pin, raw)) {
+        return raw;
+    }
+#endif
+    return (uint16_t)analogRead(pin);
+}
+
+uint8_t NotchedSensor::notchOf(uint16_t value) const
+{
+    uint8_t n = 0;
+    while (n < num_boundaries && value >= boundaries[n]) {
+        n++;
+    }
+    return n;
+}
+
+bool NotchedSensor::changeNotch(uint8_t new_notch)
+{
+    // The virtual button release, press and notch index go out together, so
+    // the host never sees two notch buttons held or none
+    uint8_t events = 1;
+    if (button_base != 0) {
+        events += primed ? 2 : 1;
+    }
+    if (!InputEvents::hasRoom(events)) {
+        return false;
+    }
+
+    uint32_t now_us = micros();
+    if (button_base != 0) {
+        if (primed) {
+            InputEvents::push(Reading(0, InputType::Button, button_base + notch, now_us)); // Release old notch
+        }
+        InputEvents::push(Reading(1, InputType::Button, button_base + new_notch, now_us)); // Press new notch
+    }
+    InputEvents::push(Reading(new_notch, InputType::Notched, pin, now_us));
+    notch = new_notch;
+    last_send_ms = millis();
+    return true;
+}
+
+} // namespace Sensor
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "analog_filter.h"
+#include "sensor.h"
+#include <Arduino.h>
+
+namespace Sensor {
+
+// Notched analog sensor implementation (reverser, notched throttle)
+// Quantizes an analog lever into notches using host-supplied boundaries with
+// hysteresis, and reports notch index changes, plus the current notch as a
+// keepalive so a host that connects later learns where the lever rests
+// Optionally each notch also acts as a virtual button (pressed while the lever
+// is in that notch), so the host can bind notches like keys
+class NotchedSensor : public ISensor {
+public:
+    // Maximum number of boundaries (MAX_NOTCHES - 1)
+    static constexpr uint8_t MAX_BOUNDARIES = 11;
+    static constexpr uint8_t MAX_NOTCHES = MAX_BOUNDARIES + 1;
+
+    // Resend the notch after this long without a change
+    static constexpr uint16_t KEEPALIVE_MS = 2000;
+
+private:
+    uint8_t pin; // Arduino pin number
+    uint8_t hysteresis; // Raw counts past a boundary before the notch changes
+    uint8_t button_base; // Virtual pin of notch 0's button (0 = no virtual buttons)
+    uint8_t num_boundaries;
+    uint16_t boundaries[MAX_BOUNDARIES]; // Ascending raw values between notches
+
+    AnalogFilter filter; // Median-of-3 so a single spike can't flip a notch
+
+    // State
+    uint8_t notch; // Current notch index
+    bool primed; // False until the first sample picked a notch
+    unsigned long last_send_ms; // millis() of the last notch report
+
+public:
+    NotchedSensor(uint8_t pin_number, uint8_t hysteresis_counts, uint8_t button_pin_base,
+        const uint16_t* boundary_array, uint8_t boundary_count);
+
+    // ISensor interface implementation
+    void begin() override;
+    void scan() override;
+    InputType getType() const override { return InputType::Notched; }
+    uint8_t getPin() const override { return pin; }
+
+    // Get the current notch index
+    uint8_t getNotch() const { return notch; }
+
+private:
+    // Read one raw sample (0-1023)
+    uint16_t readSample();
+
+    // Notch of a value without hysteresis (used for the first sample)
+    uint8_t notchOf(uint16_t value) const;
+
+    // Move to a new notch and push its events (notch index and virtual buttons)
+    // Returns false if the ring can't take them all: nothing is pushed and the
+    // notch stays, so the next scan tries again
+    bool changeNotch(uint8_t new_notch);
+};
+
+} // namespace Sensor
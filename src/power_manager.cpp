@@ -0,0 +1,71 @@
+#include "power_manager.h"
+
+#if defined(__AVR__)
+#include <Arduino.h>
+#include <avr/sleep.h>
+#elif defined(ARDUINO_ARCH_SAM)
+#include <Arduino.h>
+#elif defined(ESP32_PLATFORM) || defined(ESP32)
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+namespace PowerManager {
+
+IdleTracker::IdleTracker(unsigned long timeout_ms)
+    : m_timeout_ms(timeout_ms)
+    , m_last_activity_time(0)
+{
+}
+
+void IdleTracker::notifyActivity(unsigned long timestamp)
+{
+    m_last_activity_time = timestamp;
+}
+
+bool IdleTracker::isIdle(unsigned long timestamp) const
+{
+    return (timestamp - m_last_activity_time) >= m_timeout_ms;
+}
+
+// Global idle tracker
+static IdleTracker g_idle_tracker(IDLE_TIMEOUT_MS);
+
+void notifyActivity(unsigned long timestamp)
+{
+    g_idle_tracker.notifyActivity(timestamp);
+}
+
+bool isIdle(unsigned long timestamp)
+{
+    return g_idle_tracker.isIdle(timestamp);
+}
+
+unsigned long taskPeriod(unsigned long active_period_us, bool idle)
+{
+    if (idle && active_period_us < IDLE_TASK_PERIOD_US) {
+        return IDLE_TASK_PERIOD_US;
+    }
+    return active_period_us;
+}
+
+void sleep(unsigned long max_us)
+{
+#if defined(__AVR__)
+    (void)max_us; // Any interrupt wakes it
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    sleep_mode(); // Enable, sleep, disable - returns after the waking ISR
+#elif defined(ARDUINO_ARCH_SAM)
+    (void)max_us; // Any interrupt wakes it
+    __WFI();
+#elif defined(ESP32_PLATFORM) || defined(ESP32)
+    // Light sleep would drop the UART bytes that wake it (corrupting the first
+    // COBS frame), so block until the next task release and let the idle task
+    // clock-gate the CPU; received bytes wait in the UART driver's buffer
+    TickType_t ticks = pdMS_TO_TICKS(max_us / 1000);
+    vTaskDelay(ticks > 0 ? ticks : 1);
+#endif
+}
+
+} // namespace PowerManager
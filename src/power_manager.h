@@ -0,0 +1,73 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace PowerManager {
+
+// Time without a reportable change before the device goes idle (30 seconds)
+constexpr unsigned long IDLE_TIMEOUT_MS = 30000;
+
+// Period of the scan, send and heartbeat tasks while idle (coarse checks).
+// Button edges and incoming bytes wake the MCU by interrupt and end idle, so
+// only inputs that can't interrupt (matrices, analog) wait for these polls
+constexpr unsigned long IDLE_TASK_PERIOD_US = 100000;
+
+/**
+ * Idle tracker - decides when the device is idle (no reportable input change
+ * and no host traffic for a while).
+ *
+ * Timestamps come from millis(), which keeps counting while the MCU sleeps,
+ * so the idle timeout and heartbeat timing stay correct across sleeps.
+ */
+class IdleTracker {
+public:
+    /**
+     * Constructor
+     * @param timeout_ms Time without activity before the device is idle
+     */
+    explicit IdleTracker(unsigned long timeout_ms);
+
+    /**
+     * Notify that something happened that must keep the device awake
+     * @param timestamp Current time in milliseconds (from millis())
+     */
+    void notifyActivity(unsigned long timestamp);
+
+    /**
+     * Check if the device is idle
+     * @param timestamp Current time in milliseconds (from millis())
+     * @return true if there was no activity for at least the timeout
+     */
+    bool isIdle(unsigned long timestamp) const;
+
+    /**
+     * Get the configured idle timeout
+     * @return Idle timeout in milliseconds
+     */
+    unsigned long getTimeout() const { return m_timeout_ms; }
+
+private:
+    unsigned long m_timeout_ms;
+    unsigned long m_last_activity_time;
+};
+
+// Record activity on the global idle tracker (reportable change, host message)
+void notifyActivity(unsigned long timestamp);
+
+// Check the global idle tracker
+bool isIdle(unsigned long timestamp);
+
+// Period of a task: its active period, or IDLE_TASK_PERIOD_US while idle
+// (a task that is already slower keeps its own period)
+unsigned long taskPeriod(unsigned long active_period_us, bool idle);
+
+// Sleep until the next interrupt, or at most max_us (time until the next task release)
+//   AVR:   SLEEP_MODE_IDLE - timers, USB/UART and pin change interrupts wake it
+//          (the millis() tick wakes it briefly every ~1 ms; the loop finds
+//          nothing due and sleeps again)
+//   SAM:   WFI - SysTick and peripheral interrupts wake it (same ~1 ms tick)
+//   ESP32: blocks the loop task for max_us (at least one RTOS tick) so the
+//          idle task can wait for interrupt
+void sleep(unsigned long max_us);
+
+} // namespace PowerManager
@@ -0,0 +1,187 @@
+#include "profiler.h"
+
+#ifdef ENABLE_PROFILER
+#include <Arduino.h>
+
+#if defined(ESP32_PLATFORM) || defined(ESP32)
+#include <freertos/FreeRTOS.h>
+#endif
+#endif
+
+namespace Profiler {
+
+PhaseStats::PhaseStats()
+{
+    reset();
+}
+
+void PhaseStats::add(uint32_t duration_us)
+{
+    if (m_count == 0 || duration_us < m_min_us) {
+        m_min_us = duration_us;
+    }
+    if (duration_us > m_max_us) {
+        m_max_us = duration_us;
+    }
+
+    // Stop accumulating once the counter saturates (keeps the average valid)
+    if (m_count < 0xFFFF) {
+        m_total_us += duration_us;
+        m_count++;
+    }
+}
+
+void PhaseStats::reset()
+{
+    m_min_us = 0;
+    m_max_us = 0;
+    m_total_us = 0;
+    m_count = 0;
+}
+
+static uint16_t saturate16(uint32_t value)
+{
+    return value > 0xFFFF ? 0xFFFF : (uint16_t)value;
+}
+
+Protocol::StatsEntry PhaseStats::toEntry() const
+{
+    Protocol::StatsEntry entry;
+    entry.min_us = saturate16(m_min_us);
+    entry.avg_us = m_count > 0 ? saturate16(m_total_us / m_count) : 0;
+    entry.max_us = saturate16(m_max_us);
+    entry.count = m_count;
+    return entry;
+}
+
+#ifdef ENABLE_PROFILER
+
+// Scan samples are recorded from SensorManager::sample(), which may run in the
+// sampling interrupt or (ESP32) another task, while fillStats() and reset()
+// run in the main loop
+#if defined(ESP32_PLATFORM) || defined(ESP32)
+// The sampling task may run on the other core: a spinlock guards both sides
+static portMUX_TYPE g_profiler_mux = portMUX_INITIALIZER_UNLOCKED;
+#define PROFILER_LOCK() portENTER_CRITICAL(&g_profiler_mux)
+#define PROFILER_UNLOCK() portEXIT_CRITICAL(&g_profiler_mux)
+#define PROFILER_RECORD_LOCK() portENTER_CRITICAL(&g_profiler_mux)
+#define PROFILER_RECORD_UNLOCK() portEXIT_CRITICAL(&g_profiler_mux)
+#else
+// Single core - the main loop masks the sampling interrupt while it reads; the
+// interrupt's own records can't be interrupted by the main loop
+#define PROFILER_LOCK() noInterrupts()
+#define PROFILER_UNLOCK() interrupts()
+#define PROFILER_RECORD_LOCK() ((void)0)
+#define PROFILER_RECORD_UNLOCK() ((void)0)
+#endif
+
+static PhaseStats g_phases[PHASE_COUNT];
+static PhaseStats g_sensors[Protocol::MAX_STATS_SENSORS];
+static uint32_t g_loop_max_us = 0;
+static unsigned long g_last_loop_us = 0;
+static bool g_loop_started = false;
+
+void recordPhase(Phase phase, uint32_t duration_us)
+{
+    if (phase < PHASE_COUNT) {
+        PROFILER_RECORD_LOCK();
+        g_phases[phase].add(duration_us);
+        PROFILER_RECORD_UNLOCK();
+    }
+}
+
+void recordSensor(uint8_t index, uint32_t duration_us)
+{
+    if (index < Protocol::MAX_STATS_SENSORS) {
+        PROFILER_RECORD_LOCK();
+        g_sensors[index].add(duration_us);
+        PROFILER_RECORD_UNLOCK();
+    }
+}
+
+void markLoop(unsigned long timestamp_us)
+{
+    if (g_loop_started) {
+        uint32_t period = timestamp_us - g_last_loop_us;
+        if (period > g_loop_max_us) {
+            g_loop_max_us = period;
+        }
+    }
+    g_last_loop_us = timestamp_us;
+    g_loop_started = true;
+}
+
+// Copy one accumulator consistently; the entry is computed from the copy
+// outside the lock, so interrupts are only held off for a few bytes
+static Protocol::StatsEntry snapshot(const PhaseStats& stats)
+{
+    PROFILER_LOCK();
+    PhaseStats copy = stats;
+    PROFILER_UNLOCK();
+    return copy.toEntry();
+}
+
+void fillStats(Protocol::Stats& stats, uint8_t num_sensors, uint8_t first_sensor)
+{
+    if (num_sensors > Protocol::MAX_STATS_SENSORS) {
+        num_sensors = Protocol::MAX_STATS_SENSORS;
+    }
+    stats.first_sensor = first_sensor;
+    stats.total_sensors = num_sensors;
+    uint8_t page = first_sensor < num_sensors ? num_sensors - first_sensor : 0;
+    if (page > Protocol::MAX_STATS_SENSORS_PER_MESSAGE) {
+        page = Protocol::MAX_STATS_SENSORS_PER_MESSAGE;
+    }
+
+    stats.loop_max_us = g_loop_max_us;
+    stats.num_phases = PHASE_COUNT;
+    for (uint8_t i = 0; i < PHASE_COUNT; i++) {
+        stats.phases[i] = snapshot(g_phases[i]);
+    }
+    stats.num_sensors = page;
+    for (uint8_t i = 0; i < page; i++) {
+        stats.sensors[i] = snapshot(g_sensors[first_sensor + i]);
+    }
+}
+
+void reset()
+{
+    PROFILER_LOCK();
+    for (uint8_t i = 0; i < PHASE_COUNT; i++) {
+        g_phases[i].reset();
+    }
+    for (uint8_t i = 0; i < Protocol::MAX_STATS_SENSORS; i++) {
+        g_sensors[i].reset();
+    }
+    PROFILER_UNLOCK();
+    g_loop_max_us = 0;
+    g_loop_started = false; // Don't count the time spent answering the query
+}
+
+Scope::Scope(Phase phase)
+    : m_start_us(micros())
+    , m_index(phase)
+    , m_is_sensor(false)
+{
+}
+
+Scope::Scope(uint8_t sensor_index, bool is_sensor)
+    : m_start_us(micros())
+    , m_index(sensor_index)
+    , m_is_sensor(is_sensor)
+{
+}
+
+Scope::~Scope()
+{
+    uint32_t duration = micros() - m_start_us;
+    if (m_is_sensor) {
+        recordSensor(m_index, duration);
+    } else {
+        recordPhase((Phase)m_index, duration);
+    }
+}
+
+#endif // ENABLE_PROFILER
+
+} // namespace Profiler
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "protocol.h"
+#include <stdint.h>
+
+// Loop profiler - records min/avg/max time per loop phase and per sensor scan,
+// plus the worst loop period. Enable with -D ENABLE_PROFILER in build_flags.
+// Without the flag the PROFILE_* macros expand to nothing (zero cost) and
+// GetStats is answered with an empty Stats message.
+
+namespace Profiler {
+
+// Profiled loop phases (index into Stats::phases)
+enum Phase : uint8_t {
+    PHASE_SERIAL_RX = 0, // PacketSerial::update() (includes packet handling)
+    PHASE_SCAN = 1, // SensorManager::scan() - all sensors of one scan task
+    PHASE_DRAIN = 2, // InputEvents drain loop (includes sends)
+    PHASE_SEND = 3, // sendMessage() - encode and write one message
+    PHASE_COUNT = 4
+};
+
+static_assert(PHASE_COUNT <= Protocol::MAX_STATS_PHASES, "Too many profiler phases for Stats");
+
+// Accumulates duration samples for one phase or sensor
+class PhaseStats {
+public:
+    PhaseStats();
+
+    // Add a duration sample in microseconds
+    void add(uint32_t duration_us);
+
+    // Clear all samples
+    void reset();
+
+    // Convert to a protocol entry (values saturated to 16 bits)
+    Protocol::StatsEntry toEntry() const;
+
+private:
+    uint32_t m_min_us;
+    uint32_t m_max_us;
+    uint32_t m_total_us;
+    uint16_t m_count;
+};
+
+#ifdef ENABLE_PROFILER
+
+// Record a phase duration
+void recordPhase(Phase phase, uint32_t duration_us);
+
+// Record the scan duration of the sensor at the given index
+void recordSensor(uint8_t index, uint32_t duration_us);
+
+// Mark the start of a loop iteration (tracks the worst loop period)
+void markLoop(unsigned long timestamp_us);
+
+// Fill a Stats message with everything recorded since the last reset, with
+// the sensor entries from first_sensor on (one page)
+void fillStats(Protocol::Stats& stats, uint8_t num_sensors, uint8_t first_sensor = 0);
+
+// Clear all recorded statistics
+void reset();
+
+// Records the time from construction to end of scope as a phase or sensor sample
+class Scope {
+public:
+    explicit Scope(Phase phase);
+    Scope(uint8_t sensor_index, bool is_sensor);
+    ~Scope();
+
+private:
+    unsigned long m_start_us;
+    uint8_t m_index;
+    bool m_is_sensor;
+};
+
+#define PROFILE_PHASE(phase) Profiler::Scope _profile_phase_scope(phase)
+#define PROFILE_SENSOR(index) Profiler::Scope _profile_sensor_scope((index), true)
+#define PROFILE_LOOP(timestamp_us) Profiler::markLoop(timestamp_us)
+
+#else
+
+#define PROFILE_PHASE(phase) ((void)0)
+#define PROFILE_SENSOR(index) ((void)0)
+#define PROFILE_LOOP(timestamp_us) ((void)0)
+
+#endif // ENABLE_PROFILER
+
+} // namespace Profiler
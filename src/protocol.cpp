@@ -131,13 +131,22 @@ size_t Configure::encode(uint8_t* buffer, size_t buffer_size) const
     size_t payload_size = 0;
     switch (input_type) {
     case INPUT_TYPE_ANALOG:
-        payload_size = 2; // pin + sensitivity
+        payload_size = 10; // pin + sensitivity + filter (3) + oversample bits + deadband + hysteresis + jump + keepalive
         break;
     case INPUT_TYPE_BUTTON:
-        payload_size = 2; // pin + debounce
+        payload_size = 4; // pin + debounce + lockouts
         break;
     case INPUT_TYPE_MATRIX:
-        payload_size = 2 + matrix.num_row_pins + matrix.num_col_pins; // counts + pins
+        payload_size = 8 + matrix.num_row_pins + matrix.num_col_pins; // counts + pins + settle time + rows per tick + diodes + lockouts + debounce
+        break;
+    case INPUT_TYPE_NOTCHED:
+        if (notched.num_boundaries > MAX_NOTCH_BOUNDARIES) {
+            return 0; // Too many boundaries
+        }
+        payload_size = 4 + notched.num_boundaries * 2; // pin + hysteresis + button base + count + boundaries
+        break;
+    case INPUT_TYPE_ENCODER:
+        payload_size = 4; // pins + steps per detent + acceleration
         break;
     default:
         return 0; // Unknown input type
@@ -173,11 +182,21 @@ size_t Configure::encode(uint8_t* buffer, size_t buffer_size) const
     case INPUT_TYPE_ANALOG:
         buffer[offset++] = analog.pin;
         buffer[offset++] = analog.sensitivity;
+        buffer[offset++] = analog.filter_type;
+        buffer[offset++] = analog.filter_param1;
+        buffer[offset++] = analog.filter_param2;
+        buffer[offset++] = analog.oversample_bits;
+        buffer[offset++] = analog.deadband;
+        buffer[offset++] = analog.hysteresis;
+        buffer[offset++] = analog.jump;
+        buffer[offset++] = analog.keepalive;
         break;
 
     case INPUT_TYPE_BUTTON:
         buffer[offset++] = button.pin;
         buffer[offset++] = button.debounce;
+        buffer[offset++] = button.press_lockout;
+        buffer[offset++] = button.release_lockout;
         break;
 
     case INPUT_TYPE_MATRIX:
@@ -186,6 +205,31 @@ size_t Configure::encode(uint8_t* buffer, size_t buffer_size) const
         for (uint8_t i = 0; i < matrix.num_row_pins + matrix.num_col_pins; i++) {
             buffer[offset++] = matrix.pins[i];
         }
+        buffer[offset++] = matrix.settle_us;
+        buffer[offset++] = matrix.rows_per_tick;
+        buffer[offset++] = matrix.diode_direction;
+        buffer[offset++] = matrix.press_lockout;
+        buffer[offset++] = matrix.release_lockout;
+        buffer[offset++] = matrix.debounce;
+        break;
+
+    case INPUT_TYPE_NOTCHED:
+        buffer[offset++] = notched.pin;
+        buffer[offset++] = notched.hysteresis;
+        buffer[offset++] = notched.button_base;
+        buffer[offset++] = notched.num_boundaries;
+        for (uint8_t i = 0; i < notched.num_boundaries; i++) {
+            // boundary (u16) - little endian
+            buffer[offset++] = (notched.boundaries[i] >> 0) & 0xFF;
+            buffer[offset++] = (notched.boundaries[i] >> 8) & 0xFF;
+        }
+        break;
+
+    case INPUT_TYPE_ENCODER:
+        buffer[offset++] = encoder.pin_a;
+        buffer[offset++] = encoder.pin_b;
+        buffer[offset++] = encoder.steps_per_detent;
+        buffer[offset++] = encoder.acceleration;
         break;
     }
 
@@ -228,6 +272,36 @@ bool Configure::decode(const uint8_t* buffer, size_t length)
         }
         analog.pin = buffer[offset++];
         analog.sensitivity = buffer[offset++];
+
+        // Trailing fields are optional (older hosts send only pin + sensitivity)
+        analog.filter_type = ANALOG_FILTER_NONE;
+        analog.filter_param1 = 0;
+        analog.filter_param2 = 0;
+        analog.oversample_bits = 0;
+        analog.deadband = ANALOG_DEADBAND_DEFAULT;
+        analog.hysteresis = 0;
+        analog.jump = ANALOG_JUMP_DEFAULT;
+        analog.keepalive = 0;
+        if (length >= HEADER_SIZE + 5) {
+            analog.filter_type = buffer[offset++];
+            analog.filter_param1 = buffer[offset++];
+            analog.filter_param2 = buffer[offset++];
+        }
+        if (length >= HEADER_SIZE + 6) {
+            analog.oversample_bits = buffer[offset++];
+        }
+        if (length >= HEADER_SIZE + 7) {
+            analog.deadband = buffer[offset++];
+        }
+        if (length >= HEADER_SIZE + 8) {
+            analog.hysteresis = buffer[offset++];
+        }
+        if (length >= HEADER_SIZE + 9) {
+            analog.jump = buffer[offset++];
+        }
+        if (length >= HEADER_SIZE + 10) {
+            analog.keepalive = buffer[offset++];
+        }
         break;
 
     case INPUT_TYPE_BUTTON:
@@ -236,6 +310,16 @@ bool Configure::decode(const uint8_t* buffer, size_t length)
         }
         button.pin = buffer[offset++];
         button.debounce = buffer[offset++];
+
+        // Lockouts are optional (older hosts send only pin + debounce)
+        button.press_lockout = DEBOUNCE_LOCKOUT_OFF;
+        button.release_lockout = DEBOUNCE_LOCKOUT_OFF;
+        if (length >= HEADER_SIZE + 3) {
+            button.press_lockout = buffer[offset++];
+        }
+        if (length >= HEADER_SIZE + 4) {
+            button.release_lockout = buffer[offset++];
+        }
         break;
 
     case INPUT_TYPE_MATRIX: {
@@ -255,9 +339,76 @@ bool Configure::decode(const uint8_t* buffer, size_t length)
         for (uint8_t i = 0; i < total_pins; i++) {
             matrix.pins[i] = buffer[offset++];
         }
+
+        // Trailing fields are optional (older hosts send only the pins)
+        matrix.settle_us = MATRIX_SETTLE_DEFAULT;
+        matrix.rows_per_tick = MATRIX_ROWS_PER_TICK_ALL;
+        matrix.diode_direction = MATRIX_DIODES_COL_TO_ROW;
+        matrix.press_lockout = DEBOUNCE_LOCKOUT_OFF;
+        matrix.release_lockout = DEBOUNCE_LOCKOUT_OFF;
+        matrix.debounce = MATRIX_DEBOUNCE_DEFAULT;
+        if (length >= HEADER_SIZE + 3 + total_pins) {
+            matrix.settle_us = buffer[offset++];
+        }
+        if (length >= HEADER_SIZE + 4 + total_pins) {
+            matrix.rows_per_tick = buffer[offset++];
+        }
+        if (length >= HEADER_SIZE + 5 + total_pins) {
+            matrix.diode_direction = buffer[offset++];
+        }
+        if (length >= HEADER_SIZE + 6 + total_pins) {
+            matrix.press_lockout = buffer[offset++];
+        }
+        if (length >= HEADER_SIZE + 7 + total_pins) {
+            matrix.release_lockout = buffer[offset++];
+        }
+        if (length >= HEADER_SIZE + 8 + total_pins) {
+            matrix.debounce = buffer[offset++];
+        }
+        break;
+    }
+
+    case INPUT_TYPE_NOTCHED: {
+        if (length < HEADER_SIZE + 4) {
+            return false; // Not enough data for notched header
+        }
+        notched.pin = buffer[offset++];
+        notched.hysteresis = buffer[offset++];
+        notched.button_base = buffer[offset++];
+        notched.num_boundaries = buffer[offset++];
+
+        if (notched.num_boundaries > MAX_NOTCH_BOUNDARIES) {
+            return false; // Too many boundaries
+        }
+        if (length < HEADER_SIZE + 4 + (size_t)notched.num_boundaries * 2) {
+            return false; // Not enough data for boundaries
+        }
+        for (uint8_t i = 0; i < notched.num_boundaries; i++) {
+            // boundary (u16) - little endian
+            notched.boundaries[i] = ((uint16_t)buffer[offset + 0] << 0) | ((uint16_t)buffer[offset + 1] << 8);
+            offset += 2;
+        }
         break;
     }
 
+    case INPUT_TYPE_ENCODER:
+        if (length < HEADER_SIZE + 2) {
+            return false; // Not enough data for encoder pins
+        }
+        encoder.pin_a = buffer[offset++];
+        encoder.pin_b = buffer[offset++];
+
+        // Trailing fields are optional
+        encoder.steps_per_detent = ENCODER_STEPS_DEFAULT;
+        encoder.acceleration = ENCODER_ACCEL_OFF;
+        if (length >= HEADER_SIZE + 3) {
+            encoder.steps_per_detent = buffer[offset++];
+        }
+        if (length >= HEADER_SIZE + 4) {
+            encoder.acceleration = buffer[offset++];
+        }
+        break;
+
     default:
         return false; // Unknown input type
     }
@@ -357,7 +508,7 @@ bool ConfigurationError::decode(const uint8_t* buffer, size_t length)
 
 size_t InputValue::encode(uint8_t* buffer, size_t buffer_size) const
 {
-    constexpr size_t REQUIRED_SIZE = 4;
+    constexpr size_t REQUIRED_SIZE = 8;
 
     if (buffer_size < REQUIRED_SIZE) {
         return 0; // Buffer too small
@@ -375,6 +526,12 @@ size_t InputValue::encode(uint8_t* buffer, size_t buffer_size) const
     buffer[offset++] = (value >> 0) & 0xFF;
     buffer[offset++] = (value >> 8) & 0xFF;
 
+    // time_us (u32) - little endian
+    buffer[offset++] = (time_us >> 0) & 0xFF;
+    buffer[offset++] = (time_us >> 8) & 0xFF;
+    buffer[offset++] = (time_us >> 16) & 0xFF;
+    buffer[offset++] = (time_us >> 24) & 0xFF;
+
     return offset;
 }
 
@@ -397,6 +554,13 @@ bool InputValue::decode(const uint8_t* buffer, size_t length)
 
     // value (i16) - little endian
     value = (int16_t)(((uint16_t)buffer[offset + 0] << 0) | ((uint16_t)buffer[offset + 1] << 8));
+    offset += 2;
+
+    // time_us (u32) - little endian (optional, older firmware doesn't send it)
+    time_us = 0;
+    if (length >= offset + 4) {
+        time_us = ((uint32_t)buffer[offset + 0] << 0) | ((uint32_t)buffer[offset + 1] << 8) | ((uint32_t)buffer[offset + 2] << 16) | ((uint32_t)buffer[offset + 3] << 24);
+    }
 
     return true;
 }
@@ -478,6 +642,345 @@ bool SetOutput::decode(const uint8_t* buffer, size_t length)
     return true;
 }
 
+// GetStats implementation
+
+size_t GetStats::encode(uint8_t* buffer, size_t buffer_size) const
+{
+    constexpr size_t REQUIRED_SIZE = 2; // 1 type + 1 first_sensor
+
+    if (buffer_size < REQUIRED_SIZE) {
+        return 0; // Buffer too small
+    }
+
+    buffer[0] = MESSAGE_TYPE_GET_STATS;
+    buffer[1] = first_sensor;
+
+    return REQUIRED_SIZE;
+}
+
+bool GetStats::decode(const uint8_t* buffer, size_t length)
+{
+    constexpr size_t REQUIRED_SIZE = 1;
+
+    if (length < REQUIRED_SIZE) {
+        return false; // Not enough data
+    }
+
+    if (buffer[0] != MESSAGE_TYPE_GET_STATS) {
+        return false; // Wrong message type
+    }
+
+    // first_sensor (u8) - optional, older hosts only send the type
+    first_sensor = length >= 2 ? buffer[1] : 0;
+
+    return true;
+}
+
+// Stats implementation
+
+size_t Stats::encode(uint8_t* buffer, size_t buffer_size) const
+{
+    // 1 type + 4 loop_max_us + 1 num_phases + 1 num_sensors + 8 bytes per entry + 2 event_overflows + 2 missed_deadlines
+    // + 1 first_sensor + 1 total_sensors
+    constexpr size_t ENTRY_SIZE = 8;
+
+    if (num_phases > MAX_STATS_PHASES || num_sensors > MAX_STATS_SENSORS_PER_MESSAGE) {
+        return 0; // Invalid entry count
+    }
+
+    size_t required_size = 13 + (num_phases + num_sensors) * ENTRY_SIZE;
+    if (buffer_size < required_size) {
+        return 0; // Buffer too small
+    }
+
+    size_t offset = 0;
+
+    // Message type (u8)
+    buffer[offset++] = MESSAGE_TYPE_STATS;
+
+    // loop_max_us (u32) - little endian
+    buffer[offset++] = (loop_max_us >> 0) & 0xFF;
+    buffer[offset++] = (loop_max_us >> 8) & 0xFF;
+    buffer[offset++] = (loop_max_us >> 16) & 0xFF;
+    buffer[offset++] = (loop_max_us >> 24) & 0xFF;
+
+    // Phases, then sensors: count (u8) followed by entries
+    for (uint8_t list = 0; list < 2; list++) {
+        uint8_t count = list == 0 ? num_phases : num_sensors;
+        const StatsEntry* entries = list == 0 ? phases : sensors;
+
+        buffer[offset++] = count;
+        for (uint8_t i = 0; i < count; i++) {
+            // min_us, avg_us, max_us, count (u16 each) - little endian
+            const uint16_t fields[4] = { entries[i].min_us, entries[i].avg_us, entries[i].max_us, entries[i].count };
+            for (uint8_t f = 0; f < 4; f++) {
+                buffer[offset++] = (fields[f] >> 0) & 0xFF;
+                buffer[offset++] = (fields[f] >> 8) & 0xFF;
+            }
+        }
+    }
+
+    // event_overflows (u16) - little endian
+    buffer[offset++] = (event_overflows >> 0) & 0xFF;
+    buffer[offset++] = (event_overflows >> 8) & 0xFF;
+
+    // missed_deadlines (u16) - little endian
+    buffer[offset++] = (missed_deadlines >> 0) & 0xFF;
+    buffer[offset++] = (missed_deadlines >> 8) & 0xFF;
+
+    // Sensor page (u8 each)
+    buffer[offset++] = first_sensor;
+    buffer[offset++] = total_sensors;
+
+    return offset;
+}
+
+bool Stats::decode(const uint8_t* buffer, size_t length)
+{
+    constexpr size_t ENTRY_SIZE = 8;
+
+    if (length < 7) {
+        return false; // Not enough data for header and counts
+    }
+
+    if (buffer[0] != MESSAGE_TYPE_STATS) {
+        return false; // Wrong message type
+    }
+
+    size_t offset = 1;
+
+    // loop_max_us (u32) - little endian
+    loop_max_us = ((uint32_t)buffer[offset + 0] << 0) | ((uint32_t)buffer[offset + 1] << 8) | ((uint32_t)buffer[offset + 2] << 16) | ((uint32_t)buffer[offset + 3] << 24);
+    offset += 4;
+
+    // Phases, then sensors
+    for (uint8_t list = 0; list < 2; list++) {
+        if (length < offset + 1) {
+            return false; // Missing count
+        }
+        uint8_t count = buffer[offset++];
+        uint8_t max_count = list == 0 ? MAX_STATS_PHASES : MAX_STATS_SENSORS_PER_MESSAGE;
+        if (count > max_count) {
+            return false; // Too many entries
+        }
+        if (length < offset + count * ENTRY_SIZE) {
+            return false; // Not enough data for entries
+        }
+
+        StatsEntry* entries = list == 0 ? phases : sensors;
+        for (uint8_t i = 0; i < count; i++) {
+            uint16_t fields[4];
+            for (uint8_t f = 0; f < 4; f++) {
+                fields[f] = (uint16_t)(((uint16_t)buffer[offset + 0] << 0) | ((uint16_t)buffer[offset + 1] << 8));
+                offset += 2;
+            }
+            entries[i].min_us = fields[0];
+            entries[i].avg_us = fields[1];
+            entries[i].max_us = fields[2];
+            entries[i].count = fields[3];
+        }
+
+        if (list == 0) {
+            num_phases = count;
+        } else {
+            num_sensors = count;
+        }
+    }
+
+    // event_overflows (u16) - little endian (optional, older firmware doesn't send it)
+    event_overflows = 0;
+    if (length >= offset + 2) {
+        event_overflows = (uint16_t)(((uint16_t)buffer[offset + 0] << 0) | ((uint16_t)buffer[offset + 1] << 8));
+        offset += 2;
+    }
+
+    // missed_deadlines (u16) - little endian (optional, older firmware doesn't send it)
+    missed_deadlines = 0;
+    if (length >= offset + 2) {
+        missed_deadlines = (uint16_t)(((uint16_t)buffer[offset + 0] << 0) | ((uint16_t)buffer[offset + 1] << 8));
+        offset += 2;
+    }
+
+    // first_sensor, total_sensors (u8) - optional, without them the page holds every sensor
+    first_sensor = 0;
+    total_sensors = num_sensors;
+    if (length >= offset + 2) {
+        first_sensor = buffer[offset + 0];
+        total_sensors = buffer[offset + 1];
+    }
+
+    return true;
+}
+
+// Calibrate implementation
+
+size_t Calibrate::encode(uint8_t* buffer, size_t buffer_size) const
+{
+    constexpr size_t REQUIRED_SIZE = 10; // 1 type + 3 u8 + 3 u16
+
+    if (buffer_size < REQUIRED_SIZE) {
+        return 0; // Buffer too small
+    }
+
+    size_t offset = 0;
+
+    buffer[offset++] = MESSAGE_TYPE_CALIBRATE;
+    buffer[offset++] = input_index;
+    buffer[offset++] = command;
+    buffer[offset++] = flags;
+
+    // min, max, center (u16) - little endian
+    buffer[offset++] = (min >> 0) & 0xFF;
+    buffer[offset++] = (min >> 8) & 0xFF;
+    buffer[offset++] = (max >> 0) & 0xFF;
+    buffer[offset++] = (max >> 8) & 0xFF;
+    buffer[offset++] = (center >> 0) & 0xFF;
+    buffer[offset++] = (center >> 8) & 0xFF;
+
+    return offset;
+}
+
+bool Calibrate::decode(const uint8_t* buffer, size_t length)
+{
+    constexpr size_t REQUIRED_SIZE = 10;
+
+    if (length < REQUIRED_SIZE) {
+        return false; // Not enough data
+    }
+
+    if (buffer[0] != MESSAGE_TYPE_CALIBRATE) {
+        return false; // Wrong message type
+    }
+
+    input_index = buffer[1];
+    command = buffer[2];
+    flags = buffer[3];
+
+    // min, max, center (u16) - little endian
+    min = (uint16_t)(((uint16_t)buffer[4] << 0) | ((uint16_t)buffer[5] << 8));
+    max = (uint16_t)(((uint16_t)buffer[6] << 0) | ((uint16_t)buffer[7] << 8));
+    center = (uint16_t)(((uint16_t)buffer[8] << 0) | ((uint16_t)buffer[9] << 8));
+
+    return true;
+}
+
+// CalibrationData implementation
+
+size_t CalibrationData::encode(uint8_t* buffer, size_t buffer_size) const
+{
+    constexpr size_t REQUIRED_SIZE = 10; // 1 type + 3 u8 + 3 u16
+
+    if (buffer_size < REQUIRED_SIZE) {
+        return 0; // Buffer too small
+    }
+
+    size_t offset = 0;
+
+    buffer[offset++] = MESSAGE_TYPE_CALIBRATION_DATA;
+    buffer[offset++] = input_index;
+    buffer[offset++] = status;
+    buffer[offset++] = flags;
+
+    // min, max, center (u16) - little endian
+    buffer[offset++] = (min >> 0) & 0xFF;
+    buffer[offset++] = (min >> 8) & 0xFF;
+    buffer[offset++] = (max >> 0) & 0xFF;
+    buffer[offset++] = (max >> 8) & 0xFF;
+    buffer[offset++] = (center >> 0) & 0xFF;
+    buffer[offset++] = (center >> 8) & 0xFF;
+
+    return offset;
+}
+
+bool CalibrationData::decode(const uint8_t* buffer, size_t length)
+{
+    constexpr size_t REQUIRED_SIZE = 10;
+
+    if (length < REQUIRED_SIZE) {
+        return false; // Not enough data
+    }
+
+    if (buffer[0] != MESSAGE_TYPE_CALIBRATION_DATA) {
+        return false; // Wrong message type
+    }
+
+    input_index = buffer[1];
+    status = buffer[2];
+    flags = buffer[3];
+
+    // min, max, center (u16) - little endian
+    min = (uint16_t)(((uint16_t)buffer[4] << 0) | ((uint16_t)buffer[5] << 8));
+    max = (uint16_t)(((uint16_t)buffer[6] << 0) | ((uint16_t)buffer[7] << 8));
+    center = (uint16_t)(((uint16_t)buffer[8] << 0) | ((uint16_t)buffer[9] << 8));
+
+    return true;
+}
+
+// MatrixState implementation
+
+size_t MatrixState::encode(uint8_t* buffer, size_t buffer_size) const
+{
+    if (num_buttons > MAX_MATRIX_STATE_BUTTONS) {
+        return 0; // Too many buttons
+    }
+
+    size_t bitmap_size = (num_buttons + 7) / 8;
+    size_t required_size = 4 + bitmap_size * 2; // 1 type + 3 u8 + 2 bitmaps
+
+    if (buffer_size < required_size) {
+        return 0; // Buffer too small
+    }
+
+    size_t offset = 0;
+
+    buffer[offset++] = MESSAGE_TYPE_MATRIX_STATE;
+    buffer[offset++] = input_index;
+    buffer[offset++] = rollover;
+    buffer[offset++] = num_buttons;
+
+    for (size_t i = 0; i < bitmap_size; i++) {
+        buffer[offset++] = pressed[i];
+    }
+    for (size_t i = 0; i < bitmap_size; i++) {
+        buffer[offset++] = blocked[i];
+    }
+
+    return offset;
+}
+
+bool MatrixState::decode(const uint8_t* buffer, size_t length)
+{
+    if (length < 4) {
+        return false; // Not enough data
+    }
+
+    if (buffer[0] != MESSAGE_TYPE_MATRIX_STATE) {
+        return false; // Wrong message type
+    }
+
+    input_index = buffer[1];
+    rollover = buffer[2];
+    num_buttons = buffer[3];
+
+    if (num_buttons > MAX_MATRIX_STATE_BUTTONS) {
+        return false; // Too many buttons
+    }
+
+    size_t bitmap_size = (num_buttons + 7) / 8;
+    if (length < 4 + bitmap_size * 2) {
+        return false; // Not enough data for the bitmaps
+    }
+
+    memset(pressed, 0, sizeof(pressed));
+    memset(blocked, 0, sizeof(blocked));
+    for (size_t i = 0; i < bitmap_size; i++) {
+        pressed[i] = buffer[4 + i];
+        blocked[i] = buffer[4 + bitmap_size + i];
+    }
+
+    return true;
+}
+
 // Message implementation (for generic decoding)
 
 bool Message::decode(const uint8_t* buffer, size_t length)
@@ -513,6 +1016,21 @@ bool Message::decode(const uint8_t* buffer, size_t length)
     case MESSAGE_TYPE_SET_OUTPUT:
         return set_output.decode(buffer, length);
 
+    case MESSAGE_TYPE_GET_STATS:
+        return get_stats.decode(buffer, length);
+
+    case MESSAGE_TYPE_STATS:
+        return stats.decode(buffer, length);
+
+    case MESSAGE_TYPE_CALIBRATE:
+        return calibrate.decode(buffer, length);
+
+    case MESSAGE_TYPE_CALIBRATION_DATA:
+        return calibration_data.decode(buffer, length);
+
+    case MESSAGE_TYPE_MATRIX_STATE:
+        return matrix_state.decode(buffer, length);
+
     default:
         return false; // Unknown message type
     }
@@ -14,18 +14,102 @@ constexpr uint8_t MESSAGE_TYPE_CONFIGURATION_ERROR = 4;
 constexpr uint8_t MESSAGE_TYPE_INPUT_VALUE = 5;
 constexpr uint8_t MESSAGE_TYPE_HEARTBEAT = 6;
 constexpr uint8_t MESSAGE_TYPE_SET_OUTPUT = 7;
+constexpr uint8_t MESSAGE_TYPE_GET_STATS = 8;
+constexpr uint8_t MESSAGE_TYPE_STATS = 9;
+constexpr uint8_t MESSAGE_TYPE_CALIBRATE = 10;
+constexpr uint8_t MESSAGE_TYPE_CALIBRATION_DATA = 11;
+constexpr uint8_t MESSAGE_TYPE_MATRIX_STATE = 12;
 
 // Input Type constants for Configure message
 constexpr uint8_t INPUT_TYPE_ANALOG = 0;
 constexpr uint8_t INPUT_TYPE_BUTTON = 1;
 constexpr uint8_t INPUT_TYPE_MATRIX = 2;
+constexpr uint8_t INPUT_TYPE_NOTCHED = 3;
+constexpr uint8_t INPUT_TYPE_ENCODER = 4;
+
+// Analog filter constants for Configure message (matches Sensor::FilterType)
+constexpr uint8_t ANALOG_FILTER_NONE = 0;
+constexpr uint8_t ANALOG_FILTER_EMA = 1;
+constexpr uint8_t ANALOG_FILTER_ONE_EURO = 2;
+constexpr uint8_t ANALOG_FILTER_MEDIAN3 = 3;
+
+// Analog deadband constants for Configure message
+constexpr uint8_t ANALOG_DEADBAND_DEFAULT = 0; // 2 counts, 1 when filtered
+constexpr uint8_t ANALOG_DEADBAND_AUTO = 0xFF; // Follow the noise floor measured at rest
+
+// Analog jump threshold constants for Configure message
+constexpr uint8_t ANALOG_JUMP_DEFAULT = 0; // 64 counts
+constexpr uint8_t ANALOG_JUMP_OFF = 0xFF; // Large changes wait for the interval like small ones
+
+// Eager debounce lockout constants for Configure message (button and matrix)
+constexpr uint8_t DEBOUNCE_LOCKOUT_OFF = 0; // Integrated debounce for that edge direction
+
+// Matrix debounce time constants for Configure message
+constexpr uint8_t MATRIX_DEBOUNCE_DEFAULT = 0; // 3 ms
+
+// Matrix settle time constants for Configure message
+constexpr uint8_t MATRIX_SETTLE_DEFAULT = 0; // 10 us
+
+// Matrix rows per tick constants for Configure message
+constexpr uint8_t MATRIX_ROWS_PER_TICK_ALL = 0; // Whole frame every scan
+
+// Matrix diode direction constants for Configure message (matches Sensor::MatrixSensor::DIODES_*)
+constexpr uint8_t MATRIX_DIODES_COL_TO_ROW = 0; // Cathodes on the rows: rows driven
+constexpr uint8_t MATRIX_DIODES_ROW_TO_COL = 1; // Cathodes on the columns: columns driven
+constexpr uint8_t MATRIX_DIODES_NONE = 2; // No diodes: the smaller side is driven
+
+// Encoder steps per detent constants for Configure message
+constexpr uint8_t ENCODER_STEPS_DEFAULT = 0; // 4 quadrature steps (one full cycle) per detent
+
+// Encoder acceleration constants for Configure message
+constexpr uint8_t ENCODER_ACCEL_OFF = 0; // Every detent counts 1
+
+// MatrixState rollover
+constexpr uint8_t MATRIX_ROLLOVER_NKRO = 0; // Any number of keys (diodes)
+
+// Calibrate commands
+constexpr uint8_t CALIBRATE_SET = 0; // Store the given calibration
+constexpr uint8_t CALIBRATE_START_CAPTURE = 1; // Track extremes while the user sweeps the axis
+constexpr uint8_t CALIBRATE_STOP_CAPTURE = 2; // Store the captured range (flags: center/invert)
+constexpr uint8_t CALIBRATE_CLEAR = 3; // Remove the calibration
+constexpr uint8_t CALIBRATE_GET = 4; // Report the current calibration
+
+// Calibration flags (matches Sensor::CALIBRATION_FLAG_*)
+constexpr uint8_t CALIBRATION_FLAG_VALID = 0x01;
+constexpr uint8_t CALIBRATION_FLAG_CENTER = 0x02;
+constexpr uint8_t CALIBRATION_FLAG_INVERT = 0x04;
+
+// CalibrationData status codes
+constexpr uint8_t CALIBRATION_STATUS_OK = 0;
+constexpr uint8_t CALIBRATION_STATUS_INVALID_INPUT = 1; // Not a configured analog input
+constexpr uint8_t CALIBRATION_STATUS_INVALID_RANGE = 2; // Range unusable (calibration unchanged)
 
 // Maximum number of pins for matrix configuration (row_pins + col_pins)
 constexpr uint8_t MAX_MATRIX_PINS = 16;
 
+// Maximum number of boundaries for notched configuration (notches - 1)
+constexpr uint8_t MAX_NOTCH_BOUNDARIES = 11;
+
+// Virtual pins of notch buttons: above every board's physical pins (Due has
+// 0-78) and below the matrix keys (128 and up)
+constexpr uint8_t NOTCH_BUTTON_PIN_MIN = 80;
+constexpr uint8_t NOTCH_BUTTON_PIN_END = 128; // First pin past the range
+
 // Maximum payload size
 constexpr size_t MAX_PAYLOAD_SIZE = 64;
 
+// Maximum entries in a Stats message
+constexpr uint8_t MAX_STATS_PHASES = 4;
+constexpr uint8_t MAX_STATS_SENSORS = 8; // Profiled inputs, paged by GetStats::first_sensor
+constexpr uint8_t MAX_STATS_SENSORS_PER_MESSAGE = 2;
+
+// A full Stats page (13 fixed bytes + 8 per entry) must fit one payload
+static_assert(13 + (MAX_STATS_PHASES + MAX_STATS_SENSORS_PER_MESSAGE) * 8 <= MAX_PAYLOAD_SIZE,
+    "Stats page doesn't fit the maximum payload");
+
+// Maximum buttons in a MatrixState message (8x8 matrix, bit per button)
+constexpr uint8_t MAX_MATRIX_STATE_BUTTONS = 64;
+
 // Identity Request message
 struct IdentityRequest {
     uint32_t request_id;
@@ -66,12 +150,22 @@ struct Configure {
         struct {
             uint8_t pin;
             uint8_t sensitivity;
+            uint8_t filter_type; // ANALOG_FILTER_* (optional, default NONE)
+            uint8_t filter_param1; // EMA alpha / One-Euro min alpha (1/256 units)
+            uint8_t filter_param2; // One-Euro beta
+            uint8_t oversample_bits; // Extra bits from 4^n oversampling (optional, 0-3)
+            uint8_t deadband; // Change threshold in counts, or ANALOG_DEADBAND_* (optional)
+            uint8_t hysteresis; // Extra counts to reverse direction (optional, default 0)
+            uint8_t jump; // Change in counts sent at once, or ANALOG_JUMP_* (optional)
+            uint8_t keepalive; // Resend interval at rest in 100 ms units (optional, 0 = 2 s)
         } analog;
 
         // INPUT_TYPE_BUTTON
         struct {
             uint8_t pin;
-            uint8_t debounce;
+            uint8_t debounce; // Debounce time in ms
+            uint8_t press_lockout; // Eager press lockout in ms, or DEBOUNCE_LOCKOUT_OFF (optional)
+            uint8_t release_lockout; // Eager release lockout in ms, or DEBOUNCE_LOCKOUT_OFF (optional)
         } button;
 
         // INPUT_TYPE_MATRIX
@@ -79,7 +173,30 @@ struct Configure {
             uint8_t num_row_pins;
             uint8_t num_col_pins;
             uint8_t pins[MAX_MATRIX_PINS]; // row_pins followed by col_pins
+            uint8_t settle_us; // Row settle time in us, or MATRIX_SETTLE_DEFAULT (optional)
+            uint8_t rows_per_tick; // Rows scanned per tick, or MATRIX_ROWS_PER_TICK_ALL (optional)
+            uint8_t diode_direction; // MATRIX_DIODES_* (optional, default COL_TO_ROW)
+            uint8_t press_lockout; // Eager press lockout in ms, or DEBOUNCE_LOCKOUT_OFF (optional)
+            uint8_t release_lockout; // Eager release lockout in ms, or DEBOUNCE_LOCKOUT_OFF (optional)
+            uint8_t debounce; // Debounce time in ms, or MATRIX_DEBOUNCE_DEFAULT (optional)
         } matrix;
+
+        // INPUT_TYPE_NOTCHED
+        struct {
+            uint8_t pin;
+            uint8_t hysteresis; // Raw counts past a boundary before the notch changes
+            uint8_t button_base; // Virtual pin of notch 0's button (0 = none)
+            uint8_t num_boundaries;
+            uint16_t boundaries[MAX_NOTCH_BOUNDARIES]; // Ascending raw values between notches
+        } notched;
+
+        // INPUT_TYPE_ENCODER
+        struct {
+            uint8_t pin_a;
+            uint8_t pin_b;
+            uint8_t steps_per_detent; // 1, 2 or 4, or ENCODER_STEPS_DEFAULT (optional)
+            uint8_t acceleration; // Extra counts per detent at full speed, or ENCODER_ACCEL_OFF (optional)
+        } encoder;
     };
 
     Configure()
@@ -90,6 +207,14 @@ struct Configure {
     {
         analog.pin = 0;
         analog.sensitivity = 0;
+        analog.filter_type = ANALOG_FILTER_NONE;
+        analog.filter_param1 = 0;
+        analog.filter_param2 = 0;
+        analog.oversample_bits = 0;
+        analog.deadband = ANALOG_DEADBAND_DEFAULT;
+        analog.hysteresis = 0;
+        analog.jump = ANALOG_JUMP_DEFAULT;
+        analog.keepalive = 0;
     }
 
     // Encode to buffer (returns number of bytes written, 0 on error)
@@ -125,6 +250,7 @@ struct ConfigurationError {
 struct InputValue {
     uint8_t pin;
     int16_t value;
+    uint32_t time_us; // Device micros() when the change happened (0 if not sent)
 
     // Encode to buffer (returns number of bytes written, 0 on error)
     size_t encode(uint8_t* buffer, size_t buffer_size) const;
@@ -154,6 +280,97 @@ struct SetOutput {
     bool decode(const uint8_t* buffer, size_t length);
 };
 
+// GetStats message - sent by host to request loop profiler statistics
+// Sensor entries come in pages: the host asks from first_sensor until a Stats
+// page reaches total_sensors
+struct GetStats {
+    uint8_t first_sensor; // First sensor entry to send (optional, 0 if absent)
+
+    // Encode to buffer (returns number of bytes written, 0 on error)
+    size_t encode(uint8_t* buffer, size_t buffer_size) const;
+
+    // Decode from buffer (returns true on success)
+    bool decode(const uint8_t* buffer, size_t length);
+};
+
+// Timing statistics for one profiled phase or sensor (microseconds, saturated at 65535)
+struct StatsEntry {
+    uint16_t min_us;
+    uint16_t avg_us;
+    uint16_t max_us;
+    uint16_t count; // Number of samples (saturated at 65535)
+};
+
+// Stats message - sent by device in response to GetStats
+// Covers the time since the last page of the previous query; num_phases and
+// num_sensors are 0 when the firmware was built without the profiler
+struct Stats {
+    uint32_t loop_max_us; // Worst loop period
+    uint8_t num_phases;
+    StatsEntry phases[MAX_STATS_PHASES]; // Indexed by Profiler::Phase
+    uint8_t num_sensors;
+    StatsEntry sensors[MAX_STATS_SENSORS_PER_MESSAGE]; // Scan time of inputs first_sensor onwards
+    uint16_t event_overflows; // Input events rejected because the ring was full (free-running)
+    uint16_t missed_deadlines; // Scheduler task deadlines missed (saturates at 65535)
+    uint8_t first_sensor; // Input of sensors[0]
+    uint8_t total_sensors; // Profiled inputs across all pages
+
+    // Encode to buffer (returns number of bytes written, 0 on error)
+    size_t encode(uint8_t* buffer, size_t buffer_size) const;
+
+    // Decode from buffer (returns true on success)
+    bool decode(const uint8_t* buffer, size_t length);
+};
+
+// Calibrate message - sent by host to set, capture or query an analog input calibration
+struct Calibrate {
+    uint8_t input_index; // Input index (part_number used in Configure)
+    uint8_t command; // CALIBRATE_*
+    uint8_t flags; // CALIBRATION_FLAG_* (SET, STOP_CAPTURE)
+    uint16_t min; // SET only
+    uint16_t max; // SET only
+    uint16_t center; // SET only (with CALIBRATION_FLAG_CENTER)
+
+    // Encode to buffer (returns number of bytes written, 0 on error)
+    size_t encode(uint8_t* buffer, size_t buffer_size) const;
+
+    // Decode from buffer (returns true on success)
+    bool decode(const uint8_t* buffer, size_t length);
+};
+
+// CalibrationData message - sent by device in response to every Calibrate
+struct CalibrationData {
+    uint8_t input_index;
+    uint8_t status; // CALIBRATION_STATUS_*
+    uint8_t flags; // CALIBRATION_FLAG_* (0 = not calibrated)
+    uint16_t min;
+    uint16_t max;
+    uint16_t center;
+
+    // Encode to buffer (returns number of bytes written, 0 on error)
+    size_t encode(uint8_t* buffer, size_t buffer_size) const;
+
+    // Decode from buffer (returns true on success)
+    bool decode(const uint8_t* buffer, size_t length);
+};
+
+// MatrixState message - sent by device when a matrix dropped events (full
+// input event ring) or its ghost-blocked keys changed, so the host can
+// rebuild the state of all its buttons
+struct MatrixState {
+    uint8_t input_index; // Input index (part_number used in Configure)
+    uint8_t rollover; // Keys that can always be pressed together (MATRIX_ROLLOVER_NKRO = all)
+    uint8_t num_buttons; // Buttons in each bitmap (rows * columns)
+    uint8_t pressed[MAX_MATRIX_STATE_BUTTONS / 8]; // Bit per button index, LSB first (1 = pressed)
+    uint8_t blocked[MAX_MATRIX_STATE_BUTTONS / 8]; // Keys held back as possible ghosts (not in pressed)
+
+    // Encode to buffer (returns number of bytes written, 0 on error)
+    size_t encode(uint8_t* buffer, size_t buffer_size) const;
+
+    // Decode from buffer (returns true on success)
+    bool decode(const uint8_t* buffer, size_t length);
+};
+
 // Generic message union for decoding
 struct Message {
     uint8_t message_type;
@@ -167,6 +384,11 @@ struct Message {
         InputValue input_value;
         Heartbeat heartbeat;
         SetOutput set_output;
+        GetStats get_stats;
+        Stats stats;
+        Calibrate calibrate;
+        CalibrationData calibration_data;
+        MatrixState matrix_state;
     };
 
     Message()
@@ -202,6 +424,21 @@ struct Message {
 
     // Check if this is a SetOutput message
     bool isSetOutput() const { return message_type == MESSAGE_TYPE_SET_OUTPUT; }
+
+    // Check if this is a GetStats message
+    bool isGetStats() const { return message_type == MESSAGE_TYPE_GET_STATS; }
+
+    // Check if this is a Stats message
+    bool isStats() const { return message_type == MESSAGE_TYPE_STATS; }
+
+    // Check if this is a Calibrate message
+    bool isCalibrate() const { return message_type == MESSAGE_TYPE_CALIBRATE; }
+
+    // Check if this is a CalibrationData message
+    bool isCalibrationData() const { return message_type == MESSAGE_TYPE_CALIBRATION_DATA; }
+
+    // Check if this is a MatrixState message
+    bool isMatrixState() const { return message_type == MESSAGE_TYPE_MATRIX_STATE; }
 };
 
 } // namespace Protocol
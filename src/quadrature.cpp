@@ -0,0 +1,92 @@
+#include "quadrature.h"
+
+#if defined(ESP32_PLATFORM) || defined(ESP32)
+// update() runs in the encoder interrupts, which must not touch flash
+#include <esp_attr.h>
+#define QUADRATURE_ISR_ATTR IRAM_ATTR
+#define QUADRATURE_ISR_DATA DRAM_ATTR
+#else
+#define QUADRATURE_ISR_ATTR
+#define QUADRATURE_ISR_DATA
+#endif
+
+namespace Sensor {
+
+// Step per transition, indexed by (previous AB << 2) | new AB
+// Forward (A leads B) is 00 -> 10 -> 11 -> 01 -> 00
+static const int8_t QUADRATURE_ISR_DATA TRANSITIONS[16] = {
+    0, -1, +1, 0, // from 00
+    +1, 0, 0, -1, // from 01
+    -1, 0, 0, +1, // from 10
+    0, +1, -1, 0 // from 11
+};
+
+QuadratureDecoder::QuadratureDecoder()
+    : m_state(0)
+    , m_rest(0)
+    , m_steps_per_detent(4)
+    , m_steps(0)
+{
+}
+
+void QuadratureDecoder::reset(uint8_t ab, uint8_t steps_per_detent)
+{
+    m_state = ab & 0x03;
+    m_rest = m_state;
+    m_steps_per_detent = steps_per_detent;
+    m_steps = 0;
+}
+
+int8_t QUADRATURE_ISR_ATTR QuadratureDecoder::update(uint8_t ab)
+{
+    ab &= 0x03;
+    m_steps += TRANSITIONS[(m_state << 2) | ab];
+    m_state = ab;
+
+    int8_t detent = 0;
+    if (m_steps >= (int8_t)m_steps_per_detent) {
+        detent = 1;
+    } else if (m_steps <= -(int8_t)m_steps_per_detent) {
+        detent = -1;
+    }
+    m_steps -= detent * (int8_t)m_steps_per_detent;
+
+    // A 4-step encoder only rests in one state: steps left over there were
+    // missed (jumps count 0), so round them to the nearest detent
+    if (m_steps_per_detent == 4 && ab == m_rest && m_steps != 0) {
+        if (m_steps >= 2) {
+            detent = 1;
+        } else if (m_steps <= -2) {
+            detent = -1;
+        }
+        m_steps = 0;
+    }
+
+    return detent;
+}
+
+int16_t accelerateDetents(int16_t detents, unsigned long elapsed_us, uint8_t acceleration)
+{
+    if (acceleration == 0 || detents == 0) {
+        return detents;
+    }
+
+    unsigned long count = detents < 0 ? -(long)detents : detents;
+    unsigned long per_detent_us = elapsed_us / count;
+    if (per_detent_us >= ENCODER_ACCEL_SLOW_US) {
+        return detents;
+    }
+
+    // Multiplier rises linearly from 1 to 1 + acceleration (255 * 100000 fits 32 bits)
+    int32_t multiplier = 1 + (int32_t)((uint32_t)acceleration * (ENCODER_ACCEL_SLOW_US - per_detent_us) / ENCODER_ACCEL_SLOW_US);
+    int32_t counts = (int32_t)detents * multiplier;
+    if (counts > INT16_MAX) {
+        return INT16_MAX;
+    }
+    if (counts < INT16_MIN) {
+        return INT16_MIN;
+    }
+    return (int16_t)counts;
+}
+
+} // namespace Sensor
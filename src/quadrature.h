@@ -0,0 +1,54 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace Sensor {
+
+// Detents slower than this count 1 each, whatever the acceleration
+constexpr unsigned long ENCODER_ACCEL_SLOW_US = 100000;
+
+/**
+ * Table-driven quadrature decoder for a rotary encoder.
+ *
+ * Every change of the A/B pins is looked up by (previous state, new state):
+ * a valid Gray-code step counts +1 (A leads B) or -1, and an impossible jump
+ * of both pins counts 0. Contact bounce on one pin steps back and forth and
+ * cancels out, so no debounce time is needed. Steps add up to detents.
+ */
+class QuadratureDecoder {
+public:
+    QuadratureDecoder();
+
+    /**
+     * Start from the current pin state
+     * @param ab Pin levels (bit 1 = A, bit 0 = B)
+     * @param steps_per_detent Quadrature steps per detent (1, 2 or 4)
+     */
+    void reset(uint8_t ab, uint8_t steps_per_detent);
+
+    /**
+     * Feed the pin levels after a change
+     * @param ab Pin levels (bit 1 = A, bit 0 = B)
+     * @return Detent completed by this step: +1, -1, or 0
+     */
+    int8_t update(uint8_t ab);
+
+private:
+    uint8_t m_state; // Last pin levels
+    uint8_t m_rest; // Pin levels at a detent (4-step encoders)
+    uint8_t m_steps_per_detent;
+    int8_t m_steps; // Steps since the last detent
+};
+
+/**
+ * Scale a detent count by the turning speed
+ * @param detents Detents turned (signed)
+ * @param elapsed_us Time over which they were turned
+ * @param acceleration Extra counts per detent at full speed (0 = off)
+ * @return Counts to report: detents at ENCODER_ACCEL_SLOW_US per detent or
+ *         slower, rising to detents * (1 + acceleration) as the time per
+ *         detent approaches 0
+ */
+int16_t accelerateDetents(int16_t detents, unsigned long elapsed_us, uint8_t acceleration);
+
+} // namespace Sensor
@@ -0,0 +1,184 @@
+#include "scheduler.h"
+
+namespace Scheduler {
+
+TaskScheduler::TaskScheduler()
+    : m_task_count(0)
+    , m_started(false)
+    , m_last_update(0)
+{
+}
+
+uint8_t TaskScheduler::addTask(TaskCallback callback, unsigned long period_us, unsigned long deadline_us)
+{
+    if (m_task_count >= MAX_TASKS || callback == nullptr) {
+        return INVALID_TASK;
+    }
+
+    Task& task = m_tasks[m_task_count];
+    task.callback = callback;
+    task.period_us = period_us;
+    task.deadline_us = deadline_us;
+    task.next_release = m_last_update; // First release on the next update
+    task.missed_deadlines = 0;
+    task.triggered = false;
+
+    return m_task_count++;
+}
+
+void TaskScheduler::update(unsigned long timestamp)
+{
+    // Align all releases to the first update so startup isn't counted as a miss
+    if (!m_started) {
+        for (uint8_t i = 0; i < m_task_count; i++) {
+            m_tasks[i].next_release = timestamp;
+        }
+        m_started = true;
+    }
+    m_last_update = timestamp;
+
+    // Run every due task once, earliest deadline first
+    bool ran[MAX_TASKS] = { false };
+    uint8_t id;
+    while ((id = nextDueTask(timestamp, ran)) != INVALID_TASK) {
+        Task& task = m_tasks[id];
+        ran[id] = true;
+        task.triggered = false;
+
+        if (task.period_us == 0) {
+            // Runs every update - no deadline to miss
+            task.callback();
+            continue;
+        }
+
+        if ((long)(timestamp - task.next_release) < 0) {
+            // Triggered ahead of its release - keep the regular schedule
+            task.callback();
+            continue;
+        }
+
+        // Late start beyond the deadline counts as a miss
+        if ((timestamp - task.next_release) > task.deadline_us && task.missed_deadlines < 0xFFFF) {
+            task.missed_deadlines++;
+        }
+
+        task.callback();
+        advanceRelease(task, timestamp);
+    }
+}
+
+void TaskScheduler::trigger(uint8_t task_id)
+{
+    if (task_id < m_task_count) {
+        m_tasks[task_id].triggered = true;
+    }
+}
+
+void TaskScheduler::setPeriod(uint8_t task_id, unsigned long period_us)
+{
+    if (task_id >= m_task_count) {
+        return;
+    }
+    Task& task = m_tasks[task_id];
+    if (task.period_us == period_us) {
+        return;
+    }
+
+    // Re-anchor so a shorter period starts at once and a longer one waits a full period
+    if (period_us < task.period_us) {
+        task.next_release = m_last_update;
+    } else {
+        task.next_release = m_last_update + period_us;
+    }
+    task.period_us = period_us;
+}
+
+unsigned long TaskScheduler::timeUntilNextRelease(unsigned long timestamp) const
+{
+    unsigned long earliest = (unsigned long)-1;
+
+    for (uint8_t i = 0; i < m_task_count; i++) {
+        const Task& task = m_tasks[i];
+        if (task.period_us == 0) {
+            continue;
+        }
+        if (task.triggered || (long)(timestamp - task.next_release) >= 0) {
+            return 0; // Due now
+        }
+        unsigned long remaining = task.next_release - timestamp;
+        if (remaining < earliest) {
+            earliest = remaining;
+        }
+    }
+
+    return earliest;
+}
+
+uint16_t TaskScheduler::getMissedDeadlines(uint8_t task_id) const
+{
+    if (task_id >= m_task_count) {
+        return 0;
+    }
+    return m_tasks[task_id].missed_deadlines;
+}
+
+uint32_t TaskScheduler::getTotalMissedDeadlines() const
+{
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < m_task_count; i++) {
+        total += m_tasks[i].missed_deadlines;
+    }
+    return total;
+}
+
+void TaskScheduler::resetMissedDeadlines()
+{
+    for (uint8_t i = 0; i < m_task_count; i++) {
+        m_tasks[i].missed_deadlines = 0;
+    }
+}
+
+uint8_t TaskScheduler::nextDueTask(unsigned long timestamp, const bool* ran) const
+{
+    uint8_t best = INVALID_TASK;
+    unsigned long best_deadline = 0;
+
+    for (uint8_t i = 0; i < m_task_count; i++) {
+        if (ran[i]) {
+            continue;
+        }
+
+        const Task& task = m_tasks[i];
+        unsigned long release = (task.period_us == 0 || task.triggered) ? timestamp : task.next_release;
+
+        // Not released yet (signed difference handles micros() wraparound)
+        if ((long)(timestamp - release) < 0) {
+            continue;
+        }
+
+        unsigned long deadline = release + task.deadline_us;
+        if (best == INVALID_TASK || (long)(deadline - best_deadline) < 0) {
+            best = i;
+            best_deadline = deadline;
+        }
+    }
+
+    return best;
+}
+
+void TaskScheduler::advanceRelease(Task& task, unsigned long timestamp)
+{
+    task.next_release += task.period_us;
+
+    // Fell behind by whole periods: skip them (each skipped release is a miss)
+    // instead of running the task back-to-back to catch up
+    if ((long)(timestamp - task.next_release) >= 0) {
+        unsigned long skipped = (timestamp - task.next_release) / task.period_us + 1;
+        task.next_release += skipped * task.period_us;
+
+        unsigned long missed = task.missed_deadlines + skipped;
+        task.missed_deadlines = missed > 0xFFFF ? 0xFFFF : (uint16_t)missed;
+    }
+}
+
+} // namespace Scheduler
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace Scheduler {
+
+/**
+ * Callback function type for a scheduled task
+ */
+typedef void (*TaskCallback)();
+
+/**
+ * Cooperative tick scheduler - runs each registered task at its own period
+ * and tracks whether it started within its deadline.
+ *
+ * Tasks are released every period_us. When several tasks are due in the same
+ * update, the one with the earliest absolute deadline runs first. A task that
+ * starts more than deadline_us after its release counts as a missed deadline.
+ * A task with period 0 runs on every update (e.g. serial RX).
+ */
+class TaskScheduler {
+public:
+    // Maximum number of tasks (to avoid dynamic allocation)
+    static constexpr uint8_t MAX_TASKS = 8;
+
+    // Returned by addTask() when no slot is free
+    static constexpr uint8_t INVALID_TASK = 0xFF;
+
+    TaskScheduler();
+
+    /**
+     * Register a task
+     * @param callback Function to run when the task is due
+     * @param period_us Release period in microseconds (0 = every update)
+     * @param deadline_us Allowed start delay after release in microseconds
+     * @return Task id, or INVALID_TASK if the task table is full
+     */
+    uint8_t addTask(TaskCallback callback, unsigned long period_us, unsigned long deadline_us);
+
+    /**
+     * Run all due tasks - call this in your main loop
+     * @param timestamp Current time in microseconds (from micros())
+     */
+    void update(unsigned long timestamp);
+
+    /**
+     * Run a task on the next update even if it isn't released yet
+     * (e.g. an input interrupt requesting an immediate scan).
+     * Its regular releases are unaffected.
+     * @param task_id Task id returned by addTask()
+     */
+    void trigger(uint8_t task_id);
+
+    /**
+     * Change the period of a task (takes effect from its next release)
+     * @param task_id Task id returned by addTask()
+     * @param period_us New period in microseconds
+     */
+    void setPeriod(uint8_t task_id, unsigned long period_us);
+
+    /**
+     * Get the time until the next periodic task is released
+     * (tasks with period 0 are ignored - they run on every update)
+     * @param timestamp Current time in microseconds (from micros())
+     * @return Microseconds until the next release (0 if a task is due now)
+     */
+    unsigned long timeUntilNextRelease(unsigned long timestamp) const;
+
+    /**
+     * Get the number of missed deadlines for a task
+     * @param task_id Task id returned by addTask()
+     * @return Missed deadline count (saturates at 65535)
+     */
+    uint16_t getMissedDeadlines(uint8_t task_id) const;
+
+    /**
+     * Get the number of missed deadlines across all tasks
+     * @return Sum of all per-task missed deadline counters
+     */
+    uint32_t getTotalMissedDeadlines() const;
+
+    /**
+     * Reset all missed deadline counters
+     */
+    void resetMissedDeadlines();
+
+    /**
+     * Get the number of registered tasks
+     * @return Task count
+     */
+    uint8_t getTaskCount() const { return m_task_count; }
+
+private:
+    struct Task {
+        TaskCallback callback;
+        unsigned long period_us;
+        unsigned long deadline_us;
+        unsigned long next_release; // Absolute release time of the next run
+        uint16_t missed_deadlines;
+        volatile bool triggered; // Run on the next update regardless of release
+    };
+
+    // Pick the due task with the earliest absolute deadline (INVALID_TASK if none)
+    uint8_t nextDueTask(unsigned long timestamp, const bool* ran) const;
+
+    // Advance a task's release time after it has run
+    void advanceRelease(Task& task, unsigned long timestamp);
+
+    Task m_tasks[MAX_TASKS];
+    uint8_t m_task_count;
+    bool m_started;
+    unsigned long m_last_update;
+};
+
+} // namespace Scheduler
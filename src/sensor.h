@@ -8,7 +8,9 @@ namespace Sensor {
 enum class InputType : uint8_t {
     Analog = 0,
     Button = 1,
-    Matrix = 2
+    Matrix = 2,
+    Notched = 3,
+    Encoder = 4
 };
 
 // Sensor reading result
@@ -17,20 +19,26 @@ struct Reading {
     int16_t value; // Normalized integer value
     InputType type; // Type of input
     uint8_t pin; // Pin number
+    bool keepalive; // True if this is a periodic resend, not a change
+    uint32_t time_us; // micros() when the change happened
 
     Reading()
         : has_value(false)
         , value(0)
         , type(InputType::Analog)
         , pin(0)
+        , keepalive(false)
+        , time_us(0)
     {
     }
 
-    Reading(int16_t val, InputType t, uint8_t p)
+    Reading(int16_t val, InputType t, uint8_t p, uint32_t timestamp_us, bool is_keepalive = false)
         : has_value(true)
         , value(val)
         , type(t)
         , pin(p)
+        , keepalive(is_keepalive)
+        , time_us(timestamp_us)
     {
     }
 };
@@ -44,12 +52,9 @@ public:
     virtual void begin() = 0;
 
     // Scan the sensor (read current value, update running average)
+    // Values to report are pushed to InputEvents (see input_events.h)
     virtual void scan() = 0;
 
-    // Check if sensor has a value to report (based on sensitivity)
-    // If true, returns the reading and resets the reporting state
-    virtual Reading getReading() = 0;
-
     // Get the input type
     virtual InputType getType() const = 0;
 
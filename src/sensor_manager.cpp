@@ -1,4 +1,8 @@
 #include "sensor_manager.h"
+#include "adc_sequencer.h"
+#include "input_events.h"
+#include "profiler.h"
+#include "sensor_sampler.h"
 
 namespace SensorManager {
 
@@ -6,8 +10,19 @@ namespace SensorManager {
 static Sensor::ISensor* g_sensors[MAX_SENSORS];
 static uint8_t g_sensor_count = 0;
 
-// Index for round-robin reading retrieval
-static uint8_t g_next_reading_index = 0;
+// Configuration input index of each sensor (unknown input types are skipped)
+static uint8_t g_input_index[MAX_SENSORS];
+
+#ifdef TIMER_SAMPLING
+// Tick counter for analog decimation
+static uint8_t g_analog_ticks = 0;
+#endif
+
+// Check if a sensor reads an analog pin (sampled at the analog rate)
+static bool readsAnalogPin(const Sensor::ISensor* sensor)
+{
+    return sensor->getType() == Sensor::InputType::Analog || sensor->getType() == Sensor::InputType::Notched;
+}
 
 void init()
 {
@@ -19,11 +34,21 @@ void init()
         }
     }
     g_sensor_count = 0;
-    g_next_reading_index = 0;
 }
 
 bool applyConfiguration(const ConfigManager::InputConfig* inputs, uint8_t input_count)
 {
+#ifdef TIMER_SAMPLING
+    // Sensors must not be scanned while the list is rebuilt
+    SensorSampler::stop();
+#endif
+#ifdef ADC_SEQUENCER
+    AdcSequencer::stop();
+#endif
+
+    // Readings of the old sensors are stale
+    InputEvents::clear();
+
     // Clear existing sensors
     for (uint8_t i = 0; i < MAX_SENSORS; i++) {
         if (g_sensors[i] != nullptr) {
@@ -32,10 +57,12 @@ bool applyConfiguration(const ConfigManager::InputConfig* inputs, uint8_t input_
         }
     }
     g_sensor_count = 0;
-    g_next_reading_index = 0;
 
     // Validate input count
     if (input_count > MAX_SENSORS) {
+#ifdef TIMER_SAMPLING
+        SensorSampler::start();
+#endif
         return false;
     }
 
@@ -47,12 +74,23 @@ bool applyConfiguration(const ConfigManager::InputConfig* inputs, uint8_t input_
 
         // Create sensor based on input type
         switch (config.input_type) {
-        case Protocol::INPUT_TYPE_ANALOG:
-            sensor = new Sensor::AnalogSensor(config.analog.pin, config.analog.sensitivity);
+        case Protocol::INPUT_TYPE_ANALOG: {
+            Sensor::AnalogSensor* analog = new Sensor::AnalogSensor(config.analog.pin, config.analog.sensitivity,
+                (Sensor::FilterType)config.analog.filter_type,
+                config.analog.filter_param1, config.analog.filter_param2,
+                config.analog.oversample_bits, config.analog.deadband, config.analog.hysteresis,
+                config.analog.jump, config.analog.keepalive);
+            Sensor::Calibration cal;
+            if (ConfigManager::loadCalibration(i, cal)) {
+                analog->setCalibration(cal);
+            }
+            sensor = analog;
             break;
+        }
 
         case Protocol::INPUT_TYPE_BUTTON:
-            sensor = new Sensor::ButtonSensor(config.button.pin, config.button.debounce);
+            sensor = new Sensor::ButtonSensor(config.button.pin, config.button.debounce,
+                config.button.press_lockout, config.button.release_lockout);
             break;
 
         case Protocol::INPUT_TYPE_MATRIX:
@@ -60,7 +98,27 @@ bool applyConfiguration(const ConfigManager::InputConfig* inputs, uint8_t input_
                 config.matrix.num_row_pins,
                 config.matrix.num_col_pins,
                 config.matrix.pins, // row pins
-                config.matrix.pins + config.matrix.num_row_pins); // col pins
+                config.matrix.pins + config.matrix.num_row_pins, // col pins
+                config.matrix.settle_us,
+                config.matrix.rows_per_tick,
+                config.matrix.diode_direction,
+                config.matrix.press_lockout,
+                config.matrix.release_lockout,
+                config.matrix.debounce);
+            break;
+
+        case Protocol::INPUT_TYPE_NOTCHED:
+            sensor = new Sensor::NotchedSensor(
+                config.notched.pin,
+                config.notched.hysteresis,
+                config.notched.button_base,
+                config.notched.boundaries,
+                config.notched.num_boundaries);
+            break;
+
+        case Protocol::INPUT_TYPE_ENCODER:
+            sensor = new Sensor::EncoderSensor(config.encoder.pin_a, config.encoder.pin_b,
+                config.encoder.steps_per_detent, config.encoder.acceleration);
             break;
 
         default:
@@ -70,46 +128,184 @@ bool applyConfiguration(const ConfigManager::InputConfig* inputs, uint8_t input_
 
         if (sensor != nullptr) {
             sensor->begin();
+            g_input_index[g_sensor_count] = i;
             g_sensors[g_sensor_count++] = sensor;
         }
     }
 
+#ifdef ADC_SEQUENCER
+    // Convert all analog pins in the background
+    uint8_t analog_pins[AdcSequencer::MAX_CHANNELS];
+    uint8_t num_analog = 0;
+    for (uint8_t i = 0; i < g_sensor_count; i++) {
+        if (readsAnalogPin(g_sensors[i]) && num_analog < AdcSequencer::MAX_CHANNELS) {
+            analog_pins[num_analog++] = g_sensors[i]->getPin();
+        }
+    }
+    AdcSequencer::begin(analog_pins, num_analog);
+#endif
+
+#ifdef TIMER_SAMPLING
+    SensorSampler::start();
+#endif
+
     return true;
 }
 
 void scan()
 {
+    PROFILE_PHASE(Profiler::PHASE_SCAN);
+
     // Scan all active sensors
     for (uint8_t i = 0; i < g_sensor_count; i++) {
         if (g_sensors[i] != nullptr) {
+            PROFILE_SENSOR(i);
             g_sensors[i]->scan();
         }
     }
 }
 
-bool getNextReading(Sensor::Reading& reading)
+void scan(Sensor::InputType type)
 {
-    // Check all sensors starting from the next index (round-robin)
+    PROFILE_PHASE(Profiler::PHASE_SCAN);
+
     for (uint8_t i = 0; i < g_sensor_count; i++) {
-        uint8_t index = (g_next_reading_index + i) % g_sensor_count;
-
-        if (g_sensors[index] != nullptr) {
-            Sensor::Reading r = g_sensors[index]->getReading();
-            if (r.has_value) {
-                reading = r;
-                // Move to next sensor for next call
-                g_next_reading_index = (index + 1) % g_sensor_count;
-                return true;
-            }
+        if (g_sensors[i] != nullptr && g_sensors[i]->getType() == type) {
+            PROFILE_SENSOR(i);
+            g_sensors[i]->scan();
         }
     }
+}
+
+#ifdef TIMER_SAMPLING
+void sample()
+{
+    PROFILE_PHASE(Profiler::PHASE_SCAN);
+
+    bool scan_analog = ++g_analog_ticks >= SensorSampler::ANALOG_SAMPLE_DIVIDER;
+    if (scan_analog) {
+        g_analog_ticks = 0;
+    }
 
-    return false; // No readings available
+    for (uint8_t i = 0; i < g_sensor_count; i++) {
+        Sensor::ISensor* sensor = g_sensors[i];
+        if (sensor == nullptr) {
+            continue;
+        }
+        if (readsAnalogPin(sensor) && !scan_analog) {
+            continue;
+        }
+
+        PROFILE_SENSOR(i);
+        sensor->scan();
+    }
 }
+#endif
 
 uint8_t getSensorCount()
 {
     return g_sensor_count;
 }
 
+bool hasPolledPins()
+{
+    for (uint8_t i = 0; i < g_sensor_count; i++) {
+        if (g_sensors[i] == nullptr) {
+            continue;
+        }
+        if (g_sensors[i]->getType() == Sensor::InputType::Button
+            && !static_cast<Sensor::ButtonSensor*>(g_sensors[i])->usesInterrupt()) {
+            return true;
+        }
+        if (g_sensors[i]->getType() == Sensor::InputType::Encoder
+            && !static_cast<Sensor::EncoderSensor*>(g_sensors[i])->usesInterrupt()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const Sensor::MatrixSensor* takeMatrixResync(uint8_t i, uint8_t& input_index)
+{
+    if (i >= g_sensor_count || g_sensors[i] == nullptr || g_sensors[i]->getType() != Sensor::InputType::Matrix) {
+        return nullptr;
+    }
+
+    Sensor::MatrixSensor* matrix = static_cast<Sensor::MatrixSensor*>(g_sensors[i]);
+    if (!matrix->takeResync()) {
+        return nullptr;
+    }
+    input_index = g_input_index[i];
+    return matrix;
+}
+
+// Find the analog sensor created for a configuration input index
+static Sensor::AnalogSensor* findAnalogSensor(uint8_t input_index)
+{
+    for (uint8_t i = 0; i < g_sensor_count; i++) {
+        if (g_input_index[i] == input_index && g_sensors[i]->getType() == Sensor::InputType::Analog) {
+            return static_cast<Sensor::AnalogSensor*>(g_sensors[i]);
+        }
+    }
+    return nullptr;
+}
+
+bool getCalibration(uint8_t input_index, Sensor::Calibration& cal)
+{
+    Sensor::AnalogSensor* sensor = findAnalogSensor(input_index);
+    if (sensor == nullptr) {
+        return false;
+    }
+    cal = sensor->getCalibration();
+    return true;
+}
+
+bool setCalibration(uint8_t input_index, const Sensor::Calibration& cal)
+{
+    Sensor::AnalogSensor* sensor = findAnalogSensor(input_index);
+    if (sensor == nullptr) {
+        return false;
+    }
+#ifdef TIMER_SAMPLING
+    SensorSampler::stop(); // The sampling tick reads the calibration
+#endif
+    sensor->setCalibration(cal);
+#ifdef TIMER_SAMPLING
+    SensorSampler::start();
+#endif
+    return true;
+}
+
+bool startCalibrationCapture(uint8_t input_index)
+{
+    Sensor::AnalogSensor* sensor = findAnalogSensor(input_index);
+    if (sensor == nullptr) {
+        return false;
+    }
+#ifdef TIMER_SAMPLING
+    SensorSampler::stop();
+#endif
+    sensor->startCapture();
+#ifdef TIMER_SAMPLING
+    SensorSampler::start();
+#endif
+    return true;
+}
+
+bool stopCalibrationCapture(uint8_t input_index, uint8_t flags, bool& captured)
+{
+    Sensor::AnalogSensor* sensor = findAnalogSensor(input_index);
+    if (sensor == nullptr) {
+        return false;
+    }
+#ifdef TIMER_SAMPLING
+    SensorSampler::stop();
+#endif
+    captured = sensor->stopCapture(flags);
+#ifdef TIMER_SAMPLING
+    SensorSampler::start();
+#endif
+    return true;
+}
+
 } // namespace SensorManager
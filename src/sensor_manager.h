@@ -3,7 +3,9 @@
 #include "analog_sensor.h"
 #include "button_sensor.h"
 #include "config_manager.h"
+#include "encoder_sensor.h"
 #include "matrix_sensor.h"
+#include "notched_sensor.h"
 #include "sensor.h"
 #include <stdint.h>
 
@@ -20,14 +22,37 @@ void init();
 bool applyConfiguration(const ConfigManager::InputConfig* inputs, uint8_t input_count);
 
 // Scan all sensors (read values, update running averages)
+// Sensors push their readings to InputEvents (see input_events.h)
 void scan();
 
-// Check if any sensor has a reading to report
-// Returns true if a reading is available
-// Populates the reading parameter with the sensor reading
-bool getNextReading(Sensor::Reading& reading);
+// Scan only the sensors of the given type (lets each type run at its own rate)
+void scan(Sensor::InputType type);
+
+#ifdef TIMER_SAMPLING
+// Scan all sensors (analog ones at the analog rate)
+// Called from the sampling timer tick (see sensor_sampler.h)
+void sample();
+#endif
 
 // Get number of active sensors
 uint8_t getSensorCount();
 
+// Check if a button or encoder has no pin interrupt, so it is only seen by
+// polling (its scan rate can't drop while idle without missing short taps)
+bool hasPolledPins();
+
+// Matrix at sensor slot i if it dropped events since the last call (clears
+// its resync flag), else nullptr; input_index is its configuration index
+const Sensor::MatrixSensor* takeMatrixResync(uint8_t i, uint8_t& input_index);
+
+// Analog calibration by configuration input index
+// Each returns false if the input isn't a configured analog input
+bool getCalibration(uint8_t input_index, Sensor::Calibration& cal);
+bool setCalibration(uint8_t input_index, const Sensor::Calibration& cal);
+bool startCalibrationCapture(uint8_t input_index);
+
+// Stop capturing and calibrate to the captured range
+// captured is false if no usable range was swept (calibration unchanged)
+bool stopCalibrationCapture(uint8_t input_index, uint8_t flags, bool& captured);
+
 } // namespace SensorManager
@@ -0,0 +1,198 @@
+#include "sensor_sampler.h"
+
+#ifdef TIMER_SAMPLING
+
+#include "sensor_manager.h"
+#include <Arduino.h>
+
+#if defined(ESP32_PLATFORM) || defined(ESP32)
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+namespace SensorSampler {
+
+static uint16_t g_rate_hz = 0;
+static volatile bool g_running = false;
+static volatile bool g_in_tick = false; // Guards against re-entry and lets stop() wait
+
+#if defined(ESP32_PLATFORM) || defined(ESP32)
+// The tick runs on the other core, so the running check and g_in_tick must be
+// updated together
+static portMUX_TYPE g_tick_mux = portMUX_INITIALIZER_UNLOCKED;
+#define TICK_LOCK() portENTER_CRITICAL(&g_tick_mux)
+#define TICK_UNLOCK() portEXIT_CRITICAL(&g_tick_mux)
+#else
+// Single core - stop() runs with the timer interrupt already disabled
+#define TICK_LOCK() ((void)0)
+#define TICK_UNLOCK() ((void)0)
+#endif
+
+// Timer tick - runs in interrupt (AVR/SAM), esp_timer task or scan task (ESP32) context
+static void onTick()
+{
+    TICK_LOCK();
+    // Skip if stopped or the previous tick is still running
+    bool run = g_running && !g_in_tick;
+    if (run) {
+        g_in_tick = true;
+    }
+    TICK_UNLOCK();
+
+    if (!run) {
+        return;
+    }
+    SensorManager::sample();
+    g_in_tick = false;
+}
+
+#if defined(__AVR__)
+
+// Interrupts stay enabled during the tick so USB/serial RX and millis() keep running
+ISR(TIMER1_COMPA_vect, ISR_NOBLOCK)
+{
+    onTick();
+}
+
+static void timerStart()
+{
+    noInterrupts();
+    TCCR1A = 0;
+    TCCR1B = 0;
+    TCNT1 = 0;
+    OCR1A = (uint16_t)(F_CPU / 8UL / g_rate_hz - 1); // Prescaler 8
+    TCCR1B = (1 << WGM12) | (1 << CS11); // CTC mode, clk/8
+    TIMSK1 |= (1 << OCIE1A);
+    interrupts();
+}
+
+static void timerStop()
+{
+    TIMSK1 &= ~(1 << OCIE1A);
+}
+
+#elif defined(ARDUINO_ARCH_SAM)
+
+void TC3_Handler()
+{
+    TC_GetStatus(TC1, 0); // Clear the compare flag
+    onTick();
+}
+
+static void timerStart()
+{
+    pmc_set_writeprotect(false);
+    pmc_enable_periph_clk(ID_TC3);
+    TC_Configure(TC1, 0, TC_CMR_WAVE | TC_CMR_WAVSEL_UP_RC | TC_CMR_TCCLKS_TIMER_CLOCK4); // MCK/128
+    TC_SetRC(TC1, 0, VARIANT_MCK / 128 / g_rate_hz);
+    TC1->TC_CHANNEL[0].TC_IER = TC_IER_CPCS;
+    TC1->TC_CHANNEL[0].TC_IDR = ~TC_IER_CPCS;
+    NVIC_EnableIRQ(TC3_IRQn);
+    TC_Start(TC1, 0);
+}
+
+static void timerStop()
+{
+    NVIC_DisableIRQ(TC3_IRQn);
+    TC_Stop(TC1, 0);
+}
+
+#elif defined(ESP32_PLATFORM) || defined(ESP32)
+
+static esp_timer_handle_t g_timer = nullptr;
+
+#ifdef ESP32_DUAL_CORE
+static TaskHandle_t g_scan_task = nullptr;
+
+// Pinned scan task - sleeps until the timer wakes it
+static void scanTask(void* arg)
+{
+    (void)arg;
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        onTick();
+    }
+}
+
+static void timerCallback(void* arg)
+{
+    (void)arg;
+    xTaskNotifyGive(g_scan_task);
+}
+#else
+static void timerCallback(void* arg)
+{
+    (void)arg;
+    onTick();
+}
+#endif
+
+static void timerStart()
+{
+#ifdef ESP32_DUAL_CORE
+    if (g_scan_task == nullptr) {
+        xTaskCreatePinnedToCore(scanTask, "sensor_scan", SCAN_TASK_STACK_SIZE, nullptr,
+            SCAN_TASK_PRIORITY, &g_scan_task, SCAN_TASK_CORE);
+    }
+#endif
+    if (g_timer == nullptr) {
+        esp_timer_create_args_t args = {};
+        args.callback = &timerCallback;
+        args.name = "sensor_sample";
+        esp_timer_create(&args, &g_timer);
+    }
+    esp_timer_start_periodic(g_timer, 1000000UL / g_rate_hz);
+}
+
+static void timerStop()
+{
+    if (g_timer != nullptr) {
+        esp_timer_stop(g_timer);
+    }
+}
+
+#else
+#error "TIMER_SAMPLING is not supported on this platform"
+#endif
+
+void begin(uint16_t rate_hz)
+{
+    stop();
+    g_rate_hz = rate_hz;
+    start();
+}
+
+void stop()
+{
+    if (!g_running) {
+        return;
+    }
+    timerStop();
+
+    TICK_LOCK();
+    g_running = false;
+    TICK_UNLOCK();
+
+    // On ESP32 the tick may be running on the other core
+    while (g_in_tick) {
+    }
+}
+
+void start()
+{
+    if (g_running || g_rate_hz == 0) {
+        return;
+    }
+    g_running = true;
+    timerStart();
+}
+
+bool isRunning()
+{
+    return g_running;
+}
+
+} // namespace SensorSampler
+
+#endif // TIMER_SAMPLING
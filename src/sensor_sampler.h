@@ -0,0 +1,65 @@
+#pragma once
+
+#include <stdint.h>
+
+// Optional fixed-rate sensor sampling from a hardware timer.
+// Enable with -D TIMER_SAMPLING in build_flags. The timer drives
+// SensorManager::sample(), which scans every sensor and moves its readings
+// into a lock-free ring that the main loop drains to the wire.
+//
+// Timer used per platform:
+//   AVR:   Timer1 in CTC mode (disables PWM on the Timer1 pins)
+//   SAM:   TC1 channel 0 (TC3 interrupt)
+//   ESP32: esp_timer periodic callback
+//
+// ESP32 dual-core mode (-D ESP32_DUAL_CORE, requires TIMER_SAMPLING): the
+// esp_timer only wakes a high-priority scan task pinned to core 0, so sensor
+// scanning never competes with serial RX/TX and the Arduino loop on core 1.
+
+#ifndef SENSOR_SAMPLE_RATE_HZ
+#define SENSOR_SAMPLE_RATE_HZ 1000
+#endif
+
+#if defined(ESP32_DUAL_CORE) && !defined(TIMER_SAMPLING)
+#error "ESP32_DUAL_CORE requires TIMER_SAMPLING"
+#endif
+
+namespace SensorSampler {
+
+// Analog inputs are sampled at 100 Hz whatever the tick rate, so their
+// filters and noise floor window see the same sample rate
+constexpr uint16_t ANALOG_SAMPLE_RATE_HZ = 100;
+
+// Analog inputs are sampled every Nth tick (1 kHz / 10 = 100 Hz)
+constexpr uint8_t ANALOG_SAMPLE_DIVIDER = SENSOR_SAMPLE_RATE_HZ / ANALOG_SAMPLE_RATE_HZ;
+
+static_assert(ANALOG_SAMPLE_DIVIDER >= 1 && SENSOR_SAMPLE_RATE_HZ / ANALOG_SAMPLE_RATE_HZ <= 255,
+    "SENSOR_SAMPLE_RATE_HZ must be between 100 Hz and 25.5 kHz");
+
+// Tick rate while idle: a tenth of the full rate, so the coarse checks match
+// the scheduler's idle periods (analog every 100 ms at the default 1 kHz).
+// Below 500 Hz the full rate is kept - the AVR Timer1 can't tick slower than ~31 Hz
+constexpr uint16_t IDLE_SAMPLE_RATE_HZ =
+    SENSOR_SAMPLE_RATE_HZ >= 500 ? SENSOR_SAMPLE_RATE_HZ / 10 : SENSOR_SAMPLE_RATE_HZ;
+
+#ifdef ESP32_DUAL_CORE
+// Core and priority of the scan task (the Arduino loop runs on core 1)
+constexpr int SCAN_TASK_CORE = 0;
+constexpr unsigned SCAN_TASK_PRIORITY = 20; // Above the Arduino loop, below esp_timer
+constexpr uint32_t SCAN_TASK_STACK_SIZE = 4096;
+#endif
+
+// Configure the timer for the given rate and start sampling
+void begin(uint16_t rate_hz);
+
+// Stop the timer and wait for an in-flight tick to finish
+// Call before changing the sensor list
+void stop();
+
+// Restart sampling after stop() (no-op if begin() was never called)
+void start();
+
+// Check if the timer is running
+bool isRunning();
+
+} // namespace SensorSampler
@@ -12,6 +12,10 @@
 #define LOW 0
 #define HIGH 1
 
+// Interrupt modes
+#define CHANGE 1
+#define NOT_AN_INTERRUPT -1
+
 // Analog pin definitions
 #define A0 14
 #define A1 15
@@ -29,3 +33,9 @@ int digitalRead(uint8_t pin);
 void digitalWrite(uint8_t pin, uint8_t val);
 void delayMicroseconds(unsigned int us);
 unsigned long millis();
+unsigned long micros();
+int digitalPinToInterrupt(uint8_t pin);
+void attachInterrupt(uint8_t interrupt, void (*callback)(), int mode);
+void detachInterrupt(uint8_t interrupt);
+void noInterrupts();
+void interrupts();
@@ -0,0 +1,338 @@
+// Mock DMA backend - samples are queued by the test with mockSample()
+#define ADC_SEQUENCER_MOCK
+
+// Include the implementation directly for testing
+#include "../../src/adc_sequencer.cpp"
+#include <unity.h>
+
+using namespace AdcSequencer;
+
+// First analog pin (A0 on an Uno)
+static constexpr uint8_t A0_PIN = 14;
+
+// Test that an oversized channel list is rejected
+void test_sequencer_rejects_invalid_channel_count()
+{
+    Sequencer seq;
+    uint8_t channels[MAX_CHANNELS + 1] = { 0 };
+
+    TEST_ASSERT_FALSE(seq.setChannels(channels, MAX_CHANNELS + 1));
+    TEST_ASSERT_EQUAL(0, seq.getChannelCount());
+}
+
+// Test that an empty channel list clears the previous channels
+void test_sequencer_empty_channel_list_clears()
+{
+    Sequencer seq;
+    uint8_t channels[] = { 0, 1 };
+    seq.setChannels(channels, 2);
+
+    TEST_ASSERT_TRUE(seq.setChannels(channels, 0));
+    TEST_ASSERT_EQUAL(0, seq.getChannelCount());
+    TEST_ASSERT_FALSE(seq.hasAllValues());
+}
+
+// Test that there are no values before the first conversion
+void test_sequencer_no_value_before_conversion()
+{
+    Sequencer seq;
+    uint8_t channels[] = { 0, 1 };
+    seq.setChannels(channels, 2);
+
+    uint16_t value;
+    TEST_ASSERT_FALSE(seq.getValue(0, value));
+    TEST_ASSERT_FALSE(seq.getValue(1, value));
+    TEST_ASSERT_FALSE(seq.hasAllValues());
+    TEST_ASSERT_EQUAL(0, seq.currentChannel());
+}
+
+// Test that the first result after each mux switch is discarded
+void test_sequencer_discards_after_mux_switch()
+{
+    Sequencer seq;
+    uint8_t channels[] = { 3, 5 };
+    seq.setChannels(channels, 2);
+    uint16_t value;
+
+    // Channel 3: first result discarded, stays on 3
+    TEST_ASSERT_EQUAL(3, seq.onConversion(999));
+    TEST_ASSERT_FALSE(seq.getValue(0, value));
+
+    // Channel 3: kept, moves to 5
+    TEST_ASSERT_EQUAL(5, seq.onConversion(100));
+    TEST_ASSERT_TRUE(seq.getValue(0, value));
+    TEST_ASSERT_EQUAL(100, value);
+
+    // Channel 5: discarded, then kept
+    TEST_ASSERT_EQUAL(5, seq.onConversion(888));
+    TEST_ASSERT_FALSE(seq.getValue(1, value));
+    TEST_ASSERT_EQUAL(3, seq.onConversion(200));
+    TEST_ASSERT_TRUE(seq.getValue(1, value));
+    TEST_ASSERT_EQUAL(200, value);
+
+    TEST_ASSERT_TRUE(seq.hasAllValues());
+}
+
+// Test that the sequence wraps and keeps the latest value per channel
+void test_sequencer_wraps_and_updates()
+{
+    Sequencer seq;
+    uint8_t channels[] = { 0, 1, 2 };
+    seq.setChannels(channels, 3);
+
+    // Two full cycles: discard + keep per channel
+    uint16_t raw = 10;
+    for (uint8_t i = 0; i < 12; i++) {
+        seq.onConversion(raw++);
+    }
+
+    uint16_t value;
+    TEST_ASSERT_TRUE(seq.getValue(0, value));
+    TEST_ASSERT_EQUAL(17, value);
+    TEST_ASSERT_TRUE(seq.getValue(1, value));
+    TEST_ASSERT_EQUAL(19, value);
+    TEST_ASSERT_TRUE(seq.getValue(2, value));
+    TEST_ASSERT_EQUAL(21, value);
+    TEST_ASSERT_EQUAL(0, seq.currentChannel());
+}
+
+// Test that a single channel only discards once (the mux never changes)
+void test_sequencer_single_channel_no_repeat_discard()
+{
+    Sequencer seq;
+    uint8_t channels[] = { 4 };
+    seq.setChannels(channels, 1);
+
+    seq.onConversion(1); // Discarded
+    seq.onConversion(2);
+    seq.onConversion(3);
+
+    uint16_t value;
+    TEST_ASSERT_TRUE(seq.getValue(0, value));
+    TEST_ASSERT_EQUAL(3, value);
+}
+
+// Test that discardNext() drops the following result
+void test_sequencer_discard_next()
+{
+    Sequencer seq;
+    uint8_t channels[] = { 4 };
+    seq.setChannels(channels, 1);
+    seq.onConversion(1);
+    seq.onConversion(2);
+
+    seq.discardNext();
+    seq.onConversion(500);
+
+    uint16_t value;
+    TEST_ASSERT_TRUE(seq.getValue(0, value));
+    TEST_ASSERT_EQUAL(2, value);
+}
+
+// Test that setting new channels clears the old values
+void test_sequencer_set_channels_resets()
+{
+    Sequencer seq;
+    uint8_t channels[] = { 0 };
+    seq.setChannels(channels, 1);
+    seq.onConversion(1);
+    seq.onConversion(2);
+    TEST_ASSERT_TRUE(seq.hasAllValues());
+
+    uint8_t other[] = { 6, 7 };
+    seq.setChannels(other, 2);
+
+    uint16_t value;
+    TEST_ASSERT_FALSE(seq.getValue(0, value));
+    TEST_ASSERT_FALSE(seq.hasAllValues());
+    TEST_ASSERT_EQUAL(6, seq.currentChannel());
+}
+
+// Test out-of-range slots
+void test_sequencer_invalid_slot()
+{
+    Sequencer seq;
+    uint8_t channels[] = { 0 };
+    seq.setChannels(channels, 1);
+    seq.onConversion(1);
+    seq.onConversion(2);
+
+    uint16_t value;
+    TEST_ASSERT_FALSE(seq.getValue(1, value));
+    TEST_ASSERT_FALSE(seq.getValue(MAX_CHANNELS, value));
+}
+
+// Test that every kept conversion is summed once for oversampling
+void test_sequencer_accumulates_conversions()
+{
+    Sequencer seq;
+    uint8_t channels[] = { 0, 1 };
+    seq.setChannels(channels, 2);
+    uint16_t sum;
+    uint8_t count;
+
+    TEST_ASSERT_FALSE(seq.takeAccumulated(0, sum, count));
+
+    // Two cycles: channel 0 keeps 11 and 15, channel 1 keeps 13 and 17
+    for (uint16_t raw = 10; raw < 18; raw++) {
+        seq.onConversion(raw);
+    }
+
+    TEST_ASSERT_TRUE(seq.takeAccumulated(0, sum, count));
+    TEST_ASSERT_EQUAL(26, sum);
+    TEST_ASSERT_EQUAL(2, count);
+    TEST_ASSERT_TRUE(seq.takeAccumulated(1, sum, count));
+    TEST_ASSERT_EQUAL(30, sum);
+    TEST_ASSERT_EQUAL(2, count);
+
+    // Taken - nothing new until the next conversion
+    TEST_ASSERT_FALSE(seq.takeAccumulated(0, sum, count));
+}
+
+// Test that the sum restarts when it isn't taken in time
+void test_sequencer_accumulate_restarts_when_full()
+{
+    Sequencer seq;
+    uint8_t channels[] = { 2 };
+    seq.setChannels(channels, 1);
+
+    seq.onConversion(0); // Discarded
+    for (uint8_t i = 0; i < MAX_ACCUMULATED; i++) {
+        seq.onConversion(1023);
+    }
+    seq.onConversion(5);
+
+    uint16_t sum;
+    uint8_t count;
+    TEST_ASSERT_TRUE(seq.takeAccumulated(0, sum, count));
+    TEST_ASSERT_EQUAL(5, sum);
+    TEST_ASSERT_EQUAL(1, count);
+}
+
+// Test that tagged samples go to every slot of their channel, without discards
+void test_sequencer_on_sample()
+{
+    Sequencer seq;
+    uint8_t channels[] = { 3, 5, 3 };
+    seq.setChannels(channels, 3);
+
+    seq.onSample(3, 100);
+    seq.onSample(7, 999); // Not sequenced - ignored
+    seq.onSample(5, 200);
+
+    uint16_t value;
+    TEST_ASSERT_TRUE(seq.getValue(0, value));
+    TEST_ASSERT_EQUAL(100, value);
+    TEST_ASSERT_TRUE(seq.getValue(1, value));
+    TEST_ASSERT_EQUAL(200, value);
+    TEST_ASSERT_TRUE(seq.getValue(2, value));
+    TEST_ASSERT_EQUAL(100, value);
+    TEST_ASSERT_TRUE(seq.hasAllValues());
+
+    seq.onSample(3, 104);
+    uint16_t sum;
+    uint8_t count;
+    TEST_ASSERT_TRUE(seq.takeAccumulated(0, sum, count));
+    TEST_ASSERT_EQUAL(204, sum);
+    TEST_ASSERT_EQUAL(2, count);
+}
+
+// Test reading DMA samples through the mock backend
+void test_backend_read()
+{
+    uint8_t pins[] = { A0_PIN, A0_PIN + 2 };
+    begin(pins, 2);
+    TEST_ASSERT_TRUE(isRunning());
+
+    uint16_t value;
+    TEST_ASSERT_FALSE(read(A0_PIN, value)); // Nothing converted yet
+
+    TEST_ASSERT_TRUE(mockSample(A0_PIN, 300));
+    TEST_ASSERT_TRUE(mockSample(A0_PIN + 2, 700));
+    TEST_ASSERT_TRUE(read(A0_PIN, value));
+    TEST_ASSERT_EQUAL(300, value);
+    TEST_ASSERT_TRUE(read(A0_PIN + 2, value));
+    TEST_ASSERT_EQUAL(700, value);
+
+    // Pins given as channel numbers are the same pins
+    TEST_ASSERT_TRUE(mockSample(0, 310));
+    TEST_ASSERT_TRUE(read(A0_PIN, value));
+    TEST_ASSERT_EQUAL(310, value);
+}
+
+// Test taking the sum of the DMA samples since the last read
+void test_backend_read_accumulated()
+{
+    uint8_t pins[] = { A0_PIN };
+    begin(pins, 1);
+
+    uint16_t sum;
+    uint8_t count;
+    TEST_ASSERT_TRUE(readAccumulated(A0_PIN, sum, count));
+    TEST_ASSERT_EQUAL(0, count);
+
+    mockSample(A0_PIN, 10);
+    mockSample(A0_PIN, 20);
+    mockSample(A0_PIN, 30);
+    TEST_ASSERT_TRUE(readAccumulated(A0_PIN, sum, count));
+    TEST_ASSERT_EQUAL(60, sum);
+    TEST_ASSERT_EQUAL(3, count);
+
+    TEST_ASSERT_TRUE(readAccumulated(A0_PIN, sum, count));
+    TEST_ASSERT_EQUAL(0, count);
+}
+
+// Test that a stopped sequencer or unsequenced pin falls back to analogRead()
+void test_backend_stop_and_unsequenced_pin()
+{
+    uint8_t pins[] = { A0_PIN };
+    begin(pins, 1);
+    mockSample(A0_PIN, 500);
+
+    uint16_t value;
+    TEST_ASSERT_FALSE(read(A0_PIN + 1, value));
+    TEST_ASSERT_TRUE(read(A0_PIN, value));
+
+    stop();
+    TEST_ASSERT_FALSE(isRunning());
+    TEST_ASSERT_FALSE(read(A0_PIN, value));
+    TEST_ASSERT_FALSE(mockSample(A0_PIN, 501));
+
+    // Restart keeps the old value until refreshed
+    start();
+    TEST_ASSERT_TRUE(read(A0_PIN, value));
+    TEST_ASSERT_EQUAL(500, value);
+
+    // No analog pins - nothing to run
+    begin(pins, 0);
+    TEST_ASSERT_FALSE(isRunning());
+    start();
+    TEST_ASSERT_FALSE(isRunning());
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_sequencer_rejects_invalid_channel_count);
+    RUN_TEST(test_sequencer_empty_channel_list_clears);
+    RUN_TEST(test_sequencer_no_value_before_conversion);
+    RUN_TEST(test_sequencer_discards_after_mux_switch);
+    RUN_TEST(test_sequencer_wraps_and_updates);
+    RUN_TEST(test_sequencer_single_channel_no_repeat_discard);
+    RUN_TEST(test_sequencer_discard_next);
+    RUN_TEST(test_sequencer_set_channels_resets);
+    RUN_TEST(test_sequencer_invalid_slot);
+    RUN_TEST(test_sequencer_accumulates_conversions);
+    RUN_TEST(test_sequencer_accumulate_restarts_when_full);
+    RUN_TEST(test_sequencer_on_sample);
+    RUN_TEST(test_backend_read);
+    RUN_TEST(test_backend_read_accumulated);
+    RUN_TEST(test_backend_stop_and_unsequenced_pin);
+
+    return UNITY_END();
+}
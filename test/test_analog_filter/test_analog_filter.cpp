@@ -0,0 +1,172 @@
+#include "../../src/analog_filter.h"
+#include <unity.h>
+
+using namespace Sensor;
+
+// Test that the default filter passes samples through
+void test_filter_none_passthrough()
+{
+    AnalogFilter filter;
+
+    TEST_ASSERT_EQUAL(FilterType::None, filter.getType());
+    TEST_ASSERT_EQUAL(100, filter.update(100));
+    TEST_ASSERT_EQUAL(900, filter.update(900));
+    TEST_ASSERT_EQUAL(3, filter.update(3));
+}
+
+// Test that an unknown filter type falls back to pass-through
+void test_filter_unknown_type()
+{
+    AnalogFilter filter((FilterType)42);
+
+    TEST_ASSERT_EQUAL(FilterType::None, filter.getType());
+    TEST_ASSERT_EQUAL(700, filter.update(700));
+}
+
+// Test that the first sample primes the filter (no ramp from 0)
+void test_filter_first_sample_primes()
+{
+    AnalogFilter ema(FilterType::Ema, 16);
+    AnalogFilter euro(FilterType::OneEuro);
+    AnalogFilter median(FilterType::Median3);
+
+    TEST_ASSERT_EQUAL(512, ema.update(512));
+    TEST_ASSERT_EQUAL(512, euro.update(512));
+    TEST_ASSERT_EQUAL(512, median.update(512));
+}
+
+// Test EMA step response with alpha 1/2
+void test_filter_ema_step()
+{
+    AnalogFilter filter(FilterType::Ema, 128);
+
+    filter.update(0);
+    TEST_ASSERT_EQUAL(512, filter.update(1024));
+    TEST_ASSERT_EQUAL(768, filter.update(1024));
+    TEST_ASSERT_EQUAL(896, filter.update(1024));
+}
+
+// Test that EMA settles on a constant input
+void test_filter_ema_converges()
+{
+    AnalogFilter filter(FilterType::Ema); // Default alpha 1/4
+
+    filter.update(0);
+    uint16_t value = 0;
+    for (int i = 0; i < 60; i++) {
+        value = filter.update(1000);
+    }
+
+    TEST_ASSERT_INT_WITHIN(1, 1000, value);
+}
+
+// Test that EMA attenuates alternating noise
+void test_filter_ema_attenuates_noise()
+{
+    AnalogFilter filter(FilterType::Ema, 32);
+
+    filter.update(500);
+    uint16_t lo = 1023;
+    uint16_t hi = 0;
+    for (int i = 0; i < 100; i++) {
+        uint16_t value = filter.update(i % 2 ? 510 : 490);
+        if (i > 50) {
+            lo = value < lo ? value : lo;
+            hi = value > hi ? value : hi;
+        }
+    }
+
+    TEST_ASSERT_TRUE(hi - lo <= 2);
+}
+
+// Test that One-Euro is smooth when still and fast when moving
+void test_filter_one_euro_adapts()
+{
+    AnalogFilter euro(FilterType::OneEuro, 8, 64);
+    AnalogFilter ema(FilterType::Ema, 8); // Same alpha as One-Euro at rest
+
+    euro.update(0);
+    ema.update(0);
+
+    // A large step: One-Euro opens up and gets much closer in a few scans
+    uint16_t euro_value = 0;
+    uint16_t ema_value = 0;
+    for (int i = 0; i < 5; i++) {
+        euro_value = euro.update(800);
+        ema_value = ema.update(800);
+    }
+    TEST_ASSERT_TRUE(euro_value > 700);
+    TEST_ASSERT_TRUE(ema_value < 200);
+
+    // Back at rest, small noise is smoothed
+    for (int i = 0; i < 200; i++) {
+        euro.update(800);
+    }
+    uint16_t lo = 1023;
+    uint16_t hi = 0;
+    for (int i = 0; i < 40; i++) {
+        uint16_t value = euro.update(i % 2 ? 803 : 797);
+        lo = value < lo ? value : lo;
+        hi = value > hi ? value : hi;
+    }
+    TEST_ASSERT_TRUE(hi - lo <= 2);
+}
+
+// Test that median-of-3 rejects single-sample spikes
+void test_filter_median3_rejects_spike()
+{
+    AnalogFilter filter(FilterType::Median3);
+
+    filter.update(500);
+    TEST_ASSERT_EQUAL(500, filter.update(500));
+    TEST_ASSERT_EQUAL(500, filter.update(1023)); // Spike
+    TEST_ASSERT_EQUAL(500, filter.update(500));
+    TEST_ASSERT_EQUAL(500, filter.update(0)); // Dropout
+    TEST_ASSERT_EQUAL(500, filter.update(501));
+}
+
+// Test that median-of-3 follows a real step after two samples
+void test_filter_median3_follows_step()
+{
+    AnalogFilter filter(FilterType::Median3);
+
+    filter.update(100);
+    TEST_ASSERT_EQUAL(100, filter.update(300));
+    TEST_ASSERT_EQUAL(300, filter.update(300));
+    TEST_ASSERT_EQUAL(300, filter.update(200));
+    TEST_ASSERT_EQUAL(200, filter.update(100));
+}
+
+// Test that reset forgets the history
+void test_filter_reset()
+{
+    AnalogFilter filter(FilterType::Ema, 16);
+
+    filter.update(0);
+    filter.update(1000);
+    filter.reset();
+
+    TEST_ASSERT_EQUAL(800, filter.update(800));
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_filter_none_passthrough);
+    RUN_TEST(test_filter_unknown_type);
+    RUN_TEST(test_filter_first_sample_primes);
+    RUN_TEST(test_filter_ema_step);
+    RUN_TEST(test_filter_ema_converges);
+    RUN_TEST(test_filter_ema_attenuates_noise);
+    RUN_TEST(test_filter_one_euro_adapts);
+    RUN_TEST(test_filter_median3_rejects_spike);
+    RUN_TEST(test_filter_median3_follows_step);
+    RUN_TEST(test_filter_reset);
+
+    return UNITY_END();
+}
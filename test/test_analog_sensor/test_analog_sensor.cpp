@@ -8,6 +8,17 @@
 
 // Mock Arduino functions
 static uint16_t g_mock_analog_value = 512;
+static unsigned long g_mock_millis = 0;
+
+unsigned long millis()
+{
+    return g_mock_millis;
+}
+
+unsigned long micros()
+{
+    return g_mock_millis * 1000UL;
+}
 
 void pinMode(uint8_t pin, uint8_t mode)
 {
@@ -27,12 +38,41 @@ int analogRead(uint8_t pin)
 
 using namespace Sensor;
 
+// Helper to take the next reported reading from the device-wide ring
+Reading nextReading()
+{
+    Reading reading;
+    InputEvents::pop(reading);
+    return reading;
+}
+
+// Helper to take all reported readings, returning the newest
+Reading lastReading()
+{
+    Reading newest;
+    Reading reading;
+    while (InputEvents::pop(reading)) {
+        newest = reading;
+    }
+    return newest;
+}
+
 // Helper to set mock analog value
 void setMockAnalogValue(uint16_t value)
 {
     g_mock_analog_value = value;
 }
 
+// Time between scans (analog inputs are scanned at 100 Hz)
+static constexpr unsigned long SCAN_PERIOD_MS = 10;
+
+// Helper to advance the mock clock by one scan period and scan
+void scanTick(AnalogSensor& sensor)
+{
+    g_mock_millis += SCAN_PERIOD_MS;
+    sensor.scan();
+}
+
 // Test initialization
 void test_analog_sensor_init()
 {
@@ -42,87 +82,89 @@ void test_analog_sensor_init()
     TEST_ASSERT_EQUAL(A0, sensor.getPin());
 }
 
-// Test that first scan initializes EMA
-void test_analog_sensor_first_scan_initializes()
+// Test that the first scan reports the starting value at once (a jump from 0)
+void test_analog_sensor_first_scan_reports_at_once()
 {
     AnalogSensor sensor(A0, 5);
     sensor.begin();
 
     setMockAnalogValue(512);
-    sensor.scan();
+    scanTick(sensor);
 
-    // First scan should not produce a reading (just initializes)
-    Reading r = sensor.getReading();
-    TEST_ASSERT_FALSE(r.has_value);
+    Reading r = nextReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(512, r.value);
+
+    // Nothing more until the value changes
+    scanTick(sensor);
+    TEST_ASSERT_FALSE(nextReading().has_value);
 }
 
 // Test that low sensitivity enforces longer minimum send interval
 void test_analog_sensor_low_sensitivity_rate_limit()
 {
-    AnalogSensor sensor(A0, 0); // sensitivity 0 -> min_send_interval = 11 scans
+    AnalogSensor sensor(A0, 0); // sensitivity 0 -> min interval 110 ms
     sensor.begin();
 
-    // Initialize and consume first reading
+    // Initialize: the first scan reports at once
     setMockAnalogValue(500);
-    for (int i = 0; i < 11; i++) {
-        sensor.scan();
-    }
-    sensor.getReading(); // Consume initial reading
+    scanTick(sensor);
+    nextReading(); // Consume initial reading
 
-    // Change value
-    setMockAnalogValue(600);
+    // Change value (below the jump threshold)
+    setMockAnalogValue(520);
 
-    // Scan less than min_send_interval times
+    // Scan for less than the min interval
     for (int i = 0; i < 10; i++) {
-        sensor.scan();
+        scanTick(sensor);
     }
 
     // Should NOT have a reading yet (rate limit not passed)
-    Reading r = sensor.getReading();
+    Reading r = nextReading();
     TEST_ASSERT_FALSE(r.has_value);
 }
 
 // Test that high sensitivity sends more frequently
 void test_analog_sensor_high_sensitivity_rate_limit()
 {
-    AnalogSensor sensor(A0, 10); // sensitivity 10 -> min_send_interval = 1 scan
+    AnalogSensor sensor(A0, 10); // sensitivity 10 -> min interval 10 ms (1 scan)
     sensor.begin();
 
     // Initialize with value 500
     setMockAnalogValue(500);
-    sensor.scan();
+    scanTick(sensor);
 
     // Change to 600
     setMockAnalogValue(600);
 
-    // Scan just 1 time (min_send_interval = 1)
-    sensor.scan();
+    // Scan just 1 time (min interval = 1 scan)
+    scanTick(sensor);
 
     // Should have a reading (rate limit passed and value changed)
-    Reading r = sensor.getReading();
+    Reading r = nextReading();
     TEST_ASSERT_TRUE(r.has_value);
 }
 
 // Test that value is sent when it changes significantly
 void test_analog_sensor_send_on_significant_change()
 {
-    AnalogSensor sensor(A0, 5); // sensitivity 5 -> min_send_interval = 6 scans
+    AnalogSensor sensor(A0, 5); // sensitivity 5 -> min interval 60 ms (6 scans)
     sensor.begin();
 
     // Initialize with value 500
     setMockAnalogValue(500);
-    sensor.scan();
+    scanTick(sensor);
 
     // Change to a higher value (600)
     setMockAnalogValue(600);
 
-    // Scan min_send_interval times (6 scans)
+    // Scan for the min interval (6 scans)
     for (int i = 0; i < 6; i++) {
-        sensor.scan();
+        scanTick(sensor);
     }
 
     // Should have a reading now (rate limit passed && value changed)
-    Reading r = sensor.getReading();
+    Reading r = nextReading();
     TEST_ASSERT_TRUE(r.has_value);
     TEST_ASSERT_EQUAL(InputType::Analog, r.type);
 }
@@ -130,50 +172,50 @@ void test_analog_sensor_send_on_significant_change()
 // Test that value is NOT sent when no change
 void test_analog_sensor_no_send_without_change_or_time()
 {
-    AnalogSensor sensor(A0, 5); // sensitivity 5 -> min_send_interval = 6 scans
+    AnalogSensor sensor(A0, 5); // sensitivity 5 -> min interval 60 ms (6 scans)
     sensor.begin();
 
     // Initialize and consume first reading
     setMockAnalogValue(500);
     for (int i = 0; i < 6; i++) {
-        sensor.scan();
+        scanTick(sensor);
     }
-    sensor.getReading(); // Consume initial reading
+    nextReading(); // Consume initial reading
 
     // Keep value at 500 (no change)
-    // Scan many times (but less than MAX_SEND_INTERVAL)
+    // Scan many times (but for less than the keepalive interval)
     for (int i = 0; i < 20; i++) {
-        sensor.scan();
+        scanTick(sensor);
     }
 
     // Should NOT have a reading (no change, even though rate limit passed)
-    Reading r = sensor.getReading();
+    Reading r = nextReading();
     TEST_ASSERT_FALSE(r.has_value);
 }
 
 // Test that small changes within dead zone are filtered (jitter suppression)
 void test_analog_sensor_dead_zone_filtering()
 {
-    AnalogSensor sensor(A0, 5); // sensitivity 5 -> min_send_interval = 6 scans
+    AnalogSensor sensor(A0, 5); // sensitivity 5 -> min interval 60 ms (6 scans)
     sensor.begin();
 
     // Initialize and consume first reading
     setMockAnalogValue(500);
     for (int i = 0; i < 6; i++) {
-        sensor.scan();
+        scanTick(sensor);
     }
-    sensor.getReading(); // Consume initial reading (last_sent = 500)
+    nextReading(); // Consume initial reading (last_sent = 500)
 
     // Small jitter: 501 (delta = 1, within DEAD_ZONE of 2)
     setMockAnalogValue(501);
 
     // Scan past rate limit
     for (int i = 0; i < 10; i++) {
-        sensor.scan();
+        scanTick(sensor);
     }
 
     // Should NOT have a reading (change within dead zone)
-    Reading r = sensor.getReading();
+    Reading r = nextReading();
     TEST_ASSERT_FALSE(r.has_value);
 
     // Now change to 503 (delta from last_sent=500 is 3, beyond DEAD_ZONE)
@@ -181,72 +223,512 @@ void test_analog_sensor_dead_zone_filtering()
 
     // Scan past rate limit again
     for (int i = 0; i < 6; i++) {
-        sensor.scan();
+        scanTick(sensor);
     }
 
     // Should have a reading now (change beyond dead zone)
-    Reading r2 = sensor.getReading();
+    Reading r2 = nextReading();
     TEST_ASSERT_TRUE(r2.has_value);
 }
 
-// Test that value is sent after MAX_SEND_INTERVAL regardless of change (periodic heartbeat)
+// Test that a filter removes alternating jitter that would exceed the dead zone
+void test_analog_sensor_filter_suppresses_jitter()
+{
+    AnalogSensor sensor(A0, 10, FilterType::Ema, 32); // min interval 10 ms (1 scan)
+    sensor.begin();
+
+    setMockAnalogValue(500);
+    scanTick(sensor);
+    nextReading(); // Consume initial reading (last_sent = 500)
+
+    // +-4 count noise around 500 - unfiltered this would send on every scan
+    int sends = 0;
+    for (int i = 0; i < 50; i++) {
+        setMockAnalogValue(i % 2 ? 504 : 496);
+        scanTick(sensor);
+        if (nextReading().has_value) {
+            sends++;
+        }
+    }
+
+    TEST_ASSERT_EQUAL(0, sends);
+}
+
+// Test that a filtered sensor still follows a real change
+void test_analog_sensor_filter_follows_step()
+{
+    AnalogSensor sensor(A0, 10, FilterType::OneEuro);
+    sensor.begin();
+
+    setMockAnalogValue(100);
+    scanTick(sensor);
+    nextReading();
+
+    setMockAnalogValue(900);
+    Reading r;
+    for (int i = 0; i < 30; i++) {
+        scanTick(sensor);
+        Reading next = nextReading();
+        if (next.has_value) {
+            r = next;
+        }
+    }
+
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_INT_WITHIN(2, 900, r.value);
+}
+
+// Test a host-configured deadband
+void test_analog_sensor_configured_deadband()
+{
+    AnalogSensor sensor(A0, 10, FilterType::None, 0, 0, 0, 8); // min interval 10 ms (1 scan)
+    sensor.begin();
+    TEST_ASSERT_EQUAL(8, sensor.getDeadZone());
+
+    setMockAnalogValue(500);
+    scanTick(sensor);
+    nextReading(); // Consume initial reading (last_sent = 500)
+
+    setMockAnalogValue(508); // Within the deadband
+    scanTick(sensor);
+    TEST_ASSERT_FALSE(nextReading().has_value);
+
+    setMockAnalogValue(509);
+    scanTick(sensor);
+    TEST_ASSERT_TRUE(nextReading().has_value);
+}
+
+// Test that reversing direction needs the hysteresis on top of the deadband
+void test_analog_sensor_hysteresis_on_reversal()
+{
+    AnalogSensor sensor(A0, 10, FilterType::None, 0, 0, 0, 2, 4);
+    sensor.begin();
+
+    setMockAnalogValue(500);
+    scanTick(sensor);
+    nextReading();
+
+    // Moving up: the deadband alone applies
+    setMockAnalogValue(503);
+    scanTick(sensor);
+    TEST_ASSERT_TRUE(nextReading().has_value);
+    setMockAnalogValue(506);
+    scanTick(sensor);
+    TEST_ASSERT_TRUE(nextReading().has_value);
+
+    // Turning back by 3 or 6 is within deadband + hysteresis
+    setMockAnalogValue(503);
+    scanTick(sensor);
+    TEST_ASSERT_FALSE(nextReading().has_value);
+    setMockAnalogValue(500);
+    scanTick(sensor);
+    TEST_ASSERT_FALSE(nextReading().has_value);
+
+    // Beyond it the reversal is sent, then the deadband alone applies again
+    setMockAnalogValue(499);
+    scanTick(sensor);
+    Reading r = nextReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(499, r.value);
+    setMockAnalogValue(496);
+    scanTick(sensor);
+    TEST_ASSERT_TRUE(nextReading().has_value);
+}
+
+// Test that the auto deadband grows to the noise at rest and keeps the input silent
+void test_analog_sensor_auto_deadband_follows_noise()
+{
+    AnalogSensor sensor(A0, 10, FilterType::None, 0, 0, 0, AnalogSensor::DEADBAND_AUTO);
+    sensor.begin();
+    TEST_ASSERT_EQUAL(2, sensor.getDeadZone()); // Default until measured
+
+    // +-3 count noise around 500 (6 counts peak to peak)
+    const uint16_t noise[] = { 500, 503, 497, 501, 499, 502, 498, 500 };
+    for (int i = 0; i < 64; i++) {
+        setMockAnalogValue(noise[i % 8]);
+        scanTick(sensor);
+        nextReading();
+    }
+    TEST_ASSERT_EQUAL(6, sensor.getDeadZone());
+
+    int sends = 0;
+    for (int i = 0; i < 100; i++) {
+        setMockAnalogValue(noise[i % 8]);
+        scanTick(sensor);
+        if (nextReading().has_value) {
+            sends++;
+        }
+    }
+    TEST_ASSERT_EQUAL(0, sends);
+
+    // Quieter wiring: the deadband shrinks back gradually
+    setMockAnalogValue(500);
+    for (int i = 0; i < 32 * 8; i++) {
+        scanTick(sensor);
+    }
+    TEST_ASSERT_EQUAL(1, sensor.getDeadZone());
+}
+
+// Test that movement doesn't count as noise for the auto deadband
+void test_analog_sensor_auto_deadband_ignores_movement()
+{
+    AnalogSensor sensor(A0, 10, FilterType::None, 0, 0, 0, AnalogSensor::DEADBAND_AUTO);
+    sensor.begin();
+
+    // Fast sweep (spread too wide)
+    for (int i = 0; i < 64; i++) {
+        setMockAnalogValue(100 + i * 10);
+        scanTick(sensor);
+    }
+    TEST_ASSERT_EQUAL(2, sensor.getDeadZone());
+
+    // Slow drift (narrow spread, but moving one way)
+    for (int i = 0; i < 64; i++) {
+        setMockAnalogValue(500 + i / 4);
+        scanTick(sensor);
+    }
+    TEST_ASSERT_EQUAL(2, sensor.getDeadZone());
+}
+
+// Test that oversampling reports the wider range
+void test_analog_sensor_oversample_range()
+{
+    AnalogSensor sensor(A0, 10, FilterType::None, 0, 0, 2); // 4^2 = 16 samples, 12 bits
+    sensor.begin();
+
+    setMockAnalogValue(1023);
+    Reading r;
+    for (int i = 0; i < 8; i++) {
+        scanTick(sensor);
+        Reading next = nextReading();
+        if (next.has_value) {
+            r = next;
+        }
+    }
+
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(1023 << 2, r.value);
+}
+
+// Test that an oversampling block is spread across several scans
+void test_analog_sensor_oversample_spread_across_scans()
+{
+    AnalogSensor sensor(A0, 10, FilterType::None, 0, 0, 3); // 64 samples, 4 per scan
+    sensor.begin();
+
+    setMockAnalogValue(300);
+    for (int i = 0; i < 15; i++) {
+        scanTick(sensor);
+        TEST_ASSERT_FALSE(nextReading().has_value); // Block not complete yet
+    }
+
+    scanTick(sensor); // 16th scan completes the block
+    Reading r = nextReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(300 << 3, r.value);
+}
+
+// Test that the oversampling bit count is clamped
+void test_analog_sensor_oversample_clamped()
+{
+    AnalogSensor sensor(A0, 10, FilterType::None, 0, 0, 7);
+    sensor.begin();
+
+    setMockAnalogValue(1023);
+    Reading r;
+    for (int i = 0; i < 32; i++) {
+        scanTick(sensor);
+        Reading next = nextReading();
+        if (next.has_value) {
+            r = next;
+        }
+    }
+
+    TEST_ASSERT_EQUAL(1023 << AnalogSensor::MAX_OVERSAMPLE_BITS, r.value);
+}
+
+// Test that value is sent after the keepalive interval regardless of change (periodic heartbeat)
 void test_analog_sensor_forced_send_after_min_gap()
 {
-    AnalogSensor sensor(A0, 5); // sensitivity 5 -> min_send_interval = 6 scans
+    AnalogSensor sensor(A0, 5); // sensitivity 5 -> min interval 60 ms (6 scans)
     sensor.begin();
 
     // Initialize with value 500
     setMockAnalogValue(500);
-    sensor.scan();
+    scanTick(sensor);
 
     // Keep value at 500 (no change)
     setMockAnalogValue(500);
 
-    // Scan MAX_SEND_INTERVAL times (200 scans = ~2 seconds)
+    // Scan for the keepalive interval (200 scans = 2 seconds)
     for (int i = 0; i < 200; i++) {
-        sensor.scan();
+        scanTick(sensor);
     }
 
     // Should have a reading now (forced periodic update even with no change)
-    Reading r = sensor.getReading();
+    Reading r = nextReading();
     TEST_ASSERT_TRUE(r.has_value);
     TEST_ASSERT_EQUAL(InputType::Analog, r.type);
 }
 
-// Test that reading resets scan counter
-void test_analog_sensor_reading_resets_counter()
+// Test that a forced send without a change is flagged as keepalive
+void test_analog_sensor_forced_send_is_keepalive()
+{
+    AnalogSensor sensor(A0, 5);
+    sensor.begin();
+
+    // Initialize and consume first reading
+    setMockAnalogValue(500);
+    for (int i = 0; i < 6; i++) {
+        scanTick(sensor);
+    }
+    Reading first = nextReading();
+    TEST_ASSERT_TRUE(first.has_value);
+    TEST_ASSERT_FALSE(first.keepalive); // Changed from 0 to 500
+
+    // No change for the keepalive interval
+    for (int i = 0; i < 200; i++) {
+        scanTick(sensor);
+    }
+
+    Reading r = nextReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_TRUE(r.keepalive);
+}
+
+// Test that a large jump is sent at once, whatever the interval
+void test_analog_sensor_jump_sent_at_once()
+{
+    AnalogSensor sensor(A0, 0); // min interval 110 ms
+    sensor.begin();
+
+    setMockAnalogValue(500);
+    scanTick(sensor);
+    nextReading();
+
+    setMockAnalogValue(600); // 100 counts > 64
+    scanTick(sensor);
+    Reading r = nextReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(600, r.value);
+    TEST_ASSERT_FALSE(r.keepalive);
+}
+
+// Test a configured jump threshold, and turning jumps off
+void test_analog_sensor_jump_configured()
+{
+    AnalogSensor small(A0, 0, FilterType::None, 0, 0, 0, 0, 0, 16);
+    AnalogSensor off(A0, 0, FilterType::None, 0, 0, 0, 0, 0, AnalogSensor::JUMP_OFF);
+    small.begin();
+    off.begin();
+
+    // Without jumps the first value waits for the interval
+    setMockAnalogValue(500);
+    for (int i = 0; i < 11; i++) {
+        scanTick(off);
+    }
+    TEST_ASSERT_TRUE(nextReading().has_value);
+
+    // With them it goes out at once
+    scanTick(small);
+    TEST_ASSERT_TRUE(nextReading().has_value);
+
+    // A 30 count step is a jump for one, waits for the interval on the other
+    setMockAnalogValue(530);
+    scanTick(small);
+    scanTick(off);
+    TEST_ASSERT_TRUE(nextReading().has_value);
+    TEST_ASSERT_FALSE(nextReading().has_value);
+}
+
+// Test that fast movement shortens the interval and rest restores it
+void test_analog_sensor_fast_movement_sends_faster()
+{
+    AnalogSensor sensor(A0, 0, FilterType::None, 0, 0, 0, 0, 0, AnalogSensor::JUMP_OFF);
+    sensor.begin();
+
+    setMockAnalogValue(100);
+    for (int i = 0; i < 12; i++) {
+        scanTick(sensor);
+    }
+    nextReading();
+
+    // 20 counts per scan = 2000 counts/s - interval drops well below 110 ms
+    int sends = 0;
+    for (int i = 1; i <= 30; i++) {
+        setMockAnalogValue(100 + i * 20);
+        scanTick(sensor);
+        if (nextReading().has_value) {
+            sends++;
+        }
+    }
+    TEST_ASSERT_TRUE(sensor.getSpeed() > 1500);
+    TEST_ASSERT_TRUE(sends >= 8); // 300 ms at 110 ms would be 2
+
+    // Slow drift (1 count per scan, 100 counts/s) stays near the rest interval
+    for (int i = 0; i < 20; i++) {
+        scanTick(sensor);
+    }
+    sends = 0;
+    for (int i = 1; i <= 30; i++) {
+        setMockAnalogValue(700 + i);
+        scanTick(sensor);
+        if (nextReading().has_value) {
+            sends++;
+        }
+    }
+    TEST_ASSERT_TRUE(sends <= 4);
+}
+
+// Test that send timing follows the clock, not the number of scans
+void test_analog_sensor_timing_independent_of_scan_rate()
 {
-    AnalogSensor sensor(A0, 5); // sensitivity 5 -> k=6, send_every = 10
+    AnalogSensor sensor(A0, 0); // min interval 110 ms
+    sensor.begin();
+
+    setMockAnalogValue(500);
+    scanTick(sensor);
+    nextReading();
+
+    // Scanned every 1 ms: 100 scans are still within the 110 ms interval...
+    setMockAnalogValue(505);
+    for (int i = 0; i < 100; i++) {
+        g_mock_millis += 1;
+        sensor.scan();
+    }
+    TEST_ASSERT_FALSE(nextReading().has_value);
+
+    // ...and the change goes out once it has passed
+    for (int i = 0; i < 20; i++) {
+        g_mock_millis += 1;
+        sensor.scan();
+    }
+    TEST_ASSERT_TRUE(nextReading().has_value);
+}
+
+// Test a configured keepalive interval
+void test_analog_sensor_keepalive_configured()
+{
+    AnalogSensor sensor(A0, 5, FilterType::None, 0, 0, 0, 0, 0, 0, 5); // 500 ms
+    sensor.begin();
+
+    setMockAnalogValue(500);
+    scanTick(sensor);
+    nextReading();
+
+    for (int i = 0; i < 49; i++) {
+        scanTick(sensor);
+    }
+    TEST_ASSERT_FALSE(nextReading().has_value);
+
+    scanTick(sensor);
+    Reading r = nextReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_TRUE(r.keepalive);
+}
+
+// Test that a valid calibration scales reported values
+void test_analog_sensor_calibrated_reading()
+{
+    AnalogSensor sensor(A0, 10);
+    sensor.begin();
+
+    Calibration cal;
+    cal.flags = CALIBRATION_FLAG_VALID;
+    cal.min = 100;
+    cal.max = 900;
+    sensor.setCalibration(cal);
+
+    setMockAnalogValue(900);
+    scanTick(sensor);
+    scanTick(sensor);
+
+    Reading r = nextReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(CALIBRATED_MAX, r.value);
+}
+
+// Test capturing a calibration from a sweep
+void test_analog_sensor_calibration_capture()
+{
+    AnalogSensor sensor(A0, 10);
+    sensor.begin();
+    sensor.startCapture();
+    TEST_ASSERT_TRUE(sensor.isCapturing());
+
+    // Raw values are reported while capturing
+    setMockAnalogValue(200);
+    scanTick(sensor);
+    scanTick(sensor);
+    TEST_ASSERT_EQUAL(200, nextReading().value);
+
+    setMockAnalogValue(800);
+    scanTick(sensor);
+    setMockAnalogValue(500);
+    scanTick(sensor);
+    TEST_ASSERT_EQUAL(500, lastReading().value);
+
+    TEST_ASSERT_TRUE(sensor.stopCapture(CALIBRATION_FLAG_CENTER));
+    TEST_ASSERT_FALSE(sensor.isCapturing());
+
+    const Calibration& cal = sensor.getCalibration();
+    TEST_ASSERT_TRUE(cal.isValid());
+    TEST_ASSERT_EQUAL(200, cal.min);
+    TEST_ASSERT_EQUAL(800, cal.max);
+    TEST_ASSERT_EQUAL(500, cal.center);
+
+    // Rest position reports zero
+    scanTick(sensor);
+    TEST_ASSERT_EQUAL(0, nextReading().value);
+}
+
+// Test that a capture without a sweep leaves the calibration unchanged
+void test_analog_sensor_calibration_capture_no_sweep()
+{
+    AnalogSensor sensor(A0, 10);
+    sensor.begin();
+
+    TEST_ASSERT_FALSE(sensor.stopCapture(0)); // Not capturing
+
+    sensor.startCapture();
+    setMockAnalogValue(500);
+    scanTick(sensor);
+    scanTick(sensor);
+
+    TEST_ASSERT_FALSE(sensor.stopCapture(0));
+    TEST_ASSERT_FALSE(sensor.getCalibration().isValid());
+}
+
+// Test that a report restarts the send interval
+void test_analog_sensor_report_resets_interval()
+{
+    AnalogSensor sensor(A0, 5); // sensitivity 5 -> min interval 60 ms (6 scans)
     sensor.begin();
 
     // Initialize with value 500
     setMockAnalogValue(500);
-    sensor.scan();
+    scanTick(sensor);
 
     // Change to 600 (large change)
     setMockAnalogValue(600);
 
     // Scan enough times for EMA to change significantly
     for (int i = 0; i < 15; i++) {
-        sensor.scan();
+        scanTick(sensor);
     }
 
-    // Get first reading
-    Reading r1 = sensor.getReading();
+    // Reported while the EMA moved
+    Reading r1 = lastReading();
     TEST_ASSERT_TRUE(r1.has_value);
 
-    // Immediately try to get another reading - should not have one
-    Reading r2 = sensor.getReading();
-    TEST_ASSERT_FALSE(r2.has_value);
-
     // Scan a few more times (less than send_every)
     for (int i = 0; i < 5; i++) {
-        sensor.scan();
+        scanTick(sensor);
     }
 
     // Still should not have a reading (not enough scans and value hasn't changed much)
-    Reading r3 = sensor.getReading();
-    TEST_ASSERT_FALSE(r3.has_value);
+    Reading r2 = nextReading();
+    TEST_ASSERT_FALSE(r2.has_value);
 }
 
 // Test consecutive readings with changing values
@@ -256,21 +738,21 @@ void test_analog_sensor_consecutive_readings()
     sensor.begin();
 
     setMockAnalogValue(500);
-    sensor.scan();
+    scanTick(sensor);
 
     // First reading
     setMockAnalogValue(600);
     for (int i = 0; i < 6; i++) {
-        sensor.scan();
+        scanTick(sensor);
     }
-    TEST_ASSERT_TRUE(sensor.getReading().has_value);
+    TEST_ASSERT_TRUE(nextReading().has_value);
 
     // Second reading
     setMockAnalogValue(700);
     for (int i = 0; i < 6; i++) {
-        sensor.scan();
+        scanTick(sensor);
     }
-    TEST_ASSERT_TRUE(sensor.getReading().has_value);
+    TEST_ASSERT_TRUE(nextReading().has_value);
 }
 
 // Test edge cases: boundary values (0 and 1023)
@@ -281,22 +763,22 @@ void test_analog_sensor_boundary_values()
 
     // Test minimum value
     setMockAnalogValue(0);
-    sensor.scan();
+    scanTick(sensor);
     setMockAnalogValue(100);
     for (int i = 0; i < 6; i++) {
-        sensor.scan();
+        scanTick(sensor);
     }
-    TEST_ASSERT_TRUE(sensor.getReading().has_value);
+    TEST_ASSERT_TRUE(nextReading().has_value);
 
     // Test maximum value
     setMockAnalogValue(1023);
     for (int i = 0; i < 6; i++) {
-        sensor.scan();
+        scanTick(sensor);
     }
-    TEST_ASSERT_TRUE(sensor.getReading().has_value);
+    TEST_ASSERT_TRUE(nextReading().has_value);
 }
 
-void setUp(void) {}
+void setUp(void) { InputEvents::clear(); }
 void tearDown(void) {}
 
 int main(int argc, char** argv)
@@ -304,14 +786,32 @@ int main(int argc, char** argv)
     UNITY_BEGIN();
 
     RUN_TEST(test_analog_sensor_init);
-    RUN_TEST(test_analog_sensor_first_scan_initializes);
+    RUN_TEST(test_analog_sensor_first_scan_reports_at_once);
     RUN_TEST(test_analog_sensor_low_sensitivity_rate_limit);
     RUN_TEST(test_analog_sensor_high_sensitivity_rate_limit);
     RUN_TEST(test_analog_sensor_send_on_significant_change);
     RUN_TEST(test_analog_sensor_no_send_without_change_or_time);
     RUN_TEST(test_analog_sensor_dead_zone_filtering);
+    RUN_TEST(test_analog_sensor_filter_suppresses_jitter);
+    RUN_TEST(test_analog_sensor_filter_follows_step);
+    RUN_TEST(test_analog_sensor_configured_deadband);
+    RUN_TEST(test_analog_sensor_hysteresis_on_reversal);
+    RUN_TEST(test_analog_sensor_auto_deadband_follows_noise);
+    RUN_TEST(test_analog_sensor_auto_deadband_ignores_movement);
+    RUN_TEST(test_analog_sensor_oversample_range);
+    RUN_TEST(test_analog_sensor_oversample_spread_across_scans);
+    RUN_TEST(test_analog_sensor_oversample_clamped);
     RUN_TEST(test_analog_sensor_forced_send_after_min_gap);
-    RUN_TEST(test_analog_sensor_reading_resets_counter);
+    RUN_TEST(test_analog_sensor_forced_send_is_keepalive);
+    RUN_TEST(test_analog_sensor_jump_sent_at_once);
+    RUN_TEST(test_analog_sensor_jump_configured);
+    RUN_TEST(test_analog_sensor_fast_movement_sends_faster);
+    RUN_TEST(test_analog_sensor_timing_independent_of_scan_rate);
+    RUN_TEST(test_analog_sensor_keepalive_configured);
+    RUN_TEST(test_analog_sensor_calibrated_reading);
+    RUN_TEST(test_analog_sensor_calibration_capture);
+    RUN_TEST(test_analog_sensor_calibration_capture_no_sweep);
+    RUN_TEST(test_analog_sensor_report_resets_interval);
     RUN_TEST(test_analog_sensor_consecutive_readings);
     RUN_TEST(test_analog_sensor_boundary_values);
 
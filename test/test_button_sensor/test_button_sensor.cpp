@@ -7,11 +7,17 @@
 #define INPUT_PULLUP 2
 #define LOW 0
 #define HIGH 1
+#define CHANGE 1
+#define NOT_AN_INTERRUPT -1
 
 // Mock Arduino functions
 static int g_mock_digital_value = HIGH; // Default to HIGH (not pressed, due to INPUT_PULLUP)
 static uint8_t g_last_pin_mode = 0;
 
+// Mock interrupt state: pins 2 and 3 support interrupts (like an Uno)
+static void (*g_mock_isr[2])() = { nullptr, nullptr };
+static unsigned long g_mock_micros = 0;
+
 void pinMode(uint8_t pin, uint8_t mode)
 {
     (void)pin;
@@ -30,19 +36,72 @@ void digitalWrite(uint8_t pin, uint8_t val)
     (void)val;
 }
 
+unsigned long micros()
+{
+    return g_mock_micros;
+}
+
+int digitalPinToInterrupt(uint8_t pin)
+{
+    return (pin == 2 || pin == 3) ? pin - 2 : NOT_AN_INTERRUPT;
+}
+
+void attachInterrupt(uint8_t interrupt, void (*callback)(), int mode)
+{
+    (void)mode;
+    g_mock_isr[interrupt] = callback;
+}
+
+void detachInterrupt(uint8_t interrupt)
+{
+    g_mock_isr[interrupt] = nullptr;
+}
+
+void noInterrupts() { }
+void interrupts() { }
+
 // Now include the sensor code (include .cpp directly since we provide mocks above)
 #include "../../src/sensor.h"
+#include "../../src/edge_capture.cpp"
 #include "../../src/button_sensor.cpp"
 #include <unity.h>
 
 using namespace Sensor;
 
+// Helper to take the next reported reading from the device-wide ring
+Reading nextReading()
+{
+    Reading reading;
+    InputEvents::pop(reading);
+    return reading;
+}
+
 // Helper to set mock digital value
 void setMockDigitalValue(int value)
 {
     g_mock_digital_value = value;
 }
 
+// Helper to scan every 1 ms, like the main loop
+void scanTicks(ButtonSensor& sensor, int scans)
+{
+    for (int i = 0; i < scans; i++) {
+        sensor.scan();
+        g_mock_micros += 1000;
+    }
+}
+
+// Helper to change the pin level and fire its interrupt (if attached)
+void setMockDigitalValueWithEdge(uint8_t pin, int value, unsigned long at_us)
+{
+    g_mock_digital_value = value;
+    g_mock_micros = at_us;
+    int irq = digitalPinToInterrupt(pin);
+    if (irq != NOT_AN_INTERRUPT && g_mock_isr[irq] != nullptr) {
+        g_mock_isr[irq]();
+    }
+}
+
 // Test initialization
 void test_button_sensor_init()
 {
@@ -70,36 +129,35 @@ void test_button_sensor_no_reading_initially()
     setMockDigitalValue(HIGH); // Not pressed
     sensor.scan();
 
-    Reading r = sensor.getReading();
+    Reading r = nextReading();
     TEST_ASSERT_FALSE(r.has_value);
 }
 
 // Test press detection with debounce
 void test_button_sensor_press_detection()
 {
-    ButtonSensor sensor(7, 3); // 3 scans debounce
+    ButtonSensor sensor(7, 3); // 3 ms debounce
     sensor.begin();
 
     setMockDigitalValue(HIGH); // Not pressed
-    sensor.scan();
-    sensor.getReading(); // Clear any pending
+    scanTicks(sensor, 1);
+    nextReading(); // Clear any pending
 
     // Press button (LOW due to INPUT_PULLUP)
     setMockDigitalValue(LOW);
 
-    // Scan 2 times (less than debounce threshold of 3)
-    sensor.scan();
-    sensor.scan();
+    // Pressed for 2 ms (less than the 3 ms debounce)
+    scanTicks(sensor, 3);
 
     // Should NOT have reading yet (debounce not complete)
-    Reading r1 = sensor.getReading();
+    Reading r1 = nextReading();
     TEST_ASSERT_FALSE(r1.has_value);
 
-    // Scan one more time (completes debounce)
+    // Scan at 3 ms (completes debounce)
     sensor.scan();
 
     // Should have reading now (press event)
-    Reading r2 = sensor.getReading();
+    Reading r2 = nextReading();
     TEST_ASSERT_TRUE(r2.has_value);
     TEST_ASSERT_EQUAL(1, r2.value); // 1 = pressed
     TEST_ASSERT_EQUAL(InputType::Button, r2.type);
@@ -109,32 +167,29 @@ void test_button_sensor_press_detection()
 // Test release detection with debounce
 void test_button_sensor_release_detection()
 {
-    ButtonSensor sensor(7, 3); // 3 scans debounce
+    ButtonSensor sensor(7, 3); // 3 ms debounce
     sensor.begin();
 
     // Start with button pressed
     setMockDigitalValue(LOW);
-    for (int i = 0; i < 3; i++) {
-        sensor.scan();
-    }
-    sensor.getReading(); // Consume press event
+    scanTicks(sensor, 4);
+    nextReading(); // Consume press event
 
     // Release button
     setMockDigitalValue(HIGH);
 
-    // Scan 2 times (less than debounce threshold)
-    sensor.scan();
-    sensor.scan();
+    // Released for 2 ms (less than the debounce time)
+    scanTicks(sensor, 3);
 
     // Should NOT have reading yet
-    Reading r1 = sensor.getReading();
+    Reading r1 = nextReading();
     TEST_ASSERT_FALSE(r1.has_value);
 
-    // Scan one more time (completes debounce)
+    // Scan at 3 ms (completes debounce)
     sensor.scan();
 
     // Should have reading now (release event)
-    Reading r2 = sensor.getReading();
+    Reading r2 = nextReading();
     TEST_ASSERT_TRUE(r2.has_value);
     TEST_ASSERT_EQUAL(0, r2.value); // 0 = released
 }
@@ -147,22 +202,18 @@ void test_button_sensor_no_repeat_while_held()
 
     // Press button
     setMockDigitalValue(LOW);
-    for (int i = 0; i < 3; i++) {
-        sensor.scan();
-    }
+    scanTicks(sensor, 4);
 
     // Get press event
-    Reading r1 = sensor.getReading();
+    Reading r1 = nextReading();
     TEST_ASSERT_TRUE(r1.has_value);
     TEST_ASSERT_EQUAL(1, r1.value);
 
     // Keep button held and scan many more times
-    for (int i = 0; i < 20; i++) {
-        sensor.scan();
-    }
+    scanTicks(sensor, 20);
 
     // Should NOT have another reading (button still held, no edge)
-    Reading r2 = sensor.getReading();
+    Reading r2 = nextReading();
     TEST_ASSERT_FALSE(r2.has_value);
 }
 
@@ -173,36 +224,53 @@ void test_button_sensor_debounce_filters_glitches()
     sensor.begin();
 
     setMockDigitalValue(HIGH);
-    sensor.scan();
+    scanTicks(sensor, 1);
 
-    // Glitchy signal: LOW for 2 scans, then back to HIGH
+    // Glitchy signal: LOW for 2 ms, then back to HIGH
     setMockDigitalValue(LOW);
-    sensor.scan();
-    sensor.scan();
+    scanTicks(sensor, 2);
 
     setMockDigitalValue(HIGH);
-    sensor.scan();
+    scanTicks(sensor, 5);
 
     // Should NOT have reading (glitch was filtered)
-    Reading r = sensor.getReading();
+    Reading r = nextReading();
     TEST_ASSERT_FALSE(r.has_value);
 }
 
+// Test that the debounce time doesn't depend on the scan rate
+void test_button_sensor_debounce_is_time_based()
+{
+    ButtonSensor sensor(7, 3);
+    sensor.begin();
+
+    // Scanning every 100 us: 30 scans only cover 2.9 ms
+    setMockDigitalValue(LOW);
+    for (int i = 0; i < 30; i++) {
+        sensor.scan();
+        TEST_ASSERT_FALSE(nextReading().has_value);
+        g_mock_micros += 100;
+    }
+
+    sensor.scan();
+    TEST_ASSERT_EQUAL(1, nextReading().value);
+}
+
 // Test zero debounce (immediate response)
 void test_button_sensor_zero_debounce()
 {
-    ButtonSensor sensor(7, 0); // 0 scans debounce = immediate
+    ButtonSensor sensor(7, 0); // 0 ms debounce = immediate
     sensor.begin();
 
     setMockDigitalValue(HIGH);
     sensor.scan();
-    sensor.getReading(); // Clear initial
+    nextReading(); // Clear initial
 
     // Press button - should register immediately
     setMockDigitalValue(LOW);
     sensor.scan();
 
-    Reading r = sensor.getReading();
+    Reading r = nextReading();
     TEST_ASSERT_TRUE(r.has_value);
     TEST_ASSERT_EQUAL(1, r.value);
 }
@@ -219,21 +287,17 @@ void test_button_sensor_full_cycle()
 
     // Press
     setMockDigitalValue(LOW);
-    for (int i = 0; i < 3; i++) {
-        sensor.scan();
-    }
+    scanTicks(sensor, 4);
 
-    Reading press = sensor.getReading();
+    Reading press = nextReading();
     TEST_ASSERT_TRUE(press.has_value);
     TEST_ASSERT_EQUAL(1, press.value);
 
     // Release
     setMockDigitalValue(HIGH);
-    for (int i = 0; i < 3; i++) {
-        sensor.scan();
-    }
+    scanTicks(sensor, 4);
 
-    Reading release = sensor.getReading();
+    Reading release = nextReading();
     TEST_ASSERT_TRUE(release.has_value);
     TEST_ASSERT_EQUAL(0, release.value);
 }
@@ -250,26 +314,22 @@ void test_button_sensor_multiple_cycles()
     for (int cycle = 0; cycle < 3; cycle++) {
         // Press
         setMockDigitalValue(LOW);
-        for (int i = 0; i < 3; i++) {
-            sensor.scan();
-        }
-        Reading press = sensor.getReading();
+        scanTicks(sensor, 4);
+        Reading press = nextReading();
         TEST_ASSERT_TRUE(press.has_value);
         TEST_ASSERT_EQUAL(1, press.value);
 
         // Release
         setMockDigitalValue(HIGH);
-        for (int i = 0; i < 3; i++) {
-            sensor.scan();
-        }
-        Reading release = sensor.getReading();
+        scanTicks(sensor, 4);
+        Reading release = nextReading();
         TEST_ASSERT_TRUE(release.has_value);
         TEST_ASSERT_EQUAL(0, release.value);
     }
 }
 
-// Test reading clears pending event
-void test_button_sensor_reading_clears_event()
+// Test that a press is reported once
+void test_button_sensor_reports_once()
 {
     ButtonSensor sensor(7, 3);
     sensor.begin();
@@ -279,20 +339,199 @@ void test_button_sensor_reading_clears_event()
 
     // Press
     setMockDigitalValue(LOW);
-    for (int i = 0; i < 3; i++) {
-        sensor.scan();
-    }
+    scanTicks(sensor, 4);
 
-    // First reading should have value
-    Reading r1 = sensor.getReading();
+    // One press event
+    Reading r1 = nextReading();
     TEST_ASSERT_TRUE(r1.has_value);
 
-    // Second reading should be empty
-    Reading r2 = sensor.getReading();
+    // Nothing else
+    Reading r2 = nextReading();
     TEST_ASSERT_FALSE(r2.has_value);
 }
 
-void setUp(void) { g_mock_digital_value = HIGH; }
+// Test that pins without an interrupt fall back to polling
+void test_button_sensor_polling_fallback()
+{
+    ButtonSensor sensor(7, 3);
+    sensor.begin();
+
+    TEST_ASSERT_FALSE(sensor.usesInterrupt());
+}
+
+// Test that interrupt-capable pins attach an interrupt
+void test_button_sensor_interrupt_attached()
+{
+    ButtonSensor sensor(2, 3);
+    sensor.begin();
+
+    TEST_ASSERT_TRUE(sensor.usesInterrupt());
+    TEST_ASSERT_TRUE(g_mock_isr[0] != nullptr);
+}
+
+// Test that the interrupt is released when the sensor is destroyed
+void test_button_sensor_interrupt_detached_on_destroy()
+{
+    {
+        ButtonSensor sensor(2, 3);
+        sensor.begin();
+        TEST_ASSERT_TRUE(g_mock_isr[0] != nullptr);
+    }
+
+    TEST_ASSERT_TRUE(g_mock_isr[0] == nullptr);
+}
+
+// Test that the edge timestamp is recorded at interrupt time
+void test_button_sensor_edge_timestamp()
+{
+    ButtonSensor sensor(2, 1);
+    sensor.begin();
+
+    setMockDigitalValueWithEdge(2, LOW, 12345);
+    g_mock_micros = 20000; // Scan happens later
+    sensor.scan();
+
+    // Reported with the edge time, not the scan time
+    Reading r = nextReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(1, r.value);
+    TEST_ASSERT_EQUAL_UINT32(12345, r.time_us);
+    TEST_ASSERT_EQUAL(0, sensor.getLastEdgeMicros()); // Used up by the report
+}
+
+// Test that bounces spanning several scans are stamped with the first edge
+void test_button_sensor_edge_timestamp_bounce_burst()
+{
+    ButtonSensor sensor(2, 5);
+    sensor.begin();
+
+    // First burst, taken by the scan at 1000 us
+    setMockDigitalValueWithEdge(2, LOW, 100);
+    setMockDigitalValueWithEdge(2, HIGH, 300);
+    g_mock_micros = 1000;
+    sensor.scan();
+
+    // Second burst, taken by the next scan
+    setMockDigitalValueWithEdge(2, LOW, 1200);
+    setMockDigitalValueWithEdge(2, HIGH, 1300);
+    setMockDigitalValueWithEdge(2, LOW, 1400);
+    g_mock_micros = 2000;
+    scanTicks(sensor, 10);
+
+    Reading r = nextReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(1, r.value);
+    TEST_ASSERT_EQUAL_UINT32(100, r.time_us);
+
+    // A change the poll catches before its interrupt is taken gets the scan
+    // time, not the old edge
+    g_mock_micros = 20000;
+    setMockDigitalValue(HIGH);
+    scanTicks(sensor, 10);
+    r = nextReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(0, r.value);
+    TEST_ASSERT_TRUE(r.time_us >= 20000);
+}
+
+// Test that a bounce between scans restarts the debounce time
+void test_button_sensor_edge_restarts_debounce()
+{
+    ButtonSensor sensor(2, 3);
+    sensor.begin();
+
+    // Press edge, two stable scans
+    setMockDigitalValueWithEdge(2, LOW, 100);
+    scanTicks(sensor, 2);
+
+    // Bounce between scans: released and pressed again before the next scan.
+    // Polling alone would not see it and would confirm at 3100 us.
+    setMockDigitalValueWithEdge(2, HIGH, 2100);
+    setMockDigitalValueWithEdge(2, LOW, 2150);
+    sensor.scan();
+    g_mock_micros = 4000;
+    sensor.scan();
+
+    Reading r1 = nextReading();
+    TEST_ASSERT_FALSE(r1.has_value);
+
+    // Stable for the full debounce time after the last edge
+    g_mock_micros = 5200;
+    sensor.scan();
+
+    Reading r2 = nextReading();
+    TEST_ASSERT_TRUE(r2.has_value);
+    TEST_ASSERT_EQUAL(1, r2.value);
+}
+
+// Test that an eager press is reported on the first pressed reading, then the
+// pin is ignored while it bounces
+void test_button_sensor_eager_press_lockout()
+{
+    ButtonSensor sensor(7, 3, 20, ButtonSensor::LOCKOUT_OFF);
+    sensor.begin();
+
+    g_mock_micros = 1000000;
+    setMockDigitalValue(LOW);
+    sensor.scan();
+    Reading press = nextReading();
+    TEST_ASSERT_TRUE(press.has_value);
+    TEST_ASSERT_EQUAL(1, press.value);
+
+    // Bounce inside the 20 ms lockout is ignored
+    for (int i = 0; i < 5; i++) {
+        g_mock_micros += 3000;
+        setMockDigitalValue(i % 2 ? LOW : HIGH);
+        sensor.scan();
+    }
+    TEST_ASSERT_FALSE(nextReading().has_value);
+
+    // After the lockout, release is integrated (3 ms)
+    g_mock_micros = 1020000;
+    setMockDigitalValue(HIGH);
+    scanTicks(sensor, 3);
+    TEST_ASSERT_FALSE(nextReading().has_value);
+    sensor.scan();
+    Reading release = nextReading();
+    TEST_ASSERT_TRUE(release.has_value);
+    TEST_ASSERT_EQUAL(0, release.value);
+}
+
+// Test asymmetric lockouts with eager press and release
+void test_button_sensor_eager_release_lockout()
+{
+    ButtonSensor sensor(7, 3, 5, 30);
+    sensor.begin();
+
+    g_mock_micros = 0;
+    setMockDigitalValue(LOW);
+    sensor.scan();
+    TEST_ASSERT_EQUAL(1, nextReading().value);
+
+    // Eager release once the 5 ms press lockout is over
+    g_mock_micros = 5000;
+    setMockDigitalValue(HIGH);
+    sensor.scan();
+    TEST_ASSERT_EQUAL(0, nextReading().value);
+
+    // Pressed again within the 30 ms release lockout: ignored
+    g_mock_micros = 20000;
+    setMockDigitalValue(LOW);
+    sensor.scan();
+    TEST_ASSERT_FALSE(nextReading().has_value);
+
+    // Still pressed when the lockout ends: reported at once
+    g_mock_micros = 35000;
+    sensor.scan();
+    TEST_ASSERT_EQUAL(1, nextReading().value);
+}
+
+void setUp(void)
+{
+    g_mock_digital_value = HIGH;
+    g_mock_micros = 0;
+    InputEvents::clear();
+}
 void tearDown(void) {}
 
 int main(int argc, char** argv)
@@ -306,10 +545,19 @@ int main(int argc, char** argv)
     RUN_TEST(test_button_sensor_release_detection);
     RUN_TEST(test_button_sensor_no_repeat_while_held);
     RUN_TEST(test_button_sensor_debounce_filters_glitches);
+    RUN_TEST(test_button_sensor_debounce_is_time_based);
     RUN_TEST(test_button_sensor_zero_debounce);
     RUN_TEST(test_button_sensor_full_cycle);
     RUN_TEST(test_button_sensor_multiple_cycles);
-    RUN_TEST(test_button_sensor_reading_clears_event);
+    RUN_TEST(test_button_sensor_reports_once);
+    RUN_TEST(test_button_sensor_polling_fallback);
+    RUN_TEST(test_button_sensor_interrupt_attached);
+    RUN_TEST(test_button_sensor_interrupt_detached_on_destroy);
+    RUN_TEST(test_button_sensor_edge_timestamp);
+    RUN_TEST(test_button_sensor_edge_timestamp_bounce_burst);
+    RUN_TEST(test_button_sensor_edge_restarts_debounce);
+    RUN_TEST(test_button_sensor_eager_press_lockout);
+    RUN_TEST(test_button_sensor_eager_release_lockout);
 
     return UNITY_END();
 }
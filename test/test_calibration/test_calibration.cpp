@@ -0,0 +1,120 @@
+#include "../../src/calibration.h"
+#include <unity.h>
+
+using namespace Sensor;
+
+static Calibration makeCalibration(uint8_t flags, uint16_t min, uint16_t max, uint16_t center = 0)
+{
+    Calibration cal;
+    cal.flags = flags | CALIBRATION_FLAG_VALID;
+    cal.min = min;
+    cal.max = max;
+    cal.center = center;
+    return cal;
+}
+
+// Test that an empty calibration passes values through
+void test_calibration_uncalibrated_passthrough()
+{
+    Calibration cal;
+
+    TEST_ASSERT_FALSE(cal.isValid());
+    TEST_ASSERT_EQUAL_INT16(0, cal.apply(0));
+    TEST_ASSERT_EQUAL_INT16(517, cal.apply(517));
+}
+
+// Test range validation
+void test_calibration_validity()
+{
+    TEST_ASSERT_TRUE(makeCalibration(0, 100, 900).isValid());
+    TEST_ASSERT_FALSE(makeCalibration(0, 900, 100).isValid()); // Reversed
+    TEST_ASSERT_FALSE(makeCalibration(0, 500, 500).isValid()); // Empty range
+    TEST_ASSERT_TRUE(makeCalibration(CALIBRATION_FLAG_CENTER, 100, 900, 500).isValid());
+    TEST_ASSERT_FALSE(makeCalibration(CALIBRATION_FLAG_CENTER, 100, 900, 100).isValid()); // Center at an end
+    TEST_ASSERT_FALSE(makeCalibration(CALIBRATION_FLAG_CENTER, 100, 900, 950).isValid());
+
+    // Not flagged valid
+    Calibration cal = makeCalibration(0, 100, 900);
+    cal.flags = 0;
+    TEST_ASSERT_FALSE(cal.isValid());
+    TEST_ASSERT_EQUAL_INT16(300, cal.apply(300));
+}
+
+// Test unipolar scaling to the full range
+void test_calibration_unipolar()
+{
+    Calibration cal = makeCalibration(0, 100, 900);
+
+    TEST_ASSERT_EQUAL_INT16(0, cal.apply(100));
+    TEST_ASSERT_EQUAL_INT16(16384, cal.apply(500));
+    TEST_ASSERT_EQUAL_INT16(CALIBRATED_MAX, cal.apply(900));
+}
+
+// Test clamping outside the calibrated range
+void test_calibration_clamps()
+{
+    Calibration cal = makeCalibration(0, 100, 900);
+
+    TEST_ASSERT_EQUAL_INT16(0, cal.apply(0));
+    TEST_ASSERT_EQUAL_INT16(CALIBRATED_MAX, cal.apply(1023));
+}
+
+// Test unipolar inversion
+void test_calibration_unipolar_invert()
+{
+    Calibration cal = makeCalibration(CALIBRATION_FLAG_INVERT, 100, 900);
+
+    TEST_ASSERT_EQUAL_INT16(CALIBRATED_MAX, cal.apply(100));
+    TEST_ASSERT_EQUAL_INT16(0, cal.apply(900));
+}
+
+// Test bipolar scaling with an off-center rest position
+void test_calibration_center()
+{
+    Calibration cal = makeCalibration(CALIBRATION_FLAG_CENTER, 0, 1000, 400);
+
+    TEST_ASSERT_EQUAL_INT16(-CALIBRATED_MAX, cal.apply(0));
+    TEST_ASSERT_EQUAL_INT16(-16384, cal.apply(200));
+    TEST_ASSERT_EQUAL_INT16(0, cal.apply(400));
+    TEST_ASSERT_EQUAL_INT16(16384, cal.apply(700));
+    TEST_ASSERT_EQUAL_INT16(CALIBRATED_MAX, cal.apply(1000));
+}
+
+// Test bipolar inversion
+void test_calibration_center_invert()
+{
+    Calibration cal = makeCalibration(CALIBRATION_FLAG_CENTER | CALIBRATION_FLAG_INVERT, 0, 1000, 500);
+
+    TEST_ASSERT_EQUAL_INT16(CALIBRATED_MAX, cal.apply(0));
+    TEST_ASSERT_EQUAL_INT16(0, cal.apply(500));
+    TEST_ASSERT_EQUAL_INT16(-CALIBRATED_MAX, cal.apply(1000));
+}
+
+// Test oversampled (13-bit) input
+void test_calibration_wide_input()
+{
+    Calibration cal = makeCalibration(0, 0, 8184);
+
+    TEST_ASSERT_EQUAL_INT16(CALIBRATED_MAX, cal.apply(8184));
+    TEST_ASSERT_EQUAL_INT16(16384, cal.apply(4092));
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_calibration_uncalibrated_passthrough);
+    RUN_TEST(test_calibration_validity);
+    RUN_TEST(test_calibration_unipolar);
+    RUN_TEST(test_calibration_clamps);
+    RUN_TEST(test_calibration_unipolar_invert);
+    RUN_TEST(test_calibration_center);
+    RUN_TEST(test_calibration_center_invert);
+    RUN_TEST(test_calibration_wide_input);
+
+    return UNITY_END();
+}
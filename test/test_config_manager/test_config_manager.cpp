@@ -87,6 +87,13 @@ void test_load_succeeds_with_matching_version()
     inputs[0].input_type = Protocol::INPUT_TYPE_ANALOG;
     inputs[0].analog.pin = 14;
     inputs[0].analog.sensitivity = 5;
+    inputs[0].analog.filter_type = Protocol::ANALOG_FILTER_EMA;
+    inputs[0].analog.filter_param1 = 48;
+    inputs[0].analog.oversample_bits = 2;
+    inputs[0].analog.deadband = Protocol::ANALOG_DEADBAND_AUTO;
+    inputs[0].analog.hysteresis = 4;
+    inputs[0].analog.jump = 40;
+    inputs[0].analog.keepalive = 10;
 
     uint32_t config_id = 54321;
     ConfigManager::storeToEEPROM(config_id, inputs, 1);
@@ -105,6 +112,13 @@ void test_load_succeeds_with_matching_version()
     TEST_ASSERT_EQUAL_UINT8(Protocol::INPUT_TYPE_ANALOG, loaded[0].input_type);
     TEST_ASSERT_EQUAL_UINT8(14, loaded[0].analog.pin);
     TEST_ASSERT_EQUAL_UINT8(5, loaded[0].analog.sensitivity);
+    TEST_ASSERT_EQUAL_UINT8(Protocol::ANALOG_FILTER_EMA, loaded[0].analog.filter_type);
+    TEST_ASSERT_EQUAL_UINT8(48, loaded[0].analog.filter_param1);
+    TEST_ASSERT_EQUAL_UINT8(2, loaded[0].analog.oversample_bits);
+    TEST_ASSERT_EQUAL_UINT8(Protocol::ANALOG_DEADBAND_AUTO, loaded[0].analog.deadband);
+    TEST_ASSERT_EQUAL_UINT8(4, loaded[0].analog.hysteresis);
+    TEST_ASSERT_EQUAL_UINT8(40, loaded[0].analog.jump);
+    TEST_ASSERT_EQUAL_UINT8(10, loaded[0].analog.keepalive);
 }
 
 // Test that loadFromEEPROM fails and clears EEPROM with mismatched version
@@ -159,6 +173,211 @@ void test_load_fails_with_invalid_num_inputs()
     TEST_ASSERT_FALSE(result);
 }
 
+// Test that a notched input survives the EEPROM roundtrip
+void test_load_notched_input()
+{
+    ConfigManager::InputConfig inputs[1];
+    inputs[0].input_type = Protocol::INPUT_TYPE_NOTCHED;
+    inputs[0].notched.pin = 15;
+    inputs[0].notched.hysteresis = 6;
+    inputs[0].notched.button_base = 96;
+    inputs[0].notched.num_boundaries = 2;
+    inputs[0].notched.boundaries[0] = 300;
+    inputs[0].notched.boundaries[1] = 700;
+
+    ConfigManager::storeToEEPROM(777, inputs, 1);
+    TEST_ASSERT_TRUE(ConfigManager::loadFromEEPROM());
+
+    uint8_t num_inputs = 0;
+    const ConfigManager::InputConfig* loaded = ConfigManager::getCurrentConfig(num_inputs);
+    TEST_ASSERT_EQUAL_UINT8(1, num_inputs);
+    TEST_ASSERT_EQUAL_UINT8(Protocol::INPUT_TYPE_NOTCHED, loaded[0].input_type);
+    TEST_ASSERT_EQUAL_UINT8(15, loaded[0].notched.pin);
+    TEST_ASSERT_EQUAL_UINT8(6, loaded[0].notched.hysteresis);
+    TEST_ASSERT_EQUAL_UINT8(96, loaded[0].notched.button_base);
+    TEST_ASSERT_EQUAL_UINT8(2, loaded[0].notched.num_boundaries);
+    TEST_ASSERT_EQUAL_UINT16(300, loaded[0].notched.boundaries[0]);
+    TEST_ASSERT_EQUAL_UINT16(700, loaded[0].notched.boundaries[1]);
+}
+
+// Test that a matrix input survives the EEPROM roundtrip
+void test_load_matrix_input()
+{
+    ConfigManager::InputConfig inputs[1];
+    inputs[0].input_type = Protocol::INPUT_TYPE_MATRIX;
+    inputs[0].matrix.num_row_pins = 2;
+    inputs[0].matrix.num_col_pins = 3;
+    for (uint8_t i = 0; i < 5; i++) {
+        inputs[0].matrix.pins[i] = 2 + i;
+    }
+    inputs[0].matrix.settle_us = 25;
+    inputs[0].matrix.rows_per_tick = 1;
+    inputs[0].matrix.diode_direction = Protocol::MATRIX_DIODES_NONE;
+    inputs[0].matrix.press_lockout = 6;
+    inputs[0].matrix.release_lockout = 12;
+    inputs[0].matrix.debounce = 7;
+
+    ConfigManager::storeToEEPROM(778, inputs, 1);
+    TEST_ASSERT_TRUE(ConfigManager::loadFromEEPROM());
+
+    uint8_t num_inputs = 0;
+    const ConfigManager::InputConfig* loaded = ConfigManager::getCurrentConfig(num_inputs);
+    TEST_ASSERT_EQUAL_UINT8(1, num_inputs);
+    TEST_ASSERT_EQUAL_UINT8(Protocol::INPUT_TYPE_MATRIX, loaded[0].input_type);
+    TEST_ASSERT_EQUAL_UINT8(2, loaded[0].matrix.num_row_pins);
+    TEST_ASSERT_EQUAL_UINT8(3, loaded[0].matrix.num_col_pins);
+    for (uint8_t i = 0; i < 5; i++) {
+        TEST_ASSERT_EQUAL_UINT8(2 + i, loaded[0].matrix.pins[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT8(25, loaded[0].matrix.settle_us);
+    TEST_ASSERT_EQUAL_UINT8(1, loaded[0].matrix.rows_per_tick);
+    TEST_ASSERT_EQUAL_UINT8(Protocol::MATRIX_DIODES_NONE, loaded[0].matrix.diode_direction);
+    TEST_ASSERT_EQUAL_UINT8(6, loaded[0].matrix.press_lockout);
+    TEST_ASSERT_EQUAL_UINT8(12, loaded[0].matrix.release_lockout);
+    TEST_ASSERT_EQUAL_UINT8(7, loaded[0].matrix.debounce);
+}
+
+// Test that an encoder input survives the EEPROM roundtrip
+void test_load_encoder_input()
+{
+    ConfigManager::InputConfig inputs[1];
+    inputs[0].input_type = Protocol::INPUT_TYPE_ENCODER;
+    inputs[0].encoder.pin_a = 2;
+    inputs[0].encoder.pin_b = 3;
+    inputs[0].encoder.steps_per_detent = 2;
+    inputs[0].encoder.acceleration = 9;
+
+    ConfigManager::storeToEEPROM(779, inputs, 1);
+    TEST_ASSERT_TRUE(ConfigManager::loadFromEEPROM());
+
+    uint8_t num_inputs = 0;
+    const ConfigManager::InputConfig* loaded = ConfigManager::getCurrentConfig(num_inputs);
+    TEST_ASSERT_EQUAL_UINT8(1, num_inputs);
+    TEST_ASSERT_EQUAL_UINT8(Protocol::INPUT_TYPE_ENCODER, loaded[0].input_type);
+    TEST_ASSERT_EQUAL_UINT8(2, loaded[0].encoder.pin_a);
+    TEST_ASSERT_EQUAL_UINT8(3, loaded[0].encoder.pin_b);
+    TEST_ASSERT_EQUAL_UINT8(2, loaded[0].encoder.steps_per_detent);
+    TEST_ASSERT_EQUAL_UINT8(9, loaded[0].encoder.acceleration);
+}
+
+// Test that notch boundaries must be ascending
+void test_add_part_rejects_unordered_boundaries()
+{
+    Protocol::Configure cfg;
+    cfg.config_id = 1;
+    cfg.total_parts = 1;
+    cfg.part_number = 0;
+    cfg.input_type = Protocol::INPUT_TYPE_NOTCHED;
+    cfg.notched.pin = 14;
+    cfg.notched.hysteresis = 4;
+    cfg.notched.button_base = 0;
+    cfg.notched.num_boundaries = 2;
+    cfg.notched.boundaries[0] = 700;
+    cfg.notched.boundaries[1] = 300;
+
+    ConfigManager::ConfigState state;
+    state.start(cfg.config_id, cfg.total_parts);
+    TEST_ASSERT_FALSE(state.addPart(cfg));
+
+    cfg.notched.boundaries[0] = 300;
+    cfg.notched.boundaries[1] = 700;
+    TEST_ASSERT_TRUE(state.addPart(cfg));
+    TEST_ASSERT_TRUE(state.isComplete());
+}
+
+// Test that notch buttons must stay between the physical and the matrix pins
+void test_add_part_rejects_notch_button_range()
+{
+    Protocol::Configure cfg;
+    cfg.config_id = 1;
+    cfg.total_parts = 1;
+    cfg.part_number = 0;
+    cfg.input_type = Protocol::INPUT_TYPE_NOTCHED;
+    cfg.notched.pin = 14;
+    cfg.notched.hysteresis = 4;
+    cfg.notched.num_boundaries = Protocol::MAX_NOTCH_BOUNDARIES;
+    for (uint8_t i = 0; i < Protocol::MAX_NOTCH_BOUNDARIES; i++) {
+        cfg.notched.boundaries[i] = (i + 1) * 85;
+    }
+
+    ConfigManager::ConfigState state;
+    state.start(cfg.config_id, cfg.total_parts);
+
+    cfg.notched.button_base = 250; // Wraps onto pin 5
+    TEST_ASSERT_FALSE(state.addPart(cfg));
+    cfg.notched.button_base = 117; // Last notch on matrix pin 128
+    TEST_ASSERT_FALSE(state.addPart(cfg));
+    cfg.notched.button_base = 10; // Physical pins
+    TEST_ASSERT_FALSE(state.addPart(cfg));
+
+    cfg.notched.button_base = 116; // 116-127
+    TEST_ASSERT_TRUE(state.addPart(cfg));
+    cfg.notched.button_base = 0; // No buttons
+    TEST_ASSERT_TRUE(state.addPart(cfg));
+    TEST_ASSERT_TRUE(state.isComplete());
+}
+
+// Test that a stored calibration loads back
+void test_calibration_roundtrip()
+{
+    Sensor::Calibration cal;
+    cal.flags = Sensor::CALIBRATION_FLAG_VALID | Sensor::CALIBRATION_FLAG_CENTER;
+    cal.min = 40;
+    cal.max = 990;
+    cal.center = 512;
+
+    ConfigManager::storeCalibration(3, cal);
+
+    Sensor::Calibration loaded;
+    TEST_ASSERT_TRUE(ConfigManager::loadCalibration(3, loaded));
+    TEST_ASSERT_EQUAL_UINT8(cal.flags, loaded.flags);
+    TEST_ASSERT_EQUAL_UINT16(cal.min, loaded.min);
+    TEST_ASSERT_EQUAL_UINT16(cal.max, loaded.max);
+    TEST_ASSERT_EQUAL_UINT16(cal.center, loaded.center);
+
+    // Other inputs are unaffected
+    TEST_ASSERT_FALSE(ConfigManager::loadCalibration(2, loaded));
+    TEST_ASSERT_FALSE(loaded.isValid());
+}
+
+// Test that erased or corrupted calibration records are rejected
+void test_calibration_load_rejects_bad_record()
+{
+    // Erased EEPROM (setUp fills with 0xFF)
+    Sensor::Calibration loaded;
+    TEST_ASSERT_FALSE(ConfigManager::loadCalibration(0, loaded));
+
+    Sensor::Calibration cal;
+    cal.flags = Sensor::CALIBRATION_FLAG_VALID;
+    cal.min = 100;
+    cal.max = 900;
+    ConfigManager::storeCalibration(0, cal);
+
+    // Corrupt the max field
+    mock_eeprom_storage[ConfigManager::EEPROM_CALIBRATION_ADDR + 3] ^= 0x01;
+    TEST_ASSERT_FALSE(ConfigManager::loadCalibration(0, loaded));
+
+    // Out of range index
+    TEST_ASSERT_FALSE(ConfigManager::loadCalibration(ConfigManager::MAX_INPUTS, loaded));
+}
+
+// Test that clearing removes all calibrations
+void test_calibration_clear()
+{
+    Sensor::Calibration cal;
+    cal.flags = Sensor::CALIBRATION_FLAG_VALID;
+    cal.min = 100;
+    cal.max = 900;
+    ConfigManager::storeCalibration(0, cal);
+    ConfigManager::storeCalibration(ConfigManager::MAX_INPUTS - 1, cal);
+
+    ConfigManager::clearCalibrations();
+
+    Sensor::Calibration loaded;
+    TEST_ASSERT_FALSE(ConfigManager::loadCalibration(0, loaded));
+    TEST_ASSERT_FALSE(ConfigManager::loadCalibration(ConfigManager::MAX_INPUTS - 1, loaded));
+}
+
 int main()
 {
     UNITY_BEGIN();
@@ -168,6 +387,14 @@ int main()
     RUN_TEST(test_load_fails_with_mismatched_version);
     RUN_TEST(test_load_fails_with_no_magic);
     RUN_TEST(test_load_fails_with_invalid_num_inputs);
+    RUN_TEST(test_load_notched_input);
+    RUN_TEST(test_load_matrix_input);
+    RUN_TEST(test_load_encoder_input);
+    RUN_TEST(test_add_part_rejects_unordered_boundaries);
+    RUN_TEST(test_add_part_rejects_notch_button_range);
+    RUN_TEST(test_calibration_roundtrip);
+    RUN_TEST(test_calibration_load_rejects_bad_record);
+    RUN_TEST(test_calibration_clear);
 
     return UNITY_END();
 }
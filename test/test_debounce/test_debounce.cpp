@@ -0,0 +1,201 @@
+#include "../../src/debounce.h"
+#include <unity.h>
+
+using namespace Sensor;
+
+// Time in debounce ticks
+static uint16_t ms(unsigned long t)
+{
+    return debounceTicks(t * 1000UL);
+}
+
+// Test the conversion from the Configure settings
+void test_debounce_timing_from_ms()
+{
+    DebounceTiming integrated = DebounceTiming::fromMs(3, 0, 0);
+    TEST_ASSERT_FALSE(integrated.eager_press);
+    TEST_ASSERT_FALSE(integrated.eager_release);
+    TEST_ASSERT_EQUAL_UINT16(ms(3), integrated.press_ticks);
+    TEST_ASSERT_EQUAL_UINT16(ms(3), integrated.release_ticks);
+
+    DebounceTiming eager = DebounceTiming::fromMs(3, 20, 0);
+    TEST_ASSERT_TRUE(eager.eager_press);
+    TEST_ASSERT_FALSE(eager.eager_release);
+    TEST_ASSERT_EQUAL_UINT16(ms(20), eager.press_ticks);
+    TEST_ASSERT_EQUAL_UINT16(ms(3), eager.release_ticks);
+
+    // Longest setting still fits the 16-bit tick counter
+    TEST_ASSERT_EQUAL_UINT16(debounceTicks(255000UL), DebounceTiming::fromMs(255, 0, 0).press_ticks);
+}
+
+// Test that a new state counts once it has been read for the debounce time
+void test_debounce_integrate()
+{
+    DebounceTiming timing = DebounceTiming::fromMs(3, 0, 0);
+    Debouncer d;
+
+    TEST_ASSERT_EQUAL_UINT8(0, d.update(0x01, ms(0), timing));
+    TEST_ASSERT_EQUAL_UINT8(0, d.update(0x01, ms(2), timing));
+    TEST_ASSERT_EQUAL_UINT8(0x01, d.update(0x01, ms(3), timing));
+    TEST_ASSERT_EQUAL_UINT8(0x01, d.getState());
+
+    // Held: no more changes
+    TEST_ASSERT_EQUAL_UINT8(0, d.update(0x01, ms(10), timing));
+
+    // Release the same way
+    TEST_ASSERT_EQUAL_UINT8(0, d.update(0x00, ms(20), timing));
+    TEST_ASSERT_EQUAL_UINT8(0x01, d.update(0x00, ms(23), timing));
+    TEST_ASSERT_EQUAL_UINT8(0x00, d.getState());
+}
+
+// Test that a bounce back to the old state restarts the debounce time
+void test_debounce_bounce_restarts()
+{
+    DebounceTiming timing = DebounceTiming::fromMs(3, 0, 0);
+    Debouncer d;
+
+    d.update(0x01, ms(0), timing);
+    d.update(0x00, ms(1), timing);
+    d.update(0x01, ms(2), timing);
+    TEST_ASSERT_EQUAL_UINT8(0, d.update(0x01, ms(4), timing));
+    TEST_ASSERT_EQUAL_UINT8(0x01, d.update(0x01, ms(5), timing));
+}
+
+// Test eager edges: reported at once, then ignored for the lockout
+void test_debounce_eager_lockout()
+{
+    DebounceTiming timing = DebounceTiming::fromMs(3, 10, 10);
+    Debouncer d;
+
+    TEST_ASSERT_EQUAL_UINT8(0x01, d.update(0x01, ms(0), timing));
+
+    // Bounces inside the lockout are ignored
+    TEST_ASSERT_EQUAL_UINT8(0, d.update(0x00, ms(1), timing));
+    TEST_ASSERT_EQUAL_UINT8(0, d.update(0x01, ms(2), timing));
+    TEST_ASSERT_EQUAL_UINT8(0, d.update(0x00, ms(9), timing));
+    TEST_ASSERT_EQUAL_UINT8(0x01, d.getState());
+
+    // Released when the lockout ends: reported at once
+    TEST_ASSERT_EQUAL_UINT8(0x01, d.update(0x00, ms(10), timing));
+    TEST_ASSERT_EQUAL_UINT8(0x00, d.getState());
+}
+
+// Test an eager press with an integrated release
+void test_debounce_asymmetric()
+{
+    DebounceTiming timing = DebounceTiming::fromMs(5, 2, 0);
+    Debouncer d;
+
+    TEST_ASSERT_EQUAL_UINT8(0x01, d.update(0x01, ms(0), timing));
+
+    // Release integrates over the 5 ms debounce time, even a short blip
+    TEST_ASSERT_EQUAL_UINT8(0, d.update(0x00, ms(3), timing));
+    TEST_ASSERT_EQUAL_UINT8(0, d.update(0x01, ms(4), timing));
+    TEST_ASSERT_EQUAL_UINT8(0, d.update(0x00, ms(5), timing));
+    TEST_ASSERT_EQUAL_UINT8(0, d.update(0x00, ms(9), timing));
+    TEST_ASSERT_EQUAL_UINT8(0x01, d.update(0x00, ms(10), timing));
+}
+
+// Test that each input of a group is timed on its own
+void test_debounce_group_inputs_independent()
+{
+    DebounceTiming timing = DebounceTiming::fromMs(3, 0, 0);
+    Debouncer d;
+
+    // Input 1 joins at 1.5 ms: input 0 commits at 3 ms, input 1 at least 3 ms
+    // after it joined
+    d.update(0x01, ms(0), timing);
+    TEST_ASSERT_EQUAL_UINT8(0, d.update(0x03, debounceTicks(1500), timing));
+    TEST_ASSERT_EQUAL_UINT8(0x01, d.update(0x03, ms(3), timing));
+    TEST_ASSERT_EQUAL_UINT8(0, d.update(0x03, debounceTicks(4500), timing));
+    TEST_ASSERT_EQUAL_UINT8(0x02, d.update(0x03, ms(5), timing));
+
+    // An input that bounces back drops out without delaying the others
+    d.update(0x0F, ms(10), timing);
+    d.update(0x07, ms(11), timing);
+    TEST_ASSERT_EQUAL_UINT8(0x04, d.update(0x07, ms(13), timing));
+    TEST_ASSERT_EQUAL_UINT8(0x07, d.getState());
+}
+
+// Test that an input chattering on every read doesn't hold back a held one
+void test_debounce_chatter_doesnt_block_group()
+{
+    DebounceTiming timing = DebounceTiming::fromMs(3, 0, 0);
+    Debouncer d;
+
+    // Input 0 held from 0 ms, input 1 toggling every 1 ms scan
+    uint8_t changed = 0;
+    for (unsigned long t = 0; t <= 10; t++) {
+        changed |= d.update((uint8_t)(0x01 | ((t & 1) ? 0x02 : 0x00)), ms(t), timing);
+        if (t < 3) {
+            TEST_ASSERT_EQUAL_UINT8(0, d.getState());
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT8(0x01, changed);
+    TEST_ASSERT_EQUAL_UINT8(0x01, d.getState());
+}
+
+// Test restarting the debounce time from an edge seen by an interrupt
+void test_debounce_restart()
+{
+    DebounceTiming timing = DebounceTiming::fromMs(3, 0, 0);
+    Debouncer d;
+
+    // Edge at 2 ms, first read at 4 ms: stable since the edge
+    d.restart(ms(2));
+    TEST_ASSERT_EQUAL_UINT8(0, d.update(0x01, ms(4), timing));
+    TEST_ASSERT_EQUAL_UINT8(0x01, d.update(0x01, ms(5), timing));
+
+    // Edge long before the read: stable at once
+    d.restart(ms(10));
+    TEST_ASSERT_EQUAL_UINT8(0x01, d.update(0x00, ms(20), timing));
+}
+
+// Test that the 16-bit tick timestamps wrap around
+void test_debounce_wraparound()
+{
+    DebounceTiming timing = DebounceTiming::fromMs(3, 10, 0);
+    Debouncer d;
+    uint16_t start = 0xFFFF - ms(1);
+
+    TEST_ASSERT_EQUAL_UINT8(0x01, d.update(0x01, start, timing));
+    TEST_ASSERT_EQUAL_UINT8(0, d.update(0x00, (uint16_t)(start + ms(9)), timing));
+    TEST_ASSERT_EQUAL_UINT8(0, d.update(0x00, (uint16_t)(start + ms(12)), timing));
+    TEST_ASSERT_EQUAL_UINT8(0x01, d.update(0x00, (uint16_t)(start + ms(15)), timing));
+}
+
+// Test that reset() forgets all state
+void test_debounce_reset()
+{
+    DebounceTiming timing = DebounceTiming::fromMs(3, 10, 0);
+    Debouncer d;
+
+    d.update(0x01, ms(0), timing);
+    d.reset();
+    TEST_ASSERT_EQUAL_UINT8(0, d.getState());
+
+    // Not locked any more
+    TEST_ASSERT_EQUAL_UINT8(0x01, d.update(0x01, ms(1), timing));
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_debounce_timing_from_ms);
+    RUN_TEST(test_debounce_integrate);
+    RUN_TEST(test_debounce_bounce_restarts);
+    RUN_TEST(test_debounce_eager_lockout);
+    RUN_TEST(test_debounce_asymmetric);
+    RUN_TEST(test_debounce_group_inputs_independent);
+    RUN_TEST(test_debounce_chatter_doesnt_block_group);
+    RUN_TEST(test_debounce_restart);
+    RUN_TEST(test_debounce_wraparound);
+    RUN_TEST(test_debounce_reset);
+
+    return UNITY_END();
+}
@@ -0,0 +1,272 @@
+// Mock Arduino environment for native testing
+#include <stdint.h>
+
+// Arduino pin definitions
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define LOW 0
+#define HIGH 1
+#define CHANGE 1
+#define NOT_AN_INTERRUPT -1
+
+// Mock Arduino functions
+static int g_mock_pin_values[32]; // Pin levels (HIGH at rest, due to INPUT_PULLUP)
+static uint8_t g_mock_pin_modes[32];
+
+// Mock interrupt state: pins 2 and 3 support interrupts (like an Uno)
+static void (*g_mock_isr[2])() = { nullptr, nullptr };
+static unsigned long g_mock_micros = 0;
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    g_mock_pin_modes[pin] = mode;
+}
+
+int digitalRead(uint8_t pin)
+{
+    return g_mock_pin_values[pin];
+}
+
+unsigned long micros()
+{
+    return g_mock_micros;
+}
+
+int digitalPinToInterrupt(uint8_t pin)
+{
+    return (pin == 2 || pin == 3) ? pin - 2 : NOT_AN_INTERRUPT;
+}
+
+void attachInterrupt(uint8_t interrupt, void (*callback)(), int mode)
+{
+    (void)mode;
+    g_mock_isr[interrupt] = callback;
+}
+
+void detachInterrupt(uint8_t interrupt)
+{
+    g_mock_isr[interrupt] = nullptr;
+}
+
+void noInterrupts() { }
+void interrupts() { }
+
+// Now include the sensor code (include .cpp directly since we provide mocks above)
+#include "../../src/sensor.h"
+#include "../../src/encoder_sensor.cpp"
+#include <unity.h>
+
+using namespace Sensor;
+
+// Pin levels of one forward cycle (A leads B), starting after both HIGH
+static const uint8_t FORWARD[4] = { 0x01, 0x00, 0x02, 0x03 };
+static const uint8_t BACKWARD[4] = { 0x02, 0x00, 0x01, 0x03 };
+
+// Helper to take the next reported reading from the device-wide ring
+Reading nextReading()
+{
+    Reading reading;
+    InputEvents::pop(reading);
+    return reading;
+}
+
+// Helper to set both pins, firing the interrupt of each pin that changed
+void setPins(uint8_t pin_a, uint8_t pin_b, uint8_t ab)
+{
+    int a = (ab & 0x02) ? HIGH : LOW;
+    int b = (ab & 0x01) ? HIGH : LOW;
+    bool a_changed = g_mock_pin_values[pin_a] != a;
+    bool b_changed = g_mock_pin_values[pin_b] != b;
+    g_mock_pin_values[pin_a] = a;
+    g_mock_pin_values[pin_b] = b;
+    if (a_changed && digitalPinToInterrupt(pin_a) != NOT_AN_INTERRUPT && g_mock_isr[digitalPinToInterrupt(pin_a)]) {
+        g_mock_isr[digitalPinToInterrupt(pin_a)]();
+    }
+    if (b_changed && digitalPinToInterrupt(pin_b) != NOT_AN_INTERRUPT && g_mock_isr[digitalPinToInterrupt(pin_b)]) {
+        g_mock_isr[digitalPinToInterrupt(pin_b)]();
+    }
+}
+
+// Helper to turn by whole detents (negative = backward), 1 ms per step
+void turn(uint8_t pin_a, uint8_t pin_b, int detents, unsigned long step_us = 1000)
+{
+    const uint8_t* cycle = detents < 0 ? BACKWARD : FORWARD;
+    for (int i = 0; i < (detents < 0 ? -detents : detents); i++) {
+        for (int s = 0; s < 4; s++) {
+            setPins(pin_a, pin_b, cycle[s]);
+            g_mock_micros += step_us;
+        }
+    }
+}
+
+// Test that begin() enables the pullups and attaches both interrupts
+void test_encoder_sensor_begin()
+{
+    EncoderSensor sensor(2, 3);
+    sensor.begin();
+
+    TEST_ASSERT_EQUAL(InputType::Encoder, sensor.getType());
+    TEST_ASSERT_EQUAL(2, sensor.getPin());
+    TEST_ASSERT_EQUAL(INPUT_PULLUP, g_mock_pin_modes[2]);
+    TEST_ASSERT_EQUAL(INPUT_PULLUP, g_mock_pin_modes[3]);
+    TEST_ASSERT_TRUE(sensor.usesInterrupt());
+    TEST_ASSERT_NOT_NULL(g_mock_isr[0]);
+    TEST_ASSERT_NOT_NULL(g_mock_isr[1]);
+}
+
+// Test that interrupts are detached when the sensor is destroyed
+void test_encoder_sensor_detached_on_destroy()
+{
+    {
+        EncoderSensor sensor(2, 3);
+        sensor.begin();
+    }
+    TEST_ASSERT_NULL(g_mock_isr[0]);
+    TEST_ASSERT_NULL(g_mock_isr[1]);
+}
+
+// Test that steps between scans are decoded by interrupt and reported as one delta
+void test_encoder_sensor_interrupt_delta()
+{
+    EncoderSensor sensor(2, 3);
+    sensor.begin();
+
+    sensor.scan();
+    TEST_ASSERT_FALSE(nextReading().has_value);
+
+    // Three detents without a scan in between: nothing is missed
+    turn(2, 3, 3);
+    unsigned long last_detent_us = g_mock_micros - 1000;
+    sensor.scan();
+
+    Reading r = nextReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(InputType::Encoder, r.type);
+    TEST_ASSERT_EQUAL(2, r.pin);
+    TEST_ASSERT_EQUAL(3, r.value);
+    TEST_ASSERT_EQUAL_UINT32(last_detent_us, r.time_us);
+    TEST_ASSERT_FALSE(nextReading().has_value);
+
+    // Backward
+    g_mock_micros += EncoderSensor::REPORT_INTERVAL_US;
+    turn(2, 3, -2);
+    sensor.scan();
+    TEST_ASSERT_EQUAL(-2, nextReading().value);
+}
+
+// Test that pins without an interrupt are decoded by polling
+void test_encoder_sensor_polling_fallback()
+{
+    EncoderSensor sensor(6, 7, 1);
+    sensor.begin();
+    TEST_ASSERT_FALSE(sensor.usesInterrupt());
+
+    // Steps 1 ms apart, a scan after each
+    for (int s = 0; s < 4; s++) {
+        setPins(6, 7, FORWARD[s]);
+        sensor.scan();
+        g_mock_micros += EncoderSensor::REPORT_INTERVAL_US;
+    }
+
+    int total = 0;
+    Reading r;
+    while (InputEvents::pop(r)) {
+        total += r.value;
+    }
+    TEST_ASSERT_EQUAL(4, total); // 1 step per detent
+}
+
+// Test that reports are spaced by the report interval
+void test_encoder_sensor_report_interval()
+{
+    EncoderSensor sensor(2, 3);
+    sensor.begin();
+
+    turn(2, 3, 1);
+    sensor.scan();
+    TEST_ASSERT_EQUAL(1, nextReading().value);
+
+    // Next detent comes too soon: held back, then sent with the following one
+    turn(2, 3, 1);
+    sensor.scan();
+    TEST_ASSERT_FALSE(nextReading().has_value);
+
+    turn(2, 3, 1);
+    g_mock_micros += EncoderSensor::REPORT_INTERVAL_US;
+    sensor.scan();
+    TEST_ASSERT_EQUAL(2, nextReading().value);
+}
+
+// Test that turning fast adds counts, and the first detent after a pause doesn't
+void test_encoder_sensor_acceleration()
+{
+    EncoderSensor sensor(2, 3, 4, 10);
+    sensor.begin();
+
+    // First detent: counts 1
+    turn(2, 3, 1);
+    sensor.scan();
+    TEST_ASSERT_EQUAL(1, nextReading().value);
+
+    // 4 detents, 4 ms apart: 1 + 10 * 96 / 100 = 10 counts each
+    turn(2, 3, 4);
+    g_mock_micros += EncoderSensor::REPORT_INTERVAL_US;
+    sensor.scan();
+    TEST_ASSERT_EQUAL(4 * 10, nextReading().value);
+
+    // Slow detent: 1 again
+    g_mock_micros += 2 * ENCODER_ACCEL_SLOW_US;
+    turn(2, 3, 1);
+    sensor.scan();
+    TEST_ASSERT_EQUAL(1, nextReading().value);
+}
+
+// Test that detents stay pending while the ring is full
+void test_encoder_sensor_ring_full_retries()
+{
+    EncoderSensor sensor(2, 3);
+    sensor.begin();
+
+    for (int i = 0; i < InputEvents::RING_SIZE; i++) {
+        InputEvents::push(Reading(0, InputType::Button, 9, 0));
+    }
+
+    turn(2, 3, 2);
+    sensor.scan();
+
+    InputEvents::clear();
+    turn(2, 3, 1);
+    g_mock_micros += EncoderSensor::REPORT_INTERVAL_US;
+    sensor.scan();
+    TEST_ASSERT_EQUAL(3, nextReading().value);
+}
+
+void setUp(void)
+{
+    for (int i = 0; i < 32; i++) {
+        g_mock_pin_values[i] = HIGH;
+        g_mock_pin_modes[i] = INPUT;
+    }
+    g_mock_isr[0] = nullptr;
+    g_mock_isr[1] = nullptr;
+    g_mock_micros = 1000;
+    InputEvents::clear();
+}
+
+void tearDown(void) {}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_encoder_sensor_begin);
+    RUN_TEST(test_encoder_sensor_detached_on_destroy);
+    RUN_TEST(test_encoder_sensor_interrupt_delta);
+    RUN_TEST(test_encoder_sensor_polling_fallback);
+    RUN_TEST(test_encoder_sensor_report_interval);
+    RUN_TEST(test_encoder_sensor_acceleration);
+    RUN_TEST(test_encoder_sensor_ring_full_retries);
+
+    return UNITY_END();
+}
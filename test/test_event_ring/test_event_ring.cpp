@@ -0,0 +1,160 @@
+#include "../../src/event_ring.h"
+#include "../../src/sensor.h"
+#include <unity.h>
+
+using namespace Sensor;
+
+// Test that a new ring is empty
+void test_event_ring_initially_empty()
+{
+    EventRing<uint8_t, 8> ring;
+    uint8_t value;
+
+    TEST_ASSERT_TRUE(ring.empty());
+    TEST_ASSERT_FALSE(ring.full());
+    TEST_ASSERT_EQUAL(0, ring.size());
+    TEST_ASSERT_FALSE(ring.pop(value));
+}
+
+// Test first-in first-out ordering
+void test_event_ring_fifo_order()
+{
+    EventRing<uint8_t, 8> ring;
+
+    TEST_ASSERT_TRUE(ring.push(1));
+    TEST_ASSERT_TRUE(ring.push(2));
+    TEST_ASSERT_TRUE(ring.push(3));
+    TEST_ASSERT_EQUAL(3, ring.size());
+
+    uint8_t value;
+    TEST_ASSERT_TRUE(ring.pop(value));
+    TEST_ASSERT_EQUAL(1, value);
+    TEST_ASSERT_TRUE(ring.pop(value));
+    TEST_ASSERT_EQUAL(2, value);
+    TEST_ASSERT_TRUE(ring.pop(value));
+    TEST_ASSERT_EQUAL(3, value);
+    TEST_ASSERT_TRUE(ring.empty());
+}
+
+// Test that push fails when full and keeps existing elements
+void test_event_ring_full_rejects_push()
+{
+    EventRing<uint8_t, 4> ring;
+
+    for (uint8_t i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(ring.push(i));
+    }
+    TEST_ASSERT_TRUE(ring.full());
+    TEST_ASSERT_FALSE(ring.push(99));
+
+    // Oldest element is still first
+    uint8_t value;
+    TEST_ASSERT_TRUE(ring.pop(value));
+    TEST_ASSERT_EQUAL(0, value);
+
+    // Room for one more now
+    TEST_ASSERT_TRUE(ring.push(4));
+    TEST_ASSERT_FALSE(ring.push(5));
+}
+
+// Test that the 8-bit counters wrap correctly over many cycles
+void test_event_ring_counter_wraparound()
+{
+    EventRing<uint16_t, 8> ring;
+    uint16_t expected = 0;
+    uint16_t next = 0;
+
+    // Push 3, pop 3, 1000 times - counters wrap past 255 many times
+    for (int cycle = 0; cycle < 1000; cycle++) {
+        for (int i = 0; i < 3; i++) {
+            TEST_ASSERT_TRUE(ring.push(next++));
+        }
+        for (int i = 0; i < 3; i++) {
+            uint16_t value;
+            TEST_ASSERT_TRUE(ring.pop(value));
+            TEST_ASSERT_EQUAL(expected++, value);
+        }
+    }
+    TEST_ASSERT_TRUE(ring.empty());
+}
+
+// Test filling to capacity across the wrap point
+void test_event_ring_full_across_wrap()
+{
+    EventRing<uint8_t, 128> ring;
+    uint8_t value;
+
+    // Move counters near the 8-bit wrap point
+    for (int i = 0; i < 250; i++) {
+        ring.push((uint8_t)i);
+        ring.pop(value);
+    }
+
+    for (int i = 0; i < 128; i++) {
+        TEST_ASSERT_TRUE(ring.push((uint8_t)i));
+    }
+    TEST_ASSERT_TRUE(ring.full());
+    TEST_ASSERT_EQUAL(128, ring.size());
+    TEST_ASSERT_FALSE(ring.push(0));
+
+    for (int i = 0; i < 128; i++) {
+        TEST_ASSERT_TRUE(ring.pop(value));
+        TEST_ASSERT_EQUAL(i, value);
+    }
+    TEST_ASSERT_TRUE(ring.empty());
+}
+
+// Test clearing the ring
+void test_event_ring_clear()
+{
+    EventRing<uint8_t, 8> ring;
+    ring.push(1);
+    ring.push(2);
+
+    ring.clear();
+
+    uint8_t value;
+    TEST_ASSERT_TRUE(ring.empty());
+    TEST_ASSERT_FALSE(ring.pop(value));
+}
+
+// Test storing sensor readings (the type used by InputEvents)
+void test_event_ring_sensor_readings()
+{
+    EventRing<Reading, 4> ring;
+
+    ring.push(Reading(512, InputType::Analog, 14, 1000));
+    ring.push(Reading(1, InputType::Button, 7, 1250));
+
+    Reading r;
+    TEST_ASSERT_TRUE(ring.pop(r));
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(512, r.value);
+    TEST_ASSERT_EQUAL(InputType::Analog, r.type);
+    TEST_ASSERT_EQUAL(14, r.pin);
+    TEST_ASSERT_EQUAL_UINT32(1000, r.time_us);
+
+    TEST_ASSERT_TRUE(ring.pop(r));
+    TEST_ASSERT_EQUAL(1, r.value);
+    TEST_ASSERT_EQUAL(InputType::Button, r.type);
+    TEST_ASSERT_EQUAL(7, r.pin);
+    TEST_ASSERT_EQUAL_UINT32(1250, r.time_us);
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_event_ring_initially_empty);
+    RUN_TEST(test_event_ring_fifo_order);
+    RUN_TEST(test_event_ring_full_rejects_push);
+    RUN_TEST(test_event_ring_counter_wraparound);
+    RUN_TEST(test_event_ring_full_across_wrap);
+    RUN_TEST(test_event_ring_clear);
+    RUN_TEST(test_event_ring_sensor_readings);
+
+    return UNITY_END();
+}
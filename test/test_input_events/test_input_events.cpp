@@ -0,0 +1,90 @@
+#include "../../src/input_events.h"
+#include <unity.h>
+
+using namespace Sensor;
+
+// Test that readings come out in order, with their timestamps
+void test_input_events_fifo_order()
+{
+    TEST_ASSERT_TRUE(InputEvents::push(Reading(1, InputType::Button, 4, 100)));
+    TEST_ASSERT_TRUE(InputEvents::push(Reading(700, InputType::Analog, 14, 250)));
+
+    Reading r;
+    TEST_ASSERT_TRUE(InputEvents::pop(r));
+    TEST_ASSERT_EQUAL(InputType::Button, r.type);
+    TEST_ASSERT_EQUAL(4, r.pin);
+    TEST_ASSERT_EQUAL_UINT32(100, r.time_us);
+
+    TEST_ASSERT_TRUE(InputEvents::pop(r));
+    TEST_ASSERT_EQUAL(700, r.value);
+    TEST_ASSERT_EQUAL_UINT32(250, r.time_us);
+
+    TEST_ASSERT_FALSE(InputEvents::pop(r));
+}
+
+// Test that a full ring rejects readings and counts them
+void test_input_events_overflow_counted()
+{
+    uint16_t before = InputEvents::getOverflowCount();
+
+    for (int i = 0; i < InputEvents::RING_SIZE; i++) {
+        TEST_ASSERT_TRUE(InputEvents::push(Reading(i, InputType::Matrix, 0, i)));
+    }
+    TEST_ASSERT_FALSE(InputEvents::push(Reading(-1, InputType::Matrix, 0, 0)));
+    TEST_ASSERT_FALSE(InputEvents::push(Reading(-1, InputType::Matrix, 0, 0)));
+    TEST_ASSERT_EQUAL_UINT16(before + 2, InputEvents::getOverflowCount());
+
+    // The readings already queued are kept
+    Reading r;
+    TEST_ASSERT_TRUE(InputEvents::pop(r));
+    TEST_ASSERT_EQUAL(0, r.value);
+
+    // Room again
+    TEST_ASSERT_TRUE(InputEvents::push(Reading(1, InputType::Matrix, 0, 0)));
+    TEST_ASSERT_EQUAL_UINT16(before + 2, InputEvents::getOverflowCount());
+}
+
+// Test that hasRoom() tracks the free space
+void test_input_events_has_room()
+{
+    TEST_ASSERT_TRUE(InputEvents::hasRoom(InputEvents::RING_SIZE));
+    for (int i = 0; i < InputEvents::RING_SIZE - 2; i++) {
+        InputEvents::push(Reading(i, InputType::Button, 0, 0));
+    }
+    TEST_ASSERT_TRUE(InputEvents::hasRoom(2));
+    TEST_ASSERT_FALSE(InputEvents::hasRoom(3));
+
+    Reading r;
+    InputEvents::pop(r);
+    TEST_ASSERT_TRUE(InputEvents::hasRoom(3));
+}
+
+// Test that clear() empties the ring but keeps the overflow count
+void test_input_events_clear()
+{
+    for (int i = 0; i <= InputEvents::RING_SIZE; i++) {
+        InputEvents::push(Reading(i, InputType::Button, 0, 0));
+    }
+    uint16_t overflows = InputEvents::getOverflowCount();
+
+    InputEvents::clear();
+
+    Reading r;
+    TEST_ASSERT_FALSE(InputEvents::pop(r));
+    TEST_ASSERT_EQUAL_UINT16(overflows, InputEvents::getOverflowCount());
+}
+
+void setUp(void) { InputEvents::clear(); }
+void tearDown(void) {}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_input_events_fifo_order);
+    RUN_TEST(test_input_events_overflow_counted);
+    RUN_TEST(test_input_events_has_room);
+    RUN_TEST(test_input_events_clear);
+
+    return UNITY_END();
+}
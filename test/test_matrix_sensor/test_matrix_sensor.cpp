@@ -9,12 +9,24 @@
 #define LOW 0
 #define HIGH 1
 
+// Scan through mock port registers (8 pins per port, like AVR)
+#define MATRIX_PORT_IO_MOCK
+
 // Mock matrix state: which buttons are pressed
 // For a 3x4 matrix, buttons[row][col] = true means button pressed
 static bool g_button_pressed[8][8];
 static uint8_t g_pin_state[32]; // Pin states (supports pins 0-31)
 static uint8_t g_row_pin_start = 2;
-static uint8_t g_col_pin_start = 5;
+static uint8_t g_col_pins[8] = { 5, 6, 7, 8, 9, 10, 11, 12 }; // Column index -> pin
+static volatile uint8_t g_port_out[4]; // Output registers (pins 0-31)
+static volatile uint8_t g_port_in[4]; // Input registers (pins 0-31)
+static int g_digital_reads = 0; // digitalRead() calls (the port path makes none)
+static unsigned long g_mock_micros = 0;
+static unsigned long g_micros_step = 0; // Time that passes per micros() call
+static unsigned long g_delay_total = 0; // Sum of delayMicroseconds() calls
+static uint8_t g_max_driven = 0; // Most pins driven LOW at once during a delay
+static uint8_t g_diodes = 2; // 0 = cathodes on rows, 1 = cathodes on columns, 2 = no diodes
+static bool g_sneak_paths = false; // No diodes: current also flows on through other pressed keys
 
 void pinMode(uint8_t pin, uint8_t mode)
 {
@@ -22,37 +34,154 @@ void pinMode(uint8_t pin, uint8_t mode)
     (void)mode;
 }
 
-void digitalWrite(uint8_t pin, uint8_t val)
+// Level of a pin when current flows through any chain of pressed keys
+// (a LOW line pulls every line it is connected to LOW, which makes ghosts)
+static uint8_t sneakPathLevel(uint8_t pin)
 {
-    if (pin < 32) {
-        g_pin_state[pin] = val;
+    bool low_row[8];
+    bool low_col[8];
+    for (uint8_t i = 0; i < 8; i++) {
+        low_row[i] = g_row_pin_start + i < 32 && g_pin_state[g_row_pin_start + i] == LOW;
+        low_col[i] = g_col_pins[i] < 32 && g_pin_state[g_col_pins[i]] == LOW;
+    }
+
+    bool spread = true;
+    while (spread) {
+        spread = false;
+        for (uint8_t row = 0; row < 8; row++) {
+            for (uint8_t col = 0; col < 8; col++) {
+                if (g_button_pressed[row][col] && low_row[row] != low_col[col]) {
+                    low_row[row] = low_col[col] = true;
+                    spread = true;
+                }
+            }
+        }
     }
+
+    for (uint8_t i = 0; i < 8; i++) {
+        if ((pin == g_row_pin_start + i && low_row[i]) || (pin == g_col_pins[i] && low_col[i])) {
+            return LOW;
+        }
+    }
+    return HIGH;
 }
 
-int digitalRead(uint8_t pin)
+// Level of a pin as the matrix wiring makes it
+static uint8_t pinLevel(uint8_t pin)
 {
-    // Simulate matrix scanning
-    // When a row pin is LOW and a button is pressed, the column reads LOW
+    if (g_sneak_paths) {
+        return sneakPathLevel(pin);
+    }
+
+    // A pressed button connects its row and column: a LOW row pulls the column
+    // LOW and a LOW column pulls the row LOW, unless a diode blocks it
     for (uint8_t row = 0; row < 8; row++) {
         uint8_t row_pin = g_row_pin_start + row;
-        // Check if this row is active (LOW)
-        if (row_pin < 32 && g_pin_state[row_pin] == LOW) {
-            // Check all columns for this row
-            for (uint8_t col = 0; col < 8; col++) {
-                uint8_t col_pin = g_col_pin_start + col;
-                // If reading this column pin and button is pressed
-                if (pin == col_pin && g_button_pressed[row][col]) {
-                    return LOW;
-                }
+        for (uint8_t col = 0; col < 8; col++) {
+            uint8_t col_pin = g_col_pins[col];
+            if (!g_button_pressed[row][col] || row_pin >= 32 || col_pin >= 32) {
+                continue;
+            }
+            if (pin == col_pin && g_diodes != 1 && g_pin_state[row_pin] == LOW) {
+                return LOW;
+            }
+            if (pin == row_pin && g_diodes != 0 && g_pin_state[col_pin] == LOW) {
+                return LOW;
             }
         }
     }
     return HIGH; // No button pressed (pullup)
 }
 
+// Update row pin states from the output registers, then the input registers
+static void updatePorts()
+{
+    for (uint8_t pin = 0; pin < 32; pin++) {
+        g_pin_state[pin] = (g_port_out[pin / 8] >> (pin % 8)) & 0x01;
+    }
+    for (uint8_t pin = 0; pin < 32; pin++) {
+        uint8_t bit = (uint8_t)(1 << (pin % 8));
+        if (pinLevel(pin) == HIGH) {
+            g_port_in[pin / 8] |= bit;
+        } else {
+            g_port_in[pin / 8] &= (uint8_t)~bit;
+        }
+    }
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+    if (pin < 32) {
+        uint8_t bit = (uint8_t)(1 << (pin % 8));
+        if (val == LOW) {
+            g_port_out[pin / 8] &= (uint8_t)~bit;
+        } else {
+            g_port_out[pin / 8] |= bit;
+        }
+        updatePorts();
+    }
+}
+
+int digitalRead(uint8_t pin)
+{
+    g_digital_reads++;
+    return pinLevel(pin);
+}
+
+unsigned long micros()
+{
+    g_mock_micros += g_micros_step;
+    return g_mock_micros;
+}
+
 void delayMicroseconds(unsigned int us)
 {
-    (void)us; // No-op in tests
+    g_mock_micros += us;
+    g_delay_total += us;
+
+    uint8_t active = 0;
+    for (uint8_t pin = 0; pin < 32; pin++) {
+        if (g_pin_state[pin] == LOW) {
+            active++;
+        }
+    }
+    if (active > g_max_driven) {
+        g_max_driven = active;
+    }
+}
+
+// Port register accessors used by MatrixSensor with MATRIX_PORT_IO_MOCK
+bool rowPort(uint8_t pin, volatile uint8_t*& clear_reg, volatile uint8_t*& set_reg, uint8_t& mask)
+{
+    if (pin >= 32) {
+        return false;
+    }
+    clear_reg = &g_port_out[pin / 8];
+    set_reg = clear_reg;
+    mask = (uint8_t)(1 << (pin % 8));
+    return true;
+}
+
+bool columnPort(uint8_t pin, const volatile uint8_t*& in_reg, uint8_t& mask)
+{
+    if (pin >= 32) {
+        return false;
+    }
+    in_reg = &g_port_in[pin / 8];
+    mask = (uint8_t)(1 << (pin % 8));
+    return true;
+}
+
+void driveRowLow(volatile uint8_t* reg, uint8_t mask)
+{
+    *reg &= (uint8_t)~mask;
+    updatePorts();
+}
+
+void driveRowHigh(volatile uint8_t* reg, uint8_t mask)
+{
+    *reg |= mask;
+    updatePorts();
 }
 
 // Now include the sensor code
@@ -62,20 +191,47 @@ void delayMicroseconds(unsigned int us)
 
 using namespace Sensor;
 
+// Helper to take the next reported reading from the device-wide ring
+Reading nextReading()
+{
+    Reading reading;
+    InputEvents::pop(reading);
+    return reading;
+}
+
+// Helper to configure mock pin mapping (consecutive row and column pins)
+void setMockPinMapping(uint8_t row_start, uint8_t col_start)
+{
+    g_row_pin_start = row_start;
+    for (uint8_t c = 0; c < 8; c++) {
+        g_col_pins[c] = col_start + c;
+    }
+}
+
 // Helper to reset mock state
 void resetMockState()
 {
     memset(g_button_pressed, false, sizeof(g_button_pressed));
     memset(g_pin_state, HIGH, sizeof(g_pin_state));
-    g_row_pin_start = 2;
-    g_col_pin_start = 5;
+    memset((void*)g_port_out, 0xFF, sizeof(g_port_out));
+    memset((void*)g_port_in, 0xFF, sizeof(g_port_in));
+    g_digital_reads = 0;
+    g_mock_micros = 0;
+    g_micros_step = 0;
+    g_delay_total = 0;
+    g_max_driven = 0;
+    g_diodes = 2;
+    g_sneak_paths = false;
+    setMockPinMapping(2, 5);
 }
 
-// Helper to configure mock pin mapping
-void setMockPinMapping(uint8_t row_start, uint8_t col_start)
+// Helper to scan every 1 ms, like the main loop
+void scanTicks(MatrixSensor& sensor, int scans)
 {
-    g_row_pin_start = row_start;
-    g_col_pin_start = col_start;
+    for (int i = 0; i < scans; i++) {
+        sensor.scan();
+        g_mock_micros += 1000;
+    }
 }
 
 // Helper to press a button
@@ -111,7 +267,7 @@ void test_matrix_sensor_no_reading_initially()
 
     sensor.scan();
 
-    Reading r = sensor.getReading();
+    Reading r = nextReading();
     TEST_ASSERT_FALSE(r.has_value);
 }
 
@@ -126,19 +282,18 @@ void test_matrix_sensor_single_button_press()
     // Press button at row 1, col 2
     pressButton(1, 2);
 
-    // Scan 2 times (less than debounce threshold of 3)
-    sensor.scan();
-    sensor.scan();
+    // Pressed for 2 ms (less than the 3 ms default debounce)
+    scanTicks(sensor, 3);
 
     // Should NOT have reading yet
-    Reading r1 = sensor.getReading();
+    Reading r1 = nextReading();
     TEST_ASSERT_FALSE(r1.has_value);
 
-    // Scan one more time (completes debounce)
+    // Scan at 3 ms (completes debounce)
     sensor.scan();
 
     // Should have reading now
-    Reading r2 = sensor.getReading();
+    Reading r2 = nextReading();
     TEST_ASSERT_TRUE(r2.has_value);
     TEST_ASSERT_EQUAL(1, r2.value); // 1 = pressed
     TEST_ASSERT_EQUAL(InputType::Matrix, r2.type);
@@ -156,17 +311,17 @@ void test_matrix_sensor_virtual_pin_calculation()
 
     // Press button at row 0, col 0
     pressButton(0, 0);
-    for (int i = 0; i < 3; i++) sensor.scan();
-    Reading r1 = sensor.getReading();
+    scanTicks(sensor, 4);
+    Reading r1 = nextReading();
     TEST_ASSERT_EQUAL(128, r1.pin); // 128 + (0*4 + 0)
     releaseButton(0, 0);
-    for (int i = 0; i < 3; i++) sensor.scan();
-    sensor.getReading(); // Consume release
+    scanTicks(sensor, 4);
+    nextReading(); // Consume release
 
     // Press button at row 2, col 3
     pressButton(2, 3);
-    for (int i = 0; i < 3; i++) sensor.scan();
-    Reading r2 = sensor.getReading();
+    scanTicks(sensor, 4);
+    Reading r2 = nextReading();
     TEST_ASSERT_EQUAL(139, r2.pin); // 128 + (2*4 + 3) = 139
 }
 
@@ -180,14 +335,14 @@ void test_matrix_sensor_button_release()
 
     // Press button
     pressButton(0, 0);
-    for (int i = 0; i < 3; i++) sensor.scan();
-    sensor.getReading(); // Consume press
+    scanTicks(sensor, 4);
+    nextReading(); // Consume press
 
     // Release button
     releaseButton(0, 0);
-    for (int i = 0; i < 3; i++) sensor.scan();
+    scanTicks(sensor, 4);
 
-    Reading r = sensor.getReading();
+    Reading r = nextReading();
     TEST_ASSERT_TRUE(r.has_value);
     TEST_ASSERT_EQUAL(0, r.value); // 0 = released
     TEST_ASSERT_EQUAL(128, r.pin);
@@ -206,14 +361,14 @@ void test_matrix_sensor_nkro()
     pressButton(1, 1);
 
     // Scan past debounce
-    for (int i = 0; i < 3; i++) sensor.scan();
+    scanTicks(sensor, 4);
 
     // Should get two separate press events
-    Reading r1 = sensor.getReading();
+    Reading r1 = nextReading();
     TEST_ASSERT_TRUE(r1.has_value);
     TEST_ASSERT_EQUAL(1, r1.value);
 
-    Reading r2 = sensor.getReading();
+    Reading r2 = nextReading();
     TEST_ASSERT_TRUE(r2.has_value);
     TEST_ASSERT_EQUAL(1, r2.value);
 
@@ -221,7 +376,7 @@ void test_matrix_sensor_nkro()
     TEST_ASSERT_TRUE((r1.pin == 128 && r2.pin == 133) || (r1.pin == 133 && r2.pin == 128));
 
     // No more readings
-    Reading r3 = sensor.getReading();
+    Reading r3 = nextReading();
     TEST_ASSERT_FALSE(r3.has_value);
 }
 
@@ -235,17 +390,17 @@ void test_matrix_sensor_no_repeat_while_held()
 
     // Press button
     pressButton(0, 0);
-    for (int i = 0; i < 3; i++) sensor.scan();
+    scanTicks(sensor, 4);
 
     // Get press event
-    Reading r1 = sensor.getReading();
+    Reading r1 = nextReading();
     TEST_ASSERT_TRUE(r1.has_value);
 
     // Keep scanning with button held
-    for (int i = 0; i < 20; i++) sensor.scan();
+    scanTicks(sensor, 20);
 
     // Should NOT have another reading
-    Reading r2 = sensor.getReading();
+    Reading r2 = nextReading();
     TEST_ASSERT_FALSE(r2.has_value);
 }
 
@@ -257,16 +412,15 @@ void test_matrix_sensor_debounce_filters_glitches()
     MatrixSensor sensor(3, 4, rows, cols);
     sensor.begin();
 
-    // Glitchy button: pressed for 2 scans, then released
+    // Glitchy button: pressed for 2 ms, then released
     pressButton(0, 0);
-    sensor.scan();
-    sensor.scan();
+    scanTicks(sensor, 2);
 
     releaseButton(0, 0);
-    sensor.scan();
+    scanTicks(sensor, 5);
 
     // Should NOT have reading (glitch filtered)
-    Reading r = sensor.getReading();
+    Reading r = nextReading();
     TEST_ASSERT_FALSE(r.has_value);
 }
 
@@ -280,17 +434,17 @@ void test_matrix_sensor_full_cycle()
 
     // Press
     pressButton(1, 2);
-    for (int i = 0; i < 3; i++) sensor.scan();
+    scanTicks(sensor, 4);
 
-    Reading press = sensor.getReading();
+    Reading press = nextReading();
     TEST_ASSERT_TRUE(press.has_value);
     TEST_ASSERT_EQUAL(1, press.value);
 
     // Release
     releaseButton(1, 2);
-    for (int i = 0; i < 3; i++) sensor.scan();
+    scanTicks(sensor, 4);
 
-    Reading release = sensor.getReading();
+    Reading release = nextReading();
     TEST_ASSERT_TRUE(release.has_value);
     TEST_ASSERT_EQUAL(0, release.value);
 }
@@ -309,24 +463,332 @@ void test_matrix_sensor_2x2()
     pressButton(1, 0);
     pressButton(1, 1);
 
-    for (int i = 0; i < 3; i++) sensor.scan();
+    scanTicks(sensor, 4);
 
     // Should get 4 events
     for (int i = 0; i < 4; i++) {
-        Reading r = sensor.getReading();
+        Reading r = nextReading();
         TEST_ASSERT_TRUE(r.has_value);
         TEST_ASSERT_EQUAL(1, r.value);
     }
 
     // No more events
-    Reading r5 = sensor.getReading();
+    Reading r5 = nextReading();
     TEST_ASSERT_FALSE(r5.has_value);
 }
 
-// Test event queue overflow handling
-void test_matrix_sensor_event_queue_overflow()
+// Test that keys in a row share the debounce timer: a chord is reported once
+// its last key is stable, and a key that bounces back doesn't hold it up
+void test_matrix_sensor_row_buttons_debounce_independently()
+{
+    uint8_t rows[] = {2, 3};
+    uint8_t cols[] = {5, 6, 7};
+    MatrixSensor sensor(2, 3, rows, cols);
+    sensor.begin();
+
+    pressButton(0, 0);
+    scanTicks(sensor, 1);
+    pressButton(0, 1);
+    pressButton(0, 2);
+    scanTicks(sensor, 1);
+
+    // Col 2 glitches back while col 0 and col 1 keep reading pressed
+    releaseButton(0, 2);
+    scanTicks(sensor, 2);
+
+    // Col 0 is reported 3 ms after it was pressed, without waiting for col 1
+    Reading r1 = nextReading();
+    TEST_ASSERT_TRUE(r1.has_value);
+    TEST_ASSERT_EQUAL(128, r1.pin);
+    TEST_ASSERT_EQUAL(1, r1.value);
+    TEST_ASSERT_FALSE(nextReading().has_value);
+
+    // Col 1 at least 3 ms after it joined
+    scanTicks(sensor, 1);
+    TEST_ASSERT_FALSE(nextReading().has_value);
+    scanTicks(sensor, 1);
+    Reading r2 = nextReading();
+    TEST_ASSERT_TRUE(r2.has_value);
+    TEST_ASSERT_EQUAL(129, r2.pin);
+    TEST_ASSERT_EQUAL(1, r2.value);
+    TEST_ASSERT_FALSE(nextReading().has_value);
+
+    // Col 0 releases while col 1 stays held
+    g_mock_micros += 1000;
+    releaseButton(0, 0);
+    scanTicks(sensor, 4);
+    Reading r3 = nextReading();
+    TEST_ASSERT_TRUE(r3.has_value);
+    TEST_ASSERT_EQUAL(128, r3.pin);
+    TEST_ASSERT_EQUAL(0, r3.value);
+    TEST_ASSERT_FALSE(nextReading().has_value);
+}
+
+// Test that a chattering key doesn't hold back a held key in its row
+void test_matrix_sensor_chattering_key_doesnt_block_row()
+{
+    uint8_t rows[] = {2, 3};
+    uint8_t cols[] = {5, 6, 7};
+    MatrixSensor sensor(2, 3, rows, cols);
+    sensor.begin();
+
+    pressButton(0, 0);
+    for (int i = 0; i < 10; i++) {
+        g_button_pressed[0][1] = (i & 1) != 0;
+        scanTicks(sensor, 1);
+    }
+
+    Reading r = nextReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(128, r.pin);
+    TEST_ASSERT_EQUAL(1, r.value);
+    TEST_ASSERT_FALSE(nextReading().has_value);
+}
+
+// Test the configured debounce time
+void test_matrix_sensor_debounce_time()
+{
+    uint8_t rows[] = {2, 3};
+    uint8_t cols[] = {5, 6};
+    MatrixSensor sensor(2, 2, rows, cols, 0, 0, MatrixSensor::DIODES_COL_TO_ROW,
+        MatrixSensor::LOCKOUT_OFF, MatrixSensor::LOCKOUT_OFF, 10);
+    sensor.begin();
+
+    pressButton(1, 0);
+    scanTicks(sensor, 10);
+    TEST_ASSERT_FALSE(nextReading().has_value);
+    sensor.scan();
+    TEST_ASSERT_EQUAL(128 + 2, nextReading().pin);
+}
+
+// Test the default settle time: one row driven at a time, each waited for
+void test_matrix_sensor_default_settle()
+{
+    uint8_t rows[] = {2, 3, 4};
+    uint8_t cols[] = {5, 6, 7, 8};
+    MatrixSensor sensor(3, 4, rows, cols);
+    sensor.begin();
+
+    pressButton(2, 3);
+    scanTicks(sensor, 4);
+
+    TEST_ASSERT_EQUAL(4 * 3 * MatrixSensor::DEFAULT_SETTLE_US, g_delay_total);
+    TEST_ASSERT_EQUAL(1, g_max_driven);
+    TEST_ASSERT_EQUAL(139, nextReading().pin);
+
+    // All rows released after the scan
+    TEST_ASSERT_EQUAL(HIGH, g_pin_state[2]);
+    TEST_ASSERT_EQUAL(HIGH, g_pin_state[3]);
+    TEST_ASSERT_EQUAL(HIGH, g_pin_state[4]);
+}
+
+// Test that time spent since the row was driven is not waited again
+void test_matrix_sensor_settle_overlaps_processing()
+{
+    uint8_t rows[] = {2, 3, 4};
+    uint8_t cols[] = {5, 6, 7, 8};
+    MatrixSensor sensor(3, 4, rows, cols, 30);
+    sensor.begin();
+
+    // Configured settle time, nothing else takes time
+    sensor.scan();
+    TEST_ASSERT_EQUAL(3 * 30, g_delay_total);
+
+    // 8 us pass between driving a row and checking it
+    g_delay_total = 0;
+    g_micros_step = 8;
+    sensor.scan();
+    TEST_ASSERT_EQUAL(3 * 22, g_delay_total);
+
+    // Processing longer than the settle time: no wait at all
+    g_delay_total = 0;
+    g_micros_step = 40;
+    sensor.scan();
+    TEST_ASSERT_EQUAL(0, g_delay_total);
+}
+
+// Test a frame spread over several scans
+void test_matrix_sensor_rows_per_tick()
+{
+    uint8_t rows[] = {2, 3, 4, 5, 6};
+    uint8_t cols[] = {9, 10};
+    setMockPinMapping(2, 9);
+    MatrixSensor sensor(5, 2, rows, cols, 0, 2);
+    sensor.begin();
+
+    pressButton(4, 1);
+
+    // Frame of 5 rows in slices of 2, 2 and 1
+    sensor.scan();
+    TEST_ASSERT_EQUAL(2 * MatrixSensor::DEFAULT_SETTLE_US, g_delay_total);
+    TEST_ASSERT_FALSE(sensor.frameComplete());
+    sensor.scan();
+    TEST_ASSERT_FALSE(sensor.frameComplete());
+    sensor.scan();
+    TEST_ASSERT_EQUAL(5 * MatrixSensor::DEFAULT_SETTLE_US, g_delay_total);
+    TEST_ASSERT_TRUE(sensor.frameComplete());
+    TEST_ASSERT_EQUAL(1, g_max_driven);
+
+    // Row 4 is read every third call: debounced on the first read 3 ms after the press
+    g_mock_micros = 2000;
+    for (int i = 0; i < 3; i++) sensor.scan();
+    TEST_ASSERT_FALSE(nextReading().has_value);
+    g_mock_micros = 3100;
+    for (int i = 0; i < 3; i++) sensor.scan();
+    Reading r = nextReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(128 + 9, r.pin); // Row 4, col 1
+    TEST_ASSERT_EQUAL(1, r.value);
+}
+
+// Test that without diodes the smaller side is driven, with the same pin mapping
+void test_matrix_sensor_drives_smaller_side()
+{
+    uint8_t rows[] = {2, 3, 4, 5};
+    uint8_t cols[] = {9, 10};
+    setMockPinMapping(2, 9);
+    MatrixSensor sensor(4, 2, rows, cols, 0, 0, MatrixSensor::DIODES_NONE);
+    sensor.begin();
+    TEST_ASSERT_TRUE(sensor.isTransposed());
+
+    // 2 columns driven instead of 4 rows
+    sensor.scan();
+    TEST_ASSERT_EQUAL(2 * MatrixSensor::DEFAULT_SETTLE_US, g_delay_total);
+    TEST_ASSERT_EQUAL(1, g_max_driven);
+
+    pressButton(3, 1);
+    pressButton(1, 0);
+    scanTicks(sensor, 4);
+
+    // Scanned column by column; pins still 128 + row * num_cols + col
+    Reading r1 = nextReading();
+    TEST_ASSERT_EQUAL(128 + 2, r1.pin); // Row 1, col 0
+    Reading r2 = nextReading();
+    TEST_ASSERT_EQUAL(128 + 7, r2.pin); // Row 3, col 1
+    TEST_ASSERT_FALSE(nextReading().has_value);
+
+    releaseButton(3, 1);
+    scanTicks(sensor, 4);
+    Reading r3 = nextReading();
+    TEST_ASSERT_TRUE(r3.has_value);
+    TEST_ASSERT_EQUAL(128 + 7, r3.pin);
+    TEST_ASSERT_EQUAL(0, r3.value);
+    TEST_ASSERT_FALSE(nextReading().has_value);
+}
+
+// Test that the diode direction decides the driven side
+void test_matrix_sensor_diode_direction()
+{
+    uint8_t rows[] = {2, 3, 4, 5};
+    uint8_t cols[] = {9, 10};
+    setMockPinMapping(2, 9);
+
+    // Cathodes on the rows: rows driven even though there are more of them
+    g_diodes = 0;
+    MatrixSensor rows_driven(4, 2, rows, cols, 0, 0, MatrixSensor::DIODES_COL_TO_ROW);
+    rows_driven.begin();
+    TEST_ASSERT_FALSE(rows_driven.isTransposed());
+    pressButton(3, 1);
+    scanTicks(rows_driven, 4);
+    TEST_ASSERT_EQUAL(4 * 4 * MatrixSensor::DEFAULT_SETTLE_US, g_delay_total);
+    TEST_ASSERT_EQUAL(128 + 7, nextReading().pin);
+
+    // Cathodes on the columns: columns driven even if there are more of them
+    g_diodes = 1;
+    uint8_t wide_cols[] = {9, 10, 11, 12, 13};
+    MatrixSensor cols_driven(4, 5, rows, wide_cols, 0, 0, MatrixSensor::DIODES_ROW_TO_COL);
+    cols_driven.begin();
+    TEST_ASSERT_TRUE(cols_driven.isTransposed());
+    pressButton(2, 4);
+    scanTicks(cols_driven, 4);
+    TEST_ASSERT_EQUAL(128 + 3 * 5 + 1, nextReading().pin); // Row 3, col 1
+    TEST_ASSERT_EQUAL(128 + 2 * 5 + 4, nextReading().pin); // Row 2, col 4
+    TEST_ASSERT_FALSE(nextReading().has_value);
+}
+
+// Test eager presses: reported on the first scan, then locked out while bouncing
+void test_matrix_sensor_eager_press_lockout()
+{
+    uint8_t rows[] = {2, 3};
+    uint8_t cols[] = {5, 6};
+    MatrixSensor sensor(2, 2, rows, cols, 0, 0, MatrixSensor::DIODES_COL_TO_ROW, 10, MatrixSensor::LOCKOUT_OFF);
+    sensor.begin();
+
+    g_mock_micros = 100000;
+    pressButton(0, 1);
+    sensor.scan();
+    Reading press = nextReading();
+    TEST_ASSERT_TRUE(press.has_value);
+    TEST_ASSERT_EQUAL(129, press.pin);
+    TEST_ASSERT_EQUAL(1, press.value);
+
+    // Bounce within the 10 ms lockout is ignored
+    releaseButton(0, 1);
+    for (int i = 0; i < 4; i++) {
+        g_mock_micros += 2000;
+        sensor.scan();
+    }
+    TEST_ASSERT_FALSE(nextReading().has_value);
+
+    // Another key in the row is still eager, and extends the row's lockout
+    g_mock_micros = 105000;
+    pressButton(0, 0);
+    sensor.scan();
+    TEST_ASSERT_EQUAL(128, nextReading().pin);
+
+    // Release of col 1 is integrated once the lockout (now until 115 ms) is over
+    g_mock_micros = 112000;
+    for (int i = 0; i < 3; i++) sensor.scan();
+    TEST_ASSERT_FALSE(nextReading().has_value);
+    g_mock_micros = 115000;
+    scanTicks(sensor, 3);
+    TEST_ASSERT_FALSE(nextReading().has_value);
+    sensor.scan();
+    Reading release = nextReading();
+    TEST_ASSERT_TRUE(release.has_value);
+    TEST_ASSERT_EQUAL(129, release.pin);
+    TEST_ASSERT_EQUAL(0, release.value);
+    TEST_ASSERT_FALSE(nextReading().has_value);
+}
+
+// Test columns spread over two ports, out of bit order
+void test_matrix_sensor_columns_across_ports()
+{
+    uint8_t rows[] = {2, 3};
+    uint8_t cols[] = {9, 6, 7, 8}; // Port 1 bit 1, port 0 bits 6-7, port 1 bit 0
+    memcpy(g_col_pins, cols, sizeof(cols));
+    MatrixSensor sensor(2, 4, rows, cols);
+    sensor.begin();
+
+    pressButton(0, 0);
+    pressButton(1, 2);
+    pressButton(1, 3);
+    scanTicks(sensor, 4);
+
+    uint8_t pins[3];
+    for (int i = 0; i < 3; i++) {
+        Reading r = nextReading();
+        TEST_ASSERT_TRUE(r.has_value);
+        TEST_ASSERT_EQUAL(1, r.value);
+        pins[i] = r.pin;
+    }
+    TEST_ASSERT_FALSE(nextReading().has_value);
+
+    // Scanned in row order, columns in configured order
+    TEST_ASSERT_EQUAL(128 + 0, pins[0]); // Row 0, col 0
+    TEST_ASSERT_EQUAL(128 + 6, pins[1]); // Row 1, col 2
+    TEST_ASSERT_EQUAL(128 + 7, pins[2]); // Row 1, col 3
+
+    // Rows are released after the scan; columns came from the port registers
+    TEST_ASSERT_EQUAL(HIGH, g_pin_state[2]);
+    TEST_ASSERT_EQUAL(HIGH, g_pin_state[3]);
+    TEST_ASSERT_EQUAL(0, g_digital_reads);
+}
+
+// Test that every key of a full-matrix press is reported
+void test_matrix_sensor_all_keys_pressed()
 {
-    // Use a 4x4 matrix and press more than EVENT_QUEUE_SIZE (8) buttons
+    // Use a 4x4 matrix and press all 16 buttons
     uint8_t rows[] = {2, 3, 4, 5};
     uint8_t cols[] = {6, 7, 8, 9};
 
@@ -336,30 +798,248 @@ void test_matrix_sensor_event_queue_overflow()
     MatrixSensor sensor(4, 4, rows, cols);
     sensor.begin();
 
-    // Press all 16 buttons at once (more than queue size of 8)
+    // Press all 16 buttons at once
     for (int r = 0; r < 4; r++) {
         for (int c = 0; c < 4; c++) {
             pressButton(r, c);
         }
     }
 
-    for (int i = 0; i < 3; i++) sensor.scan();
+    scanTicks(sensor, 4);
 
-    // Should get at least some events (queue drops oldest on overflow)
+    // One event per key, each with the scan time
     int event_count = 0;
     while (true) {
-        Reading r = sensor.getReading();
+        Reading r = nextReading();
         if (!r.has_value) break;
+        TEST_ASSERT_EQUAL(1, r.value);
+        TEST_ASSERT_TRUE(r.time_us != 0);
         event_count++;
         if (event_count > 20) break; // Safety limit
     }
 
-    // We pressed 16 buttons, but queue size is 8
-    // Due to circular buffer with drop-oldest, we should get close to 8-9 events
-    TEST_ASSERT_GREATER_OR_EQUAL(7, event_count);
+    TEST_ASSERT_EQUAL(16, event_count);
 }
 
-void setUp(void) { resetMockState(); }
+// Helper to fill the input event ring, leaving no room for matrix events
+void fillEventRing()
+{
+    while (InputEvents::push(Reading(0, InputType::Button, 0, 0))) {
+    }
+}
+
+// Test that events dropped on a full ring flag a resync with the full state
+void test_matrix_sensor_overflow_resync()
+{
+    uint8_t rows[] = {2, 3, 4};
+    uint8_t cols[] = {5, 6, 7, 8};
+    MatrixSensor sensor(3, 4, rows, cols);
+    sensor.begin();
+
+    // Reported normally: no resync
+    pressButton(0, 1);
+    scanTicks(sensor, 4);
+    TEST_ASSERT_EQUAL(129, nextReading().pin);
+    TEST_ASSERT_FALSE(sensor.takeResync());
+
+    // Ring full: the release and a press are dropped
+    fillEventRing();
+    releaseButton(0, 1);
+    pressButton(2, 3);
+    scanTicks(sensor, 4);
+    TEST_ASSERT_TRUE(sensor.takeResync());
+    TEST_ASSERT_FALSE(sensor.takeResync()); // Once per drop
+
+    // The state has both changes (button index 11 = row 2, col 3)
+    uint8_t bitmap[MatrixSensor::MAX_BUTTONS / 8];
+    uint8_t blocked[MatrixSensor::MAX_BUTTONS / 8];
+    TEST_ASSERT_EQUAL(12, sensor.getReportedState(bitmap, blocked));
+    TEST_ASSERT_EQUAL_UINT8(0x00, bitmap[0]);
+    TEST_ASSERT_EQUAL_UINT8(0x08, bitmap[1]);
+
+    // Later changes are reported against that state
+    InputEvents::clear();
+    releaseButton(2, 3);
+    scanTicks(sensor, 4);
+    Reading release = nextReading();
+    TEST_ASSERT_EQUAL(139, release.pin);
+    TEST_ASSERT_EQUAL(0, release.value);
+    TEST_ASSERT_FALSE(nextReading().has_value);
+    TEST_ASSERT_FALSE(sensor.takeResync());
+}
+
+// Test that the state bitmap uses the configured layout when columns are driven
+void test_matrix_sensor_reported_state_transposed()
+{
+    uint8_t rows[] = {2, 3, 4, 5};
+    uint8_t cols[] = {9, 10};
+    setMockPinMapping(2, 9);
+
+    MatrixSensor sensor(4, 2, rows, cols, 0, 0, MatrixSensor::DIODES_NONE);
+    sensor.begin();
+    TEST_ASSERT_TRUE(sensor.isTransposed());
+
+    pressButton(3, 1);
+    scanTicks(sensor, 4);
+
+    uint8_t bitmap[MatrixSensor::MAX_BUTTONS / 8];
+    uint8_t blocked[MatrixSensor::MAX_BUTTONS / 8];
+    TEST_ASSERT_EQUAL(8, sensor.getReportedState(bitmap, blocked));
+    TEST_ASSERT_EQUAL_UINT8(0x80, bitmap[0]); // Button index 7 = row 3, col 1
+}
+
+// Test that the mock makes a ghost: three keys in an L read as four
+void test_matrix_sensor_ghost_without_anti_ghost()
+{
+    uint8_t rows[] = {2, 3, 4};
+    uint8_t cols[] = {5, 6, 7};
+    g_sneak_paths = true;
+
+    // Configured with diodes the wiring doesn't have: no anti-ghosting
+    MatrixSensor sensor(3, 3, rows, cols);
+    sensor.begin();
+
+    pressButton(0, 0);
+    pressButton(0, 1);
+    pressButton(1, 0);
+    scanTicks(sensor, 4);
+
+    int presses = 0;
+    for (Reading r = nextReading(); r.has_value; r = nextReading()) {
+        presses++;
+    }
+    TEST_ASSERT_EQUAL(4, presses); // (1, 1) is a ghost
+}
+
+// Test that a key completing a rectangle is held back as a possible ghost
+void test_matrix_sensor_anti_ghost_blocks_rectangle()
+{
+    uint8_t rows[] = {2, 3, 4};
+    uint8_t cols[] = {5, 6, 7};
+    g_sneak_paths = true;
+
+    MatrixSensor sensor(3, 3, rows, cols, 0, 0, MatrixSensor::DIODES_NONE);
+    sensor.begin();
+    TEST_ASSERT_EQUAL(MatrixSensor::ROLLOVER_NO_DIODES, sensor.getRollover());
+    TEST_ASSERT_TRUE(sensor.takeResync()); // Host learns the rollover
+
+    // Two keys: unambiguous
+    pressButton(0, 0);
+    pressButton(0, 1);
+    scanTicks(sensor, 4);
+    TEST_ASSERT_EQUAL(128, nextReading().pin);
+    TEST_ASSERT_EQUAL(129, nextReading().pin);
+    TEST_ASSERT_FALSE(sensor.takeResync());
+
+    // The third key of the L and its ghost read the same: neither is reported
+    pressButton(1, 0);
+    scanTicks(sensor, 4);
+    TEST_ASSERT_FALSE(nextReading().has_value);
+    TEST_ASSERT_TRUE(sensor.takeResync());
+
+    uint8_t pressed[MatrixSensor::MAX_BUTTONS / 8];
+    uint8_t blocked[MatrixSensor::MAX_BUTTONS / 8];
+    TEST_ASSERT_EQUAL(9, sensor.getReportedState(pressed, blocked));
+    TEST_ASSERT_EQUAL_UINT8(0x03, pressed[0]); // (0, 0) and (0, 1)
+    TEST_ASSERT_EQUAL_UINT8(0x18, blocked[0]); // (1, 0) and the ghost (1, 1)
+
+    // Releasing a key of the L breaks the rectangle: the real key goes out
+    releaseButton(0, 1);
+    scanTicks(sensor, 4);
+    Reading first = nextReading();
+    Reading second = nextReading();
+    TEST_ASSERT_EQUAL(129, first.pin); // Row 0 first
+    TEST_ASSERT_EQUAL(0, first.value);
+    TEST_ASSERT_EQUAL(131, second.pin);
+    TEST_ASSERT_EQUAL(1, second.value);
+    TEST_ASSERT_FALSE(nextReading().has_value);
+    TEST_ASSERT_TRUE(sensor.takeResync()); // Nothing blocked any more
+}
+
+// Test that a ghost whose release settles after the real key's doesn't leak
+void test_matrix_sensor_anti_ghost_release_bounce()
+{
+    uint8_t rows[] = {2, 3, 4};
+    uint8_t cols[] = {5, 6, 7};
+    g_sneak_paths = true;
+
+    // One row per scan: scan n reads row n % 3
+    MatrixSensor sensor(3, 3, rows, cols, 0, 1, MatrixSensor::DIODES_NONE);
+    sensor.begin();
+
+    pressButton(0, 0);
+    pressButton(0, 1);
+    scanTicks(sensor, 30);
+    TEST_ASSERT_EQUAL(128, nextReading().pin);
+    TEST_ASSERT_EQUAL(129, nextReading().pin);
+    pressButton(1, 0);
+    scanTicks(sensor, 30);
+    TEST_ASSERT_FALSE(nextReading().has_value);
+
+    // (0, 1) opens, but bounces closed while row 1 is read: the ghost (1, 1)
+    // starts releasing a frame after the real key
+    releaseButton(0, 1);
+    scanTicks(sensor, 1);
+    pressButton(0, 1);
+    scanTicks(sensor, 1);
+    releaseButton(0, 1);
+    scanTicks(sensor, 30);
+
+    Reading first = nextReading();
+    Reading second = nextReading();
+    TEST_ASSERT_EQUAL(129, first.pin);
+    TEST_ASSERT_EQUAL(0, first.value);
+    TEST_ASSERT_EQUAL(131, second.pin);
+    TEST_ASSERT_EQUAL(1, second.value);
+    TEST_ASSERT_FALSE(nextReading().has_value); // Never the ghost (132)
+
+    uint8_t pressed[MatrixSensor::MAX_BUTTONS / 8];
+    uint8_t blocked[MatrixSensor::MAX_BUTTONS / 8];
+    sensor.getReportedState(pressed, blocked);
+    TEST_ASSERT_EQUAL_UINT8(0x09, pressed[0]); // (0, 0) and (1, 0)
+    TEST_ASSERT_EQUAL_UINT8(0x00, blocked[0]);
+}
+
+// Test that keys reported before a rectangle formed stay pressed
+void test_matrix_sensor_anti_ghost_keeps_reported_keys()
+{
+    uint8_t rows[] = {2, 3};
+    uint8_t cols[] = {5, 6};
+
+    // A real 4-key chord, pressed one key at a time (no sneak paths, so the
+    // fourth key is real here)
+    MatrixSensor sensor(2, 2, rows, cols, 0, 0, MatrixSensor::DIODES_NONE);
+    sensor.begin();
+
+    pressButton(0, 0);
+    pressButton(0, 1);
+    pressButton(1, 0);
+    scanTicks(sensor, 4);
+    TEST_ASSERT_TRUE(nextReading().has_value);
+    TEST_ASSERT_TRUE(nextReading().has_value);
+    TEST_ASSERT_TRUE(nextReading().has_value);
+
+    // The fourth corner can't be told from a ghost: held back
+    pressButton(1, 1);
+    scanTicks(sensor, 4);
+    TEST_ASSERT_FALSE(nextReading().has_value);
+
+    // Releases still go out
+    releaseButton(0, 0);
+    scanTicks(sensor, 4);
+    Reading release = nextReading();
+    TEST_ASSERT_EQUAL(128, release.pin);
+    TEST_ASSERT_EQUAL(0, release.value);
+    Reading press = nextReading();
+    TEST_ASSERT_EQUAL(131, press.pin); // Rectangle broken
+    TEST_ASSERT_EQUAL(1, press.value);
+}
+
+void setUp(void)
+{
+    resetMockState();
+    InputEvents::clear();
+}
 void tearDown(void) {}
 
 int main(int argc, char** argv)
@@ -376,7 +1056,23 @@ int main(int argc, char** argv)
     RUN_TEST(test_matrix_sensor_debounce_filters_glitches);
     RUN_TEST(test_matrix_sensor_full_cycle);
     RUN_TEST(test_matrix_sensor_2x2);
-    RUN_TEST(test_matrix_sensor_event_queue_overflow);
+    RUN_TEST(test_matrix_sensor_row_buttons_debounce_independently);
+    RUN_TEST(test_matrix_sensor_chattering_key_doesnt_block_row);
+    RUN_TEST(test_matrix_sensor_debounce_time);
+    RUN_TEST(test_matrix_sensor_default_settle);
+    RUN_TEST(test_matrix_sensor_settle_overlaps_processing);
+    RUN_TEST(test_matrix_sensor_rows_per_tick);
+    RUN_TEST(test_matrix_sensor_drives_smaller_side);
+    RUN_TEST(test_matrix_sensor_diode_direction);
+    RUN_TEST(test_matrix_sensor_eager_press_lockout);
+    RUN_TEST(test_matrix_sensor_columns_across_ports);
+    RUN_TEST(test_matrix_sensor_all_keys_pressed);
+    RUN_TEST(test_matrix_sensor_overflow_resync);
+    RUN_TEST(test_matrix_sensor_reported_state_transposed);
+    RUN_TEST(test_matrix_sensor_ghost_without_anti_ghost);
+    RUN_TEST(test_matrix_sensor_anti_ghost_blocks_rectangle);
+    RUN_TEST(test_matrix_sensor_anti_ghost_release_bounce);
+    RUN_TEST(test_matrix_sensor_anti_ghost_keeps_reported_keys);
 
     return UNITY_END();
 }
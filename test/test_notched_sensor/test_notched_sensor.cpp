@@ -0,0 +1,324 @@
+// Mock Arduino environment for native testing
+#include <stdint.h>
+
+// Arduino pin definitions
+#define INPUT 0
+#define OUTPUT 1
+#define A0 14
+
+// Mock Arduino functions
+static uint16_t g_mock_analog_value = 0;
+static unsigned long g_mock_micros = 0;
+
+unsigned long micros()
+{
+    return g_mock_micros;
+}
+
+unsigned long millis()
+{
+    return g_mock_micros / 1000;
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    (void)pin;
+    (void)mode;
+}
+int analogRead(uint8_t pin)
+{
+    (void)pin;
+    return g_mock_analog_value;
+}
+
+// Now include the sensor code (include .cpp directly since we provide mocks above)
+#include "../../src/sensor.h"
+#include "../../src/notched_sensor.cpp"
+#include <unity.h>
+
+using namespace Sensor;
+
+// Helper to take the next reported reading from the device-wide ring
+Reading nextReading()
+{
+    Reading reading;
+    InputEvents::pop(reading);
+    return reading;
+}
+
+// Reverser: 3 notches (reverse / neutral / forward)
+static const uint16_t REVERSER_BOUNDARIES[] = { 340, 680 };
+static const uint8_t HYSTERESIS = 10;
+
+// Set the mock value and scan enough times to fill the median-of-3 filter
+void scanValue(NotchedSensor& sensor, uint16_t value)
+{
+    g_mock_analog_value = value;
+    for (int i = 0; i < 3; i++) {
+        sensor.scan();
+    }
+}
+
+// Count queued readings (drains the ring)
+int drainReadings()
+{
+    int count = 0;
+    while (nextReading().has_value) {
+        count++;
+    }
+    return count;
+}
+
+// Test initialization
+void test_notched_sensor_init()
+{
+    NotchedSensor sensor(A0, HYSTERESIS, 0, REVERSER_BOUNDARIES, 2);
+
+    TEST_ASSERT_EQUAL(InputType::Notched, sensor.getType());
+    TEST_ASSERT_EQUAL(A0, sensor.getPin());
+}
+
+// Test that the first scan reports the starting notch
+void test_notched_sensor_reports_initial_notch()
+{
+    NotchedSensor sensor(A0, HYSTERESIS, 0, REVERSER_BOUNDARIES, 2);
+    sensor.begin();
+
+    g_mock_analog_value = 500;
+    sensor.scan();
+
+    Reading r = nextReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(InputType::Notched, r.type);
+    TEST_ASSERT_EQUAL(A0, r.pin);
+    TEST_ASSERT_EQUAL(1, r.value);
+    TEST_ASSERT_FALSE(nextReading().has_value);
+}
+
+// Test that nothing is reported while the lever stays in a notch
+void test_notched_sensor_no_report_without_change()
+{
+    NotchedSensor sensor(A0, HYSTERESIS, 0, REVERSER_BOUNDARIES, 2);
+    sensor.begin();
+    scanValue(sensor, 500);
+    drainReadings();
+
+    for (uint16_t v = 400; v < 650; v += 10) {
+        scanValue(sensor, v);
+    }
+
+    TEST_ASSERT_FALSE(nextReading().has_value);
+}
+
+// Test notch changes in both directions
+void test_notched_sensor_reports_changes()
+{
+    NotchedSensor sensor(A0, HYSTERESIS, 0, REVERSER_BOUNDARIES, 2);
+    sensor.begin();
+    scanValue(sensor, 500);
+    drainReadings();
+
+    scanValue(sensor, 900);
+    Reading r = nextReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(2, r.value);
+
+    scanValue(sensor, 100);
+    r = nextReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(0, r.value); // Jumped across two notches in one report
+    TEST_ASSERT_FALSE(nextReading().has_value);
+}
+
+// Test that hysteresis stops chatter around a boundary
+void test_notched_sensor_hysteresis()
+{
+    NotchedSensor sensor(A0, HYSTERESIS, 0, REVERSER_BOUNDARIES, 2);
+    sensor.begin();
+    scanValue(sensor, 500);
+    drainReadings();
+
+    // Just past the boundary, within hysteresis - stays in notch 1
+    scanValue(sensor, 685);
+    TEST_ASSERT_EQUAL(1, sensor.getNotch());
+    TEST_ASSERT_FALSE(nextReading().has_value);
+
+    // Past boundary + hysteresis
+    scanValue(sensor, 690);
+    TEST_ASSERT_EQUAL(2, sensor.getNotch());
+    drainReadings();
+
+    // Back just below the boundary - stays in notch 2
+    scanValue(sensor, 675);
+    TEST_ASSERT_EQUAL(2, sensor.getNotch());
+    TEST_ASSERT_FALSE(nextReading().has_value);
+
+    // Below boundary - hysteresis
+    scanValue(sensor, 669);
+    TEST_ASSERT_EQUAL(1, sensor.getNotch());
+}
+
+// Test that a single spike doesn't flip the notch
+void test_notched_sensor_rejects_spike()
+{
+    NotchedSensor sensor(A0, HYSTERESIS, 0, REVERSER_BOUNDARIES, 2);
+    sensor.begin();
+    scanValue(sensor, 500);
+    drainReadings();
+
+    g_mock_analog_value = 1023;
+    sensor.scan();
+    g_mock_analog_value = 500;
+    sensor.scan();
+    sensor.scan();
+
+    TEST_ASSERT_EQUAL(1, sensor.getNotch());
+    TEST_ASSERT_FALSE(nextReading().has_value);
+}
+
+// Test virtual button events on notch changes
+void test_notched_sensor_virtual_buttons()
+{
+    NotchedSensor sensor(A0, HYSTERESIS, 200, REVERSER_BOUNDARIES, 2);
+    sensor.begin();
+
+    // Initial notch: press only
+    scanValue(sensor, 500);
+    Reading r = nextReading();
+    TEST_ASSERT_EQUAL(InputType::Button, r.type);
+    TEST_ASSERT_EQUAL(201, r.pin);
+    TEST_ASSERT_EQUAL(1, r.value);
+    r = nextReading();
+    TEST_ASSERT_EQUAL(InputType::Notched, r.type);
+    TEST_ASSERT_EQUAL(1, r.value);
+    TEST_ASSERT_FALSE(nextReading().has_value);
+
+    // Change: release old, press new, then the notch index
+    scanValue(sensor, 50);
+    r = nextReading();
+    TEST_ASSERT_EQUAL(InputType::Button, r.type);
+    TEST_ASSERT_EQUAL(201, r.pin);
+    TEST_ASSERT_EQUAL(0, r.value);
+    r = nextReading();
+    TEST_ASSERT_EQUAL(InputType::Button, r.type);
+    TEST_ASSERT_EQUAL(200, r.pin);
+    TEST_ASSERT_EQUAL(1, r.value);
+    r = nextReading();
+    TEST_ASSERT_EQUAL(InputType::Notched, r.type);
+    TEST_ASSERT_EQUAL(0, r.value);
+}
+
+// Test that a notch change waits until the ring has room for all its events
+void test_notched_sensor_full_ring_retries()
+{
+    NotchedSensor sensor(A0, HYSTERESIS, 200, REVERSER_BOUNDARIES, 2);
+    sensor.begin();
+    scanValue(sensor, 500);
+    drainReadings();
+
+    // Room for two of the three events: nothing is pushed
+    for (int i = 0; i < InputEvents::RING_SIZE - 2; i++) {
+        InputEvents::push(Reading(0, InputType::Analog, 0, 0));
+    }
+    scanValue(sensor, 50);
+    TEST_ASSERT_EQUAL(1, sensor.getNotch());
+    TEST_ASSERT_EQUAL(InputEvents::RING_SIZE - 2, drainReadings());
+
+    // Once there is room the next scan reports the whole change
+    sensor.scan();
+    TEST_ASSERT_EQUAL(0, sensor.getNotch());
+    Reading r = nextReading();
+    TEST_ASSERT_EQUAL(201, r.pin);
+    TEST_ASSERT_EQUAL(0, r.value);
+    r = nextReading();
+    TEST_ASSERT_EQUAL(200, r.pin);
+    TEST_ASSERT_EQUAL(1, r.value);
+    r = nextReading();
+    TEST_ASSERT_EQUAL(InputType::Notched, r.type);
+    TEST_ASSERT_EQUAL(0, r.value);
+    TEST_ASSERT_FALSE(nextReading().has_value);
+}
+
+// Test that a lever at rest resends its notch as a keepalive
+void test_notched_sensor_keepalive()
+{
+    NotchedSensor sensor(A0, HYSTERESIS, 200, REVERSER_BOUNDARIES, 2);
+    sensor.begin();
+    scanValue(sensor, 500);
+    drainReadings();
+
+    g_mock_micros += (NotchedSensor::KEEPALIVE_MS - 1) * 1000UL;
+    sensor.scan();
+    TEST_ASSERT_FALSE(nextReading().has_value);
+
+    // Only the notch index, not the virtual buttons
+    g_mock_micros += 1000;
+    sensor.scan();
+    Reading r = nextReading();
+    TEST_ASSERT_EQUAL(InputType::Notched, r.type);
+    TEST_ASSERT_EQUAL(1, r.value);
+    TEST_ASSERT_TRUE(r.keepalive);
+    TEST_ASSERT_FALSE(nextReading().has_value);
+
+    // A notch change is real activity and restarts the interval
+    g_mock_micros += 1000;
+    scanValue(sensor, 50);
+    TEST_ASSERT_FALSE(nextReading().keepalive); // Release
+    drainReadings();
+    g_mock_micros += (NotchedSensor::KEEPALIVE_MS - 1) * 1000UL;
+    sensor.scan();
+    TEST_ASSERT_FALSE(nextReading().has_value);
+}
+
+// Test a throttle with many notches across the full range
+void test_notched_sensor_many_notches()
+{
+    uint16_t boundaries[NotchedSensor::MAX_BOUNDARIES];
+    for (uint8_t i = 0; i < NotchedSensor::MAX_BOUNDARIES; i++) {
+        boundaries[i] = (i + 1) * 85;
+    }
+    NotchedSensor sensor(A0, 4, 0, boundaries, NotchedSensor::MAX_BOUNDARIES);
+    sensor.begin();
+
+    scanValue(sensor, 0);
+    TEST_ASSERT_EQUAL(0, sensor.getNotch());
+    scanValue(sensor, 1023);
+    TEST_ASSERT_EQUAL(NotchedSensor::MAX_NOTCHES - 1, sensor.getNotch());
+    TEST_ASSERT_EQUAL(2, drainReadings());
+}
+
+// Test that begin() restarts reporting
+void test_notched_sensor_begin_resets()
+{
+    NotchedSensor sensor(A0, HYSTERESIS, 0, REVERSER_BOUNDARIES, 2);
+    sensor.begin();
+    scanValue(sensor, 900);
+    drainReadings();
+
+    sensor.begin();
+    TEST_ASSERT_FALSE(nextReading().has_value);
+    scanValue(sensor, 900);
+    TEST_ASSERT_EQUAL(1, drainReadings());
+}
+
+void setUp(void) { InputEvents::clear(); }
+void tearDown(void) {}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_notched_sensor_init);
+    RUN_TEST(test_notched_sensor_reports_initial_notch);
+    RUN_TEST(test_notched_sensor_no_report_without_change);
+    RUN_TEST(test_notched_sensor_reports_changes);
+    RUN_TEST(test_notched_sensor_hysteresis);
+    RUN_TEST(test_notched_sensor_rejects_spike);
+    RUN_TEST(test_notched_sensor_virtual_buttons);
+    RUN_TEST(test_notched_sensor_full_ring_retries);
+    RUN_TEST(test_notched_sensor_keepalive);
+    RUN_TEST(test_notched_sensor_many_notches);
+    RUN_TEST(test_notched_sensor_begin_resets);
+
+    return UNITY_END();
+}
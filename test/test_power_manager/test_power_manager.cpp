@@ -0,0 +1,104 @@
+#include "../../src/power_manager.h"
+#include <unity.h>
+
+using namespace PowerManager;
+
+// Test idle tracker initialization
+void test_idle_tracker_init()
+{
+    IdleTracker tracker(30000);
+
+    TEST_ASSERT_EQUAL(30000, tracker.getTimeout());
+}
+
+// Test that the device is not idle right after boot
+void test_idle_tracker_not_idle_at_boot()
+{
+    IdleTracker tracker(30000);
+
+    TEST_ASSERT_FALSE(tracker.isIdle(0));
+    TEST_ASSERT_FALSE(tracker.isIdle(29999));
+    TEST_ASSERT_TRUE(tracker.isIdle(30000));
+}
+
+// Test that activity postpones idle
+void test_idle_tracker_activity_resets_timeout()
+{
+    IdleTracker tracker(30000);
+
+    tracker.notifyActivity(20000);
+
+    TEST_ASSERT_FALSE(tracker.isIdle(30000));
+    TEST_ASSERT_FALSE(tracker.isIdle(49999));
+    TEST_ASSERT_TRUE(tracker.isIdle(50000));
+}
+
+// Test that activity while idle wakes the device at once
+void test_idle_tracker_activity_leaves_idle()
+{
+    IdleTracker tracker(1000);
+
+    TEST_ASSERT_TRUE(tracker.isIdle(5000));
+
+    tracker.notifyActivity(5000);
+    TEST_ASSERT_FALSE(tracker.isIdle(5000));
+    TEST_ASSERT_FALSE(tracker.isIdle(5999));
+    TEST_ASSERT_TRUE(tracker.isIdle(6000));
+}
+
+// Test millis() wraparound
+void test_idle_tracker_time_wraparound()
+{
+    IdleTracker tracker(1000);
+    unsigned long before_wrap = (unsigned long)-500;
+
+    tracker.notifyActivity(before_wrap);
+
+    TEST_ASSERT_FALSE(tracker.isIdle(before_wrap + 999)); // Wrapped past 0
+    TEST_ASSERT_TRUE(tracker.isIdle(before_wrap + 1000));
+}
+
+// Test the global tracker helpers
+void test_power_manager_global_tracker()
+{
+    notifyActivity(100000);
+
+    TEST_ASSERT_FALSE(isIdle(100000 + IDLE_TIMEOUT_MS - 1));
+    TEST_ASSERT_TRUE(isIdle(100000 + IDLE_TIMEOUT_MS));
+}
+
+// Test that fast tasks drop to the coarse period while idle
+void test_power_manager_idle_task_periods()
+{
+    // Button/matrix scan and send (1 ms), analog (10 ms), heartbeat (10 ms)
+    TEST_ASSERT_EQUAL(IDLE_TASK_PERIOD_US, taskPeriod(1000, true));
+    TEST_ASSERT_EQUAL(IDLE_TASK_PERIOD_US, taskPeriod(10000, true));
+
+    // Full rate again as soon as the device is active
+    TEST_ASSERT_EQUAL(1000, taskPeriod(1000, false));
+    TEST_ASSERT_EQUAL(10000, taskPeriod(10000, false));
+
+    // Slower tasks keep their own period
+    TEST_ASSERT_EQUAL(IDLE_TASK_PERIOD_US * 5, taskPeriod(IDLE_TASK_PERIOD_US * 5, true));
+
+    // Coarse enough that the MCU no longer wakes every millisecond
+    TEST_ASSERT_TRUE(IDLE_TASK_PERIOD_US >= 100000);
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_idle_tracker_init);
+    RUN_TEST(test_idle_tracker_not_idle_at_boot);
+    RUN_TEST(test_idle_tracker_activity_resets_timeout);
+    RUN_TEST(test_idle_tracker_activity_leaves_idle);
+    RUN_TEST(test_idle_tracker_time_wraparound);
+    RUN_TEST(test_power_manager_global_tracker);
+    RUN_TEST(test_power_manager_idle_task_periods);
+
+    return UNITY_END();
+}
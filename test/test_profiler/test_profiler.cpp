@@ -0,0 +1,175 @@
+// Build the profiler with instrumentation enabled for these tests
+#define ENABLE_PROFILER
+
+#include <stdint.h>
+
+// Mock Arduino time source
+static unsigned long g_mock_micros = 0;
+
+unsigned long micros()
+{
+    return g_mock_micros;
+}
+
+void noInterrupts() { }
+void interrupts() { }
+
+#include "../../src/profiler.cpp"
+#include <unity.h>
+
+using namespace Profiler;
+
+// Test that an empty accumulator reports zeros
+void test_phase_stats_empty()
+{
+    PhaseStats stats;
+    Protocol::StatsEntry entry = stats.toEntry();
+
+    TEST_ASSERT_EQUAL_UINT16(0, entry.min_us);
+    TEST_ASSERT_EQUAL_UINT16(0, entry.avg_us);
+    TEST_ASSERT_EQUAL_UINT16(0, entry.max_us);
+    TEST_ASSERT_EQUAL_UINT16(0, entry.count);
+}
+
+// Test min/avg/max accumulation
+void test_phase_stats_min_avg_max()
+{
+    PhaseStats stats;
+    stats.add(30);
+    stats.add(10);
+    stats.add(50);
+
+    Protocol::StatsEntry entry = stats.toEntry();
+    TEST_ASSERT_EQUAL_UINT16(10, entry.min_us);
+    TEST_ASSERT_EQUAL_UINT16(30, entry.avg_us);
+    TEST_ASSERT_EQUAL_UINT16(50, entry.max_us);
+    TEST_ASSERT_EQUAL_UINT16(3, entry.count);
+}
+
+// Test that durations above 16 bits saturate in the protocol entry
+void test_phase_stats_saturates()
+{
+    PhaseStats stats;
+    stats.add(100000);
+
+    Protocol::StatsEntry entry = stats.toEntry();
+    TEST_ASSERT_EQUAL_UINT16(0xFFFF, entry.min_us);
+    TEST_ASSERT_EQUAL_UINT16(0xFFFF, entry.avg_us);
+    TEST_ASSERT_EQUAL_UINT16(0xFFFF, entry.max_us);
+}
+
+// Test that a scope records its duration into the phase
+void test_scope_records_phase()
+{
+    g_mock_micros = 1000;
+    {
+        PROFILE_PHASE(PHASE_SCAN);
+        g_mock_micros = 1120;
+    }
+
+    Protocol::Stats stats;
+    fillStats(stats, 0);
+    TEST_ASSERT_EQUAL_UINT8(PHASE_COUNT, stats.num_phases);
+    TEST_ASSERT_EQUAL_UINT16(1, stats.phases[PHASE_SCAN].count);
+    TEST_ASSERT_EQUAL_UINT16(120, stats.phases[PHASE_SCAN].max_us);
+    TEST_ASSERT_EQUAL_UINT16(0, stats.phases[PHASE_SEND].count);
+}
+
+// Test per-sensor scan times
+void test_scope_records_sensor()
+{
+    g_mock_micros = 0;
+    {
+        PROFILE_SENSOR(2);
+        g_mock_micros = 40;
+    }
+
+    Protocol::Stats stats;
+    fillStats(stats, 3, 1);
+    TEST_ASSERT_EQUAL_UINT8(2, stats.num_sensors);
+    TEST_ASSERT_EQUAL_UINT16(0, stats.sensors[0].count); // Sensor 1
+    TEST_ASSERT_EQUAL_UINT16(1, stats.sensors[1].count); // Sensor 2
+    TEST_ASSERT_EQUAL_UINT16(40, stats.sensors[1].avg_us);
+}
+
+// Test that the sensor count is clamped to the profiled inputs and a page
+void test_fill_stats_clamps_sensors()
+{
+    Protocol::Stats stats;
+    fillStats(stats, Protocol::MAX_STATS_SENSORS + 4);
+
+    TEST_ASSERT_EQUAL_UINT8(Protocol::MAX_STATS_SENSORS, stats.total_sensors);
+    TEST_ASSERT_EQUAL_UINT8(Protocol::MAX_STATS_SENSORS_PER_MESSAGE, stats.num_sensors);
+}
+
+// Test that sensor entries are paged from first_sensor
+void test_fill_stats_pages_sensors()
+{
+    recordSensor(4, 70);
+
+    Protocol::Stats stats;
+    fillStats(stats, 5, 4);
+    TEST_ASSERT_EQUAL_UINT8(4, stats.first_sensor);
+    TEST_ASSERT_EQUAL_UINT8(5, stats.total_sensors);
+    TEST_ASSERT_EQUAL_UINT8(1, stats.num_sensors); // Last page
+    TEST_ASSERT_EQUAL_UINT16(70, stats.sensors[0].max_us);
+
+    fillStats(stats, 5, 5);
+    TEST_ASSERT_EQUAL_UINT8(0, stats.num_sensors); // Past the end
+}
+
+// Test worst loop period tracking
+void test_loop_max_period()
+{
+    markLoop(0);
+    markLoop(200);
+    markLoop(1700); // 1500us gap
+    markLoop(1900);
+
+    Protocol::Stats stats;
+    fillStats(stats, 0);
+    TEST_ASSERT_EQUAL_UINT32(1500, stats.loop_max_us);
+}
+
+// Test that reset clears everything and restarts the loop period measurement
+void test_reset()
+{
+    recordPhase(PHASE_DRAIN, 10);
+    recordSensor(0, 10);
+    markLoop(0);
+    markLoop(5000);
+
+    reset();
+    markLoop(10000); // First mark after reset doesn't measure a period
+
+    Protocol::Stats stats;
+    fillStats(stats, 1);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.loop_max_us);
+    TEST_ASSERT_EQUAL_UINT16(0, stats.phases[PHASE_DRAIN].count);
+    TEST_ASSERT_EQUAL_UINT16(0, stats.sensors[0].count);
+}
+
+void setUp(void)
+{
+    reset();
+    g_mock_micros = 0;
+}
+
+void tearDown(void) {}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_phase_stats_empty);
+    RUN_TEST(test_phase_stats_min_avg_max);
+    RUN_TEST(test_phase_stats_saturates);
+    RUN_TEST(test_scope_records_phase);
+    RUN_TEST(test_scope_records_sensor);
+    RUN_TEST(test_fill_stats_clamps_sensors);
+    RUN_TEST(test_fill_stats_pages_sensors);
+    RUN_TEST(test_loop_max_period);
+    RUN_TEST(test_reset);
+
+    return UNITY_END();
+}
@@ -193,11 +193,19 @@ void test_configure_encode()
     cfg.input_type = INPUT_TYPE_ANALOG;
     cfg.analog.pin = 0xA0; // A0
     cfg.analog.sensitivity = 128;
+    cfg.analog.filter_type = ANALOG_FILTER_ONE_EURO;
+    cfg.analog.filter_param1 = 20;
+    cfg.analog.filter_param2 = 40;
+    cfg.analog.oversample_bits = 2;
+    cfg.analog.deadband = ANALOG_DEADBAND_AUTO;
+    cfg.analog.hysteresis = 3;
+    cfg.analog.jump = 32;
+    cfg.analog.keepalive = 50;
 
     uint8_t buffer[64];
     size_t size = cfg.encode(buffer, sizeof(buffer));
 
-    TEST_ASSERT_EQUAL(10, size);
+    TEST_ASSERT_EQUAL(18, size);
     TEST_ASSERT_EQUAL_UINT8(MESSAGE_TYPE_CONFIGURE, buffer[0]);
     TEST_ASSERT_EQUAL_UINT8(0x01, buffer[1]); // config_id byte 0 (LE)
     TEST_ASSERT_EQUAL_UINT8(0x00, buffer[2]); // config_id byte 1 (LE)
@@ -208,6 +216,14 @@ void test_configure_encode()
     TEST_ASSERT_EQUAL_UINT8(INPUT_TYPE_ANALOG, buffer[7]); // input_type
     TEST_ASSERT_EQUAL_UINT8(0xA0, buffer[8]); // pin
     TEST_ASSERT_EQUAL_UINT8(128, buffer[9]); // sensitivity
+    TEST_ASSERT_EQUAL_UINT8(ANALOG_FILTER_ONE_EURO, buffer[10]); // filter_type
+    TEST_ASSERT_EQUAL_UINT8(20, buffer[11]); // filter_param1
+    TEST_ASSERT_EQUAL_UINT8(40, buffer[12]); // filter_param2
+    TEST_ASSERT_EQUAL_UINT8(2, buffer[13]); // oversample_bits
+    TEST_ASSERT_EQUAL_UINT8(ANALOG_DEADBAND_AUTO, buffer[14]); // deadband
+    TEST_ASSERT_EQUAL_UINT8(3, buffer[15]); // hysteresis
+    TEST_ASSERT_EQUAL_UINT8(32, buffer[16]); // jump
+    TEST_ASSERT_EQUAL_UINT8(50, buffer[17]); // keepalive
 }
 
 // Test Configure decoding for Analog
@@ -225,6 +241,39 @@ void test_configure_decode()
     TEST_ASSERT_EQUAL_UINT8(INPUT_TYPE_ANALOG, cfg.input_type);
     TEST_ASSERT_EQUAL_UINT8(0xA0, cfg.analog.pin);
     TEST_ASSERT_EQUAL_UINT8(0x80, cfg.analog.sensitivity);
+
+    // Optional fields omitted - defaults to no filter, no oversampling, default deadband
+    TEST_ASSERT_EQUAL_UINT8(ANALOG_FILTER_NONE, cfg.analog.filter_type);
+    TEST_ASSERT_EQUAL_UINT8(0, cfg.analog.oversample_bits);
+    TEST_ASSERT_EQUAL_UINT8(ANALOG_DEADBAND_DEFAULT, cfg.analog.deadband);
+    TEST_ASSERT_EQUAL_UINT8(0, cfg.analog.hysteresis);
+    TEST_ASSERT_EQUAL_UINT8(ANALOG_JUMP_DEFAULT, cfg.analog.jump);
+    TEST_ASSERT_EQUAL_UINT8(0, cfg.analog.keepalive);
+}
+
+// Test Configure decoding for Analog with filter settings
+void test_configure_decode_analog_filter()
+{
+    uint8_t buffer[] = { MESSAGE_TYPE_CONFIGURE, 0x01, 0x00, 0x00, 0x00, 0x03, 0x00, INPUT_TYPE_ANALOG, 0xA0, 0x80, ANALOG_FILTER_EMA, 32, 0 };
+
+    Configure cfg;
+    TEST_ASSERT_TRUE(cfg.decode(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_UINT8(ANALOG_FILTER_EMA, cfg.analog.filter_type);
+    TEST_ASSERT_EQUAL_UINT8(32, cfg.analog.filter_param1);
+    TEST_ASSERT_EQUAL_UINT8(0, cfg.analog.filter_param2);
+    TEST_ASSERT_EQUAL_UINT8(0, cfg.analog.oversample_bits);
+}
+
+// Test Configure decoding for Analog with a deadband but no hysteresis
+void test_configure_decode_analog_deadband()
+{
+    uint8_t buffer[] = { MESSAGE_TYPE_CONFIGURE, 0x01, 0x00, 0x00, 0x00, 0x03, 0x00, INPUT_TYPE_ANALOG, 0xA0, 0x80, ANALOG_FILTER_NONE, 0, 0, 1, 6 };
+
+    Configure cfg;
+    TEST_ASSERT_TRUE(cfg.decode(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_UINT8(1, cfg.analog.oversample_bits);
+    TEST_ASSERT_EQUAL_UINT8(6, cfg.analog.deadband);
+    TEST_ASSERT_EQUAL_UINT8(0, cfg.analog.hysteresis);
 }
 
 // Test Configure decode with insufficient data
@@ -248,6 +297,14 @@ void test_configure_roundtrip()
     original.input_type = INPUT_TYPE_ANALOG;
     original.analog.pin = 0xA1;
     original.analog.sensitivity = 200;
+    original.analog.filter_type = ANALOG_FILTER_MEDIAN3;
+    original.analog.filter_param1 = 7;
+    original.analog.filter_param2 = 9;
+    original.analog.oversample_bits = 3;
+    original.analog.deadband = 5;
+    original.analog.hysteresis = 2;
+    original.analog.jump = ANALOG_JUMP_OFF;
+    original.analog.keepalive = 100;
 
     uint8_t buffer[64];
     size_t size = original.encode(buffer, sizeof(buffer));
@@ -262,6 +319,14 @@ void test_configure_roundtrip()
     TEST_ASSERT_EQUAL_UINT8(original.input_type, decoded.input_type);
     TEST_ASSERT_EQUAL_UINT8(original.analog.pin, decoded.analog.pin);
     TEST_ASSERT_EQUAL_UINT8(original.analog.sensitivity, decoded.analog.sensitivity);
+    TEST_ASSERT_EQUAL_UINT8(original.analog.filter_type, decoded.analog.filter_type);
+    TEST_ASSERT_EQUAL_UINT8(original.analog.filter_param1, decoded.analog.filter_param1);
+    TEST_ASSERT_EQUAL_UINT8(original.analog.filter_param2, decoded.analog.filter_param2);
+    TEST_ASSERT_EQUAL_UINT8(original.analog.oversample_bits, decoded.analog.oversample_bits);
+    TEST_ASSERT_EQUAL_UINT8(original.analog.deadband, decoded.analog.deadband);
+    TEST_ASSERT_EQUAL_UINT8(original.analog.hysteresis, decoded.analog.hysteresis);
+    TEST_ASSERT_EQUAL_UINT8(original.analog.jump, decoded.analog.jump);
+    TEST_ASSERT_EQUAL_UINT8(original.analog.keepalive, decoded.analog.keepalive);
 }
 
 // Test Configure encoding for Button
@@ -274,15 +339,19 @@ void test_configure_button_encode()
     cfg.input_type = INPUT_TYPE_BUTTON;
     cfg.button.pin = 7;
     cfg.button.debounce = 3;
+    cfg.button.press_lockout = 20;
+    cfg.button.release_lockout = DEBOUNCE_LOCKOUT_OFF;
 
     uint8_t buffer[64];
     size_t size = cfg.encode(buffer, sizeof(buffer));
 
-    TEST_ASSERT_EQUAL(10, size); // header(8) + pin(1) + debounce(1)
+    TEST_ASSERT_EQUAL(12, size); // header(8) + pin(1) + debounce(1) + lockouts(2)
     TEST_ASSERT_EQUAL_UINT8(MESSAGE_TYPE_CONFIGURE, buffer[0]);
     TEST_ASSERT_EQUAL_UINT8(INPUT_TYPE_BUTTON, buffer[7]);
     TEST_ASSERT_EQUAL_UINT8(7, buffer[8]); // pin
     TEST_ASSERT_EQUAL_UINT8(3, buffer[9]); // debounce
+    TEST_ASSERT_EQUAL_UINT8(20, buffer[10]); // press_lockout
+    TEST_ASSERT_EQUAL_UINT8(DEBOUNCE_LOCKOUT_OFF, buffer[11]); // release_lockout
 }
 
 // Test Configure decoding for Button
@@ -300,6 +369,8 @@ void test_configure_button_decode()
     TEST_ASSERT_EQUAL_UINT8(INPUT_TYPE_BUTTON, cfg.input_type);
     TEST_ASSERT_EQUAL_UINT8(7, cfg.button.pin);
     TEST_ASSERT_EQUAL_UINT8(3, cfg.button.debounce);
+    TEST_ASSERT_EQUAL_UINT8(DEBOUNCE_LOCKOUT_OFF, cfg.button.press_lockout); // Omitted
+    TEST_ASSERT_EQUAL_UINT8(DEBOUNCE_LOCKOUT_OFF, cfg.button.release_lockout); // Omitted
 }
 
 // Test Configure roundtrip for Button
@@ -312,6 +383,8 @@ void test_configure_button_roundtrip()
     original.input_type = INPUT_TYPE_BUTTON;
     original.button.pin = 12;
     original.button.debounce = 5;
+    original.button.press_lockout = 8;
+    original.button.release_lockout = 30;
 
     uint8_t buffer[64];
     size_t size = original.encode(buffer, sizeof(buffer));
@@ -326,6 +399,8 @@ void test_configure_button_roundtrip()
     TEST_ASSERT_EQUAL_UINT8(original.input_type, decoded.input_type);
     TEST_ASSERT_EQUAL_UINT8(original.button.pin, decoded.button.pin);
     TEST_ASSERT_EQUAL_UINT8(original.button.debounce, decoded.button.debounce);
+    TEST_ASSERT_EQUAL_UINT8(original.button.press_lockout, decoded.button.press_lockout);
+    TEST_ASSERT_EQUAL_UINT8(original.button.release_lockout, decoded.button.release_lockout);
 }
 
 // Test Configure encoding for Matrix
@@ -347,12 +422,18 @@ void test_configure_matrix_encode()
     cfg.matrix.pins[4] = 6;
     cfg.matrix.pins[5] = 7;
     cfg.matrix.pins[6] = 8;
+    cfg.matrix.settle_us = 20;
+    cfg.matrix.rows_per_tick = 2;
+    cfg.matrix.diode_direction = MATRIX_DIODES_NONE;
+    cfg.matrix.press_lockout = 5;
+    cfg.matrix.release_lockout = 15;
+    cfg.matrix.debounce = 4;
 
     uint8_t buffer[64];
     size_t size = cfg.encode(buffer, sizeof(buffer));
 
-    // header(8) + num_row_pins(1) + num_col_pins(1) + pins(7) = 17
-    TEST_ASSERT_EQUAL(17, size);
+    // header(8) + counts(2) + pins(7) + settle_us(1) + rows_per_tick(1) + diode_direction(1) + lockouts(2) + debounce(1) = 23
+    TEST_ASSERT_EQUAL(23, size);
     TEST_ASSERT_EQUAL_UINT8(MESSAGE_TYPE_CONFIGURE, buffer[0]);
     TEST_ASSERT_EQUAL_UINT8(INPUT_TYPE_MATRIX, buffer[7]);
     TEST_ASSERT_EQUAL_UINT8(3, buffer[8]); // num_row_pins
@@ -364,6 +445,12 @@ void test_configure_matrix_encode()
     TEST_ASSERT_EQUAL_UINT8(6, buffer[14]); // col pin 1
     TEST_ASSERT_EQUAL_UINT8(7, buffer[15]); // col pin 2
     TEST_ASSERT_EQUAL_UINT8(8, buffer[16]); // col pin 3
+    TEST_ASSERT_EQUAL_UINT8(20, buffer[17]); // settle_us
+    TEST_ASSERT_EQUAL_UINT8(2, buffer[18]); // rows_per_tick
+    TEST_ASSERT_EQUAL_UINT8(MATRIX_DIODES_NONE, buffer[19]); // diode_direction
+    TEST_ASSERT_EQUAL_UINT8(5, buffer[20]); // press_lockout
+    TEST_ASSERT_EQUAL_UINT8(15, buffer[21]); // release_lockout
+    TEST_ASSERT_EQUAL_UINT8(4, buffer[22]); // debounce
 }
 
 // Test Configure decoding for Matrix
@@ -396,6 +483,12 @@ void test_configure_matrix_decode()
     TEST_ASSERT_EQUAL_UINT8(0x0C, cfg.matrix.pins[2]); // col 0
     TEST_ASSERT_EQUAL_UINT8(0x0D, cfg.matrix.pins[3]); // col 1
     TEST_ASSERT_EQUAL_UINT8(0x0E, cfg.matrix.pins[4]); // col 2
+    TEST_ASSERT_EQUAL_UINT8(MATRIX_SETTLE_DEFAULT, cfg.matrix.settle_us); // Omitted
+    TEST_ASSERT_EQUAL_UINT8(MATRIX_ROWS_PER_TICK_ALL, cfg.matrix.rows_per_tick); // Omitted
+    TEST_ASSERT_EQUAL_UINT8(MATRIX_DIODES_COL_TO_ROW, cfg.matrix.diode_direction); // Omitted
+    TEST_ASSERT_EQUAL_UINT8(DEBOUNCE_LOCKOUT_OFF, cfg.matrix.press_lockout); // Omitted
+    TEST_ASSERT_EQUAL_UINT8(DEBOUNCE_LOCKOUT_OFF, cfg.matrix.release_lockout); // Omitted
+    TEST_ASSERT_EQUAL_UINT8(MATRIX_DEBOUNCE_DEFAULT, cfg.matrix.debounce); // Omitted
 }
 
 // Test Configure roundtrip for Matrix
@@ -411,6 +504,12 @@ void test_configure_matrix_roundtrip()
     for (uint8_t i = 0; i < 8; i++) {
         original.matrix.pins[i] = i + 10;
     }
+    original.matrix.settle_us = 40;
+    original.matrix.rows_per_tick = 3;
+    original.matrix.diode_direction = MATRIX_DIODES_ROW_TO_COL;
+    original.matrix.press_lockout = 10;
+    original.matrix.release_lockout = 0;
+    original.matrix.debounce = 8;
 
     uint8_t buffer[64];
     size_t size = original.encode(buffer, sizeof(buffer));
@@ -428,6 +527,12 @@ void test_configure_matrix_roundtrip()
     for (uint8_t i = 0; i < 8; i++) {
         TEST_ASSERT_EQUAL_UINT8(original.matrix.pins[i], decoded.matrix.pins[i]);
     }
+    TEST_ASSERT_EQUAL_UINT8(original.matrix.settle_us, decoded.matrix.settle_us);
+    TEST_ASSERT_EQUAL_UINT8(original.matrix.rows_per_tick, decoded.matrix.rows_per_tick);
+    TEST_ASSERT_EQUAL_UINT8(original.matrix.diode_direction, decoded.matrix.diode_direction);
+    TEST_ASSERT_EQUAL_UINT8(original.matrix.press_lockout, decoded.matrix.press_lockout);
+    TEST_ASSERT_EQUAL_UINT8(original.matrix.release_lockout, decoded.matrix.release_lockout);
+    TEST_ASSERT_EQUAL_UINT8(original.matrix.debounce, decoded.matrix.debounce);
 }
 
 // Test Configure decode with insufficient data for matrix
@@ -470,6 +575,174 @@ void test_configure_matrix_decode_too_many_pins()
     TEST_ASSERT_FALSE(result);
 }
 
+// Test Configure encoding for Notched
+void test_configure_notched_encode()
+{
+    Configure cfg;
+    cfg.config_id = 0x00000004;
+    cfg.total_parts = 1;
+    cfg.part_number = 0;
+    cfg.input_type = INPUT_TYPE_NOTCHED;
+    cfg.notched.pin = 14;
+    cfg.notched.hysteresis = 8;
+    cfg.notched.button_base = 200;
+    cfg.notched.num_boundaries = 2;
+    cfg.notched.boundaries[0] = 0x0154;
+    cfg.notched.boundaries[1] = 0x02A8;
+
+    uint8_t buffer[64];
+    size_t size = cfg.encode(buffer, sizeof(buffer));
+
+    // header(8) + pin + hysteresis + button_base + num_boundaries + boundaries(4) = 16
+    TEST_ASSERT_EQUAL(16, size);
+    TEST_ASSERT_EQUAL_UINT8(INPUT_TYPE_NOTCHED, buffer[7]);
+    TEST_ASSERT_EQUAL_UINT8(14, buffer[8]); // pin
+    TEST_ASSERT_EQUAL_UINT8(8, buffer[9]); // hysteresis
+    TEST_ASSERT_EQUAL_UINT8(200, buffer[10]); // button_base
+    TEST_ASSERT_EQUAL_UINT8(2, buffer[11]); // num_boundaries
+    TEST_ASSERT_EQUAL_UINT8(0x54, buffer[12]);
+    TEST_ASSERT_EQUAL_UINT8(0x01, buffer[13]);
+    TEST_ASSERT_EQUAL_UINT8(0xA8, buffer[14]);
+    TEST_ASSERT_EQUAL_UINT8(0x02, buffer[15]);
+}
+
+// Test Configure roundtrip for Notched
+void test_configure_notched_roundtrip()
+{
+    Configure original;
+    original.config_id = 0x55667788;
+    original.total_parts = 1;
+    original.part_number = 0;
+    original.input_type = INPUT_TYPE_NOTCHED;
+    original.notched.pin = 15;
+    original.notched.hysteresis = 4;
+    original.notched.button_base = 0;
+    original.notched.num_boundaries = MAX_NOTCH_BOUNDARIES;
+    for (uint8_t i = 0; i < MAX_NOTCH_BOUNDARIES; i++) {
+        original.notched.boundaries[i] = (i + 1) * 85;
+    }
+
+    uint8_t buffer[64];
+    size_t size = original.encode(buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL(8 + 4 + MAX_NOTCH_BOUNDARIES * 2, size);
+
+    Configure decoded;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size));
+    TEST_ASSERT_EQUAL_UINT8(INPUT_TYPE_NOTCHED, decoded.input_type);
+    TEST_ASSERT_EQUAL_UINT8(original.notched.pin, decoded.notched.pin);
+    TEST_ASSERT_EQUAL_UINT8(original.notched.hysteresis, decoded.notched.hysteresis);
+    TEST_ASSERT_EQUAL_UINT8(original.notched.button_base, decoded.notched.button_base);
+    TEST_ASSERT_EQUAL_UINT8(MAX_NOTCH_BOUNDARIES, decoded.notched.num_boundaries);
+    for (uint8_t i = 0; i < MAX_NOTCH_BOUNDARIES; i++) {
+        TEST_ASSERT_EQUAL_UINT16(original.notched.boundaries[i], decoded.notched.boundaries[i]);
+    }
+}
+
+// Test Configure decode with insufficient data for notched boundaries
+void test_configure_notched_decode_insufficient_data()
+{
+    uint8_t buffer[] = {
+        MESSAGE_TYPE_CONFIGURE,
+        0x04, 0x00, 0x00, 0x00, // config_id
+        0x01, // total_parts
+        0x00, // part_number
+        INPUT_TYPE_NOTCHED,
+        0x0E, // pin
+        0x08, // hysteresis
+        0x00, // button_base
+        0x02, // num_boundaries
+        0x54, 0x01 // Only 1 boundary, need 2
+    };
+
+    Configure cfg;
+    TEST_ASSERT_FALSE(cfg.decode(buffer, sizeof(buffer)));
+}
+
+// Test Configure decode with too many notch boundaries
+void test_configure_notched_decode_too_many_boundaries()
+{
+    uint8_t buffer[64] = {
+        MESSAGE_TYPE_CONFIGURE,
+        0x04, 0x00, 0x00, 0x00, // config_id
+        0x01, // total_parts
+        0x00, // part_number
+        INPUT_TYPE_NOTCHED,
+        0x0E, // pin
+        0x08, // hysteresis
+        0x00, // button_base
+        MAX_NOTCH_BOUNDARIES + 1
+    };
+
+    Configure cfg;
+    TEST_ASSERT_FALSE(cfg.decode(buffer, sizeof(buffer)));
+}
+
+// Test Configure encoding for Encoder
+void test_configure_encoder_encode()
+{
+    Configure cfg;
+    cfg.config_id = 0x00000005;
+    cfg.total_parts = 1;
+    cfg.part_number = 0;
+    cfg.input_type = INPUT_TYPE_ENCODER;
+    cfg.encoder.pin_a = 2;
+    cfg.encoder.pin_b = 3;
+    cfg.encoder.steps_per_detent = 2;
+    cfg.encoder.acceleration = 4;
+
+    uint8_t buffer[64];
+    size_t size = cfg.encode(buffer, sizeof(buffer));
+
+    TEST_ASSERT_EQUAL(12, size); // header(8) + pins(2) + steps per detent(1) + acceleration(1)
+    TEST_ASSERT_EQUAL_UINT8(INPUT_TYPE_ENCODER, buffer[7]);
+    TEST_ASSERT_EQUAL_UINT8(2, buffer[8]); // pin_a
+    TEST_ASSERT_EQUAL_UINT8(3, buffer[9]); // pin_b
+    TEST_ASSERT_EQUAL_UINT8(2, buffer[10]); // steps_per_detent
+    TEST_ASSERT_EQUAL_UINT8(4, buffer[11]); // acceleration
+}
+
+// Test Configure decoding for Encoder with only the pins
+void test_configure_encoder_decode_defaults()
+{
+    uint8_t buffer[] = { MESSAGE_TYPE_CONFIGURE, 0x05, 0x00, 0x00, 0x00, 0x01, 0x00, INPUT_TYPE_ENCODER, 0x02, 0x03 };
+
+    Configure cfg;
+    TEST_ASSERT_TRUE(cfg.decode(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_UINT8(INPUT_TYPE_ENCODER, cfg.input_type);
+    TEST_ASSERT_EQUAL_UINT8(2, cfg.encoder.pin_a);
+    TEST_ASSERT_EQUAL_UINT8(3, cfg.encoder.pin_b);
+    TEST_ASSERT_EQUAL_UINT8(ENCODER_STEPS_DEFAULT, cfg.encoder.steps_per_detent); // Omitted
+    TEST_ASSERT_EQUAL_UINT8(ENCODER_ACCEL_OFF, cfg.encoder.acceleration); // Omitted
+
+    // Both pins are required
+    TEST_ASSERT_FALSE(cfg.decode(buffer, sizeof(buffer) - 1));
+}
+
+// Test Configure roundtrip for Encoder
+void test_configure_encoder_roundtrip()
+{
+    Configure original;
+    original.config_id = 0x12345678;
+    original.total_parts = 2;
+    original.part_number = 1;
+    original.input_type = INPUT_TYPE_ENCODER;
+    original.encoder.pin_a = 18;
+    original.encoder.pin_b = 19;
+    original.encoder.steps_per_detent = 4;
+    original.encoder.acceleration = 10;
+
+    uint8_t buffer[64];
+    size_t size = original.encode(buffer, sizeof(buffer));
+
+    Configure decoded;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size));
+    TEST_ASSERT_EQUAL_UINT8(INPUT_TYPE_ENCODER, decoded.input_type);
+    TEST_ASSERT_EQUAL_UINT8(original.encoder.pin_a, decoded.encoder.pin_a);
+    TEST_ASSERT_EQUAL_UINT8(original.encoder.pin_b, decoded.encoder.pin_b);
+    TEST_ASSERT_EQUAL_UINT8(original.encoder.steps_per_detent, decoded.encoder.steps_per_detent);
+    TEST_ASSERT_EQUAL_UINT8(original.encoder.acceleration, decoded.encoder.acceleration);
+}
+
 // Test Configure decode with unknown input type
 void test_configure_decode_unknown_type()
 {
@@ -661,6 +934,55 @@ void test_message_decode_configuration_error()
 
 // SetOutput tests
 
+void test_input_value_encode()
+{
+    InputValue iv;
+    iv.pin = 130;
+    iv.value = -2;
+    iv.time_us = 0x12345678;
+
+    uint8_t buffer[16];
+    size_t size = iv.encode(buffer, sizeof(buffer));
+
+    TEST_ASSERT_EQUAL(8, size);
+    TEST_ASSERT_EQUAL_UINT8(MESSAGE_TYPE_INPUT_VALUE, buffer[0]);
+    TEST_ASSERT_EQUAL_UINT8(130, buffer[1]);
+    TEST_ASSERT_EQUAL_UINT8(0xFE, buffer[2]);
+    TEST_ASSERT_EQUAL_UINT8(0xFF, buffer[3]);
+    TEST_ASSERT_EQUAL_UINT8(0x78, buffer[4]);
+    TEST_ASSERT_EQUAL_UINT8(0x56, buffer[5]);
+    TEST_ASSERT_EQUAL_UINT8(0x34, buffer[6]);
+    TEST_ASSERT_EQUAL_UINT8(0x12, buffer[7]);
+}
+
+void test_input_value_roundtrip()
+{
+    InputValue original;
+    original.pin = 7;
+    original.value = 1023;
+    original.time_us = 4000000000UL;
+
+    uint8_t buffer[16];
+    size_t size = original.encode(buffer, sizeof(buffer));
+
+    InputValue decoded;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size));
+    TEST_ASSERT_EQUAL_UINT8(original.pin, decoded.pin);
+    TEST_ASSERT_EQUAL_INT16(original.value, decoded.value);
+    TEST_ASSERT_EQUAL_UINT32(original.time_us, decoded.time_us);
+}
+
+void test_input_value_decode_without_timestamp()
+{
+    uint8_t buffer[] = { MESSAGE_TYPE_INPUT_VALUE, 3, 0x10, 0x00 }; // Older firmware
+
+    InputValue iv;
+    TEST_ASSERT_TRUE(iv.decode(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_UINT8(3, iv.pin);
+    TEST_ASSERT_EQUAL_INT16(16, iv.value);
+    TEST_ASSERT_EQUAL_UINT32(0, iv.time_us);
+}
+
 void test_set_output_encode()
 {
     SetOutput cmd;
@@ -720,6 +1042,376 @@ void test_message_decode_set_output()
     TEST_ASSERT_EQUAL_UINT8(1, msg.set_output.value);
 }
 
+void test_get_stats_encode()
+{
+    GetStats req;
+    req.first_sensor = 4;
+
+    uint8_t buffer[16];
+    size_t size = req.encode(buffer, sizeof(buffer));
+
+    TEST_ASSERT_EQUAL(2, size);
+    TEST_ASSERT_EQUAL_UINT8(MESSAGE_TYPE_GET_STATS, buffer[0]);
+    TEST_ASSERT_EQUAL_UINT8(4, buffer[1]);
+}
+
+void test_get_stats_decode()
+{
+    uint8_t buffer[] = { MESSAGE_TYPE_GET_STATS, 2 };
+
+    GetStats req;
+    TEST_ASSERT_TRUE(req.decode(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_UINT8(2, req.first_sensor);
+
+    // Older hosts send only the type: first page
+    TEST_ASSERT_TRUE(req.decode(buffer, 1));
+    TEST_ASSERT_EQUAL_UINT8(0, req.first_sensor);
+}
+
+void test_stats_encode()
+{
+    Stats stats;
+    stats.loop_max_us = 0x00012345;
+    stats.num_phases = 1;
+    stats.phases[0].min_us = 0x0010;
+    stats.phases[0].avg_us = 0x0020;
+    stats.phases[0].max_us = 0x0130;
+    stats.phases[0].count = 0x0200;
+    stats.num_sensors = 0;
+    stats.event_overflows = 0x0102;
+    stats.missed_deadlines = 0x0304;
+    stats.first_sensor = 0;
+    stats.total_sensors = 0;
+
+    uint8_t buffer[128];
+    size_t size = stats.encode(buffer, sizeof(buffer));
+
+    TEST_ASSERT_EQUAL(21, size);
+    TEST_ASSERT_EQUAL_UINT8(MESSAGE_TYPE_STATS, buffer[0]);
+    TEST_ASSERT_EQUAL_UINT8(0x45, buffer[1]);
+    TEST_ASSERT_EQUAL_UINT8(0x23, buffer[2]);
+    TEST_ASSERT_EQUAL_UINT8(0x01, buffer[3]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, buffer[4]);
+    TEST_ASSERT_EQUAL_UINT8(1, buffer[5]); // num_phases
+    TEST_ASSERT_EQUAL_UINT8(0x10, buffer[6]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, buffer[7]);
+    TEST_ASSERT_EQUAL_UINT8(0x20, buffer[8]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, buffer[9]);
+    TEST_ASSERT_EQUAL_UINT8(0x30, buffer[10]);
+    TEST_ASSERT_EQUAL_UINT8(0x01, buffer[11]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, buffer[12]);
+    TEST_ASSERT_EQUAL_UINT8(0x02, buffer[13]);
+    TEST_ASSERT_EQUAL_UINT8(0, buffer[14]); // num_sensors
+    TEST_ASSERT_EQUAL_UINT8(0x02, buffer[15]); // event_overflows
+    TEST_ASSERT_EQUAL_UINT8(0x01, buffer[16]);
+    TEST_ASSERT_EQUAL_UINT8(0x04, buffer[17]); // missed_deadlines
+    TEST_ASSERT_EQUAL_UINT8(0x03, buffer[18]);
+    TEST_ASSERT_EQUAL_UINT8(0, buffer[19]); // first_sensor
+    TEST_ASSERT_EQUAL_UINT8(0, buffer[20]); // total_sensors
+}
+
+void test_stats_encode_too_many_entries()
+{
+    Stats stats;
+    stats.loop_max_us = 0;
+    stats.num_phases = MAX_STATS_PHASES + 1;
+    stats.num_sensors = 0;
+
+    uint8_t buffer[128];
+    TEST_ASSERT_EQUAL(0, stats.encode(buffer, sizeof(buffer)));
+
+    stats.num_phases = 0;
+    stats.num_sensors = MAX_STATS_SENSORS_PER_MESSAGE + 1;
+    TEST_ASSERT_EQUAL(0, stats.encode(buffer, sizeof(buffer)));
+}
+
+void test_stats_roundtrip()
+{
+    Stats original;
+    original.loop_max_us = 1500;
+    original.num_phases = MAX_STATS_PHASES;
+    for (uint8_t i = 0; i < MAX_STATS_PHASES; i++) {
+        original.phases[i].min_us = 10 + i;
+        original.phases[i].avg_us = 20 + i;
+        original.phases[i].max_us = 300 + i;
+        original.phases[i].count = 1000 + i;
+    }
+    original.num_sensors = MAX_STATS_SENSORS_PER_MESSAGE;
+    for (uint8_t i = 0; i < MAX_STATS_SENSORS_PER_MESSAGE; i++) {
+        original.sensors[i].min_us = 5 + i;
+        original.sensors[i].avg_us = 50 + i;
+        original.sensors[i].max_us = 500 + i;
+        original.sensors[i].count = 60000 + i;
+    }
+    original.event_overflows = 40000;
+    original.missed_deadlines = 12;
+    original.first_sensor = 6;
+    original.total_sensors = 8;
+
+    uint8_t buffer[128];
+    size_t size = original.encode(buffer, sizeof(buffer));
+    TEST_ASSERT_LESS_OR_EQUAL(MAX_PAYLOAD_SIZE, size);
+    TEST_ASSERT_EQUAL(13 + (MAX_STATS_PHASES + MAX_STATS_SENSORS_PER_MESSAGE) * 8, size);
+
+    Stats decoded;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size));
+    TEST_ASSERT_EQUAL_UINT32(original.loop_max_us, decoded.loop_max_us);
+    TEST_ASSERT_EQUAL_UINT8(MAX_STATS_PHASES, decoded.num_phases);
+    TEST_ASSERT_EQUAL_UINT8(MAX_STATS_SENSORS_PER_MESSAGE, decoded.num_sensors);
+    TEST_ASSERT_EQUAL_UINT16(original.event_overflows, decoded.event_overflows);
+    TEST_ASSERT_EQUAL_UINT16(original.missed_deadlines, decoded.missed_deadlines);
+    TEST_ASSERT_EQUAL_UINT8(6, decoded.first_sensor);
+    TEST_ASSERT_EQUAL_UINT8(8, decoded.total_sensors);
+    for (uint8_t i = 0; i < MAX_STATS_PHASES; i++) {
+        TEST_ASSERT_EQUAL_UINT16(original.phases[i].min_us, decoded.phases[i].min_us);
+        TEST_ASSERT_EQUAL_UINT16(original.phases[i].avg_us, decoded.phases[i].avg_us);
+        TEST_ASSERT_EQUAL_UINT16(original.phases[i].max_us, decoded.phases[i].max_us);
+        TEST_ASSERT_EQUAL_UINT16(original.phases[i].count, decoded.phases[i].count);
+    }
+    for (uint8_t i = 0; i < MAX_STATS_SENSORS_PER_MESSAGE; i++) {
+        TEST_ASSERT_EQUAL_UINT16(original.sensors[i].min_us, decoded.sensors[i].min_us);
+        TEST_ASSERT_EQUAL_UINT16(original.sensors[i].avg_us, decoded.sensors[i].avg_us);
+        TEST_ASSERT_EQUAL_UINT16(original.sensors[i].max_us, decoded.sensors[i].max_us);
+        TEST_ASSERT_EQUAL_UINT16(original.sensors[i].count, decoded.sensors[i].count);
+    }
+}
+
+void test_stats_decode_insufficient_data()
+{
+    // Claims one phase entry but only carries half of it
+    uint8_t buffer[] = { MESSAGE_TYPE_STATS, 0, 0, 0, 0, 1, 1, 0, 2, 0 };
+
+    Stats stats;
+    TEST_ASSERT_FALSE(stats.decode(buffer, sizeof(buffer)));
+}
+
+void test_stats_decode_too_many_entries()
+{
+    uint8_t buffer[128] = { MESSAGE_TYPE_STATS, 0, 0, 0, 0, MAX_STATS_PHASES + 1 };
+
+    Stats stats;
+    TEST_ASSERT_FALSE(stats.decode(buffer, sizeof(buffer)));
+}
+
+void test_message_decode_get_stats()
+{
+    uint8_t buffer[] = { MESSAGE_TYPE_GET_STATS };
+
+    Message msg;
+    TEST_ASSERT_TRUE(msg.decode(buffer, sizeof(buffer)));
+    TEST_ASSERT_TRUE(msg.isGetStats());
+}
+
+void test_message_decode_stats()
+{
+    uint8_t buffer[] = { MESSAGE_TYPE_STATS, 0xE8, 0x03, 0, 0, 0, 0 };
+
+    Message msg;
+    TEST_ASSERT_TRUE(msg.decode(buffer, sizeof(buffer)));
+    TEST_ASSERT_TRUE(msg.isStats());
+    TEST_ASSERT_EQUAL_UINT32(1000, msg.stats.loop_max_us);
+    TEST_ASSERT_EQUAL_UINT8(0, msg.stats.num_phases);
+    TEST_ASSERT_EQUAL_UINT8(0, msg.stats.num_sensors);
+    TEST_ASSERT_EQUAL_UINT16(0, msg.stats.event_overflows); // Older firmware
+    TEST_ASSERT_EQUAL_UINT16(0, msg.stats.missed_deadlines);
+    TEST_ASSERT_EQUAL_UINT8(0, msg.stats.first_sensor); // One page
+    TEST_ASSERT_EQUAL_UINT8(0, msg.stats.total_sensors);
+}
+
+void test_calibrate_encode()
+{
+    Calibrate cal;
+    cal.input_index = 2;
+    cal.command = CALIBRATE_SET;
+    cal.flags = CALIBRATION_FLAG_CENTER;
+    cal.min = 0x0064;
+    cal.max = 0x0384;
+    cal.center = 0x01F4;
+
+    uint8_t buffer[16];
+    size_t size = cal.encode(buffer, sizeof(buffer));
+
+    TEST_ASSERT_EQUAL(10, size);
+    TEST_ASSERT_EQUAL_UINT8(MESSAGE_TYPE_CALIBRATE, buffer[0]);
+    TEST_ASSERT_EQUAL_UINT8(2, buffer[1]);
+    TEST_ASSERT_EQUAL_UINT8(CALIBRATE_SET, buffer[2]);
+    TEST_ASSERT_EQUAL_UINT8(CALIBRATION_FLAG_CENTER, buffer[3]);
+    TEST_ASSERT_EQUAL_UINT8(0x64, buffer[4]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, buffer[5]);
+    TEST_ASSERT_EQUAL_UINT8(0x84, buffer[6]);
+    TEST_ASSERT_EQUAL_UINT8(0x03, buffer[7]);
+    TEST_ASSERT_EQUAL_UINT8(0xF4, buffer[8]);
+    TEST_ASSERT_EQUAL_UINT8(0x01, buffer[9]);
+}
+
+void test_calibrate_roundtrip()
+{
+    Calibrate original;
+    original.input_index = 5;
+    original.command = CALIBRATE_STOP_CAPTURE;
+    original.flags = CALIBRATION_FLAG_CENTER | CALIBRATION_FLAG_INVERT;
+    original.min = 0;
+    original.max = 0;
+    original.center = 0;
+
+    uint8_t buffer[16];
+    size_t size = original.encode(buffer, sizeof(buffer));
+
+    Calibrate decoded;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size));
+    TEST_ASSERT_EQUAL_UINT8(original.input_index, decoded.input_index);
+    TEST_ASSERT_EQUAL_UINT8(original.command, decoded.command);
+    TEST_ASSERT_EQUAL_UINT8(original.flags, decoded.flags);
+}
+
+void test_calibrate_decode_insufficient_data()
+{
+    uint8_t buffer[] = { MESSAGE_TYPE_CALIBRATE, 0, CALIBRATE_GET, 0 };
+
+    Calibrate cal;
+    TEST_ASSERT_FALSE(cal.decode(buffer, sizeof(buffer)));
+}
+
+void test_calibration_data_roundtrip()
+{
+    CalibrationData original;
+    original.input_index = 1;
+    original.status = CALIBRATION_STATUS_OK;
+    original.flags = CALIBRATION_FLAG_VALID | CALIBRATION_FLAG_CENTER;
+    original.min = 12;
+    original.max = 1010;
+    original.center = 515;
+
+    uint8_t buffer[16];
+    size_t size = original.encode(buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL(10, size);
+    TEST_ASSERT_EQUAL_UINT8(MESSAGE_TYPE_CALIBRATION_DATA, buffer[0]);
+
+    CalibrationData decoded;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size));
+    TEST_ASSERT_EQUAL_UINT8(original.input_index, decoded.input_index);
+    TEST_ASSERT_EQUAL_UINT8(original.status, decoded.status);
+    TEST_ASSERT_EQUAL_UINT8(original.flags, decoded.flags);
+    TEST_ASSERT_EQUAL_UINT16(original.min, decoded.min);
+    TEST_ASSERT_EQUAL_UINT16(original.max, decoded.max);
+    TEST_ASSERT_EQUAL_UINT16(original.center, decoded.center);
+}
+
+void test_calibration_data_encode_buffer_too_small()
+{
+    CalibrationData data = {};
+
+    uint8_t buffer[9];
+    TEST_ASSERT_EQUAL(0, data.encode(buffer, sizeof(buffer)));
+}
+
+void test_message_decode_calibrate()
+{
+    uint8_t buffer[] = { MESSAGE_TYPE_CALIBRATE, 3, CALIBRATE_START_CAPTURE, 0, 0, 0, 0, 0, 0, 0 };
+
+    Message msg;
+    TEST_ASSERT_TRUE(msg.decode(buffer, sizeof(buffer)));
+    TEST_ASSERT_TRUE(msg.isCalibrate());
+    TEST_ASSERT_EQUAL_UINT8(3, msg.calibrate.input_index);
+    TEST_ASSERT_EQUAL_UINT8(CALIBRATE_START_CAPTURE, msg.calibrate.command);
+}
+
+void test_message_decode_calibration_data()
+{
+    uint8_t buffer[] = { MESSAGE_TYPE_CALIBRATION_DATA, 0, CALIBRATION_STATUS_INVALID_RANGE, 0, 0, 0, 0, 0, 0, 0 };
+
+    Message msg;
+    TEST_ASSERT_TRUE(msg.decode(buffer, sizeof(buffer)));
+    TEST_ASSERT_TRUE(msg.isCalibrationData());
+    TEST_ASSERT_EQUAL_UINT8(CALIBRATION_STATUS_INVALID_RANGE, msg.calibration_data.status);
+}
+
+// MatrixState tests
+
+void test_matrix_state_encode()
+{
+    MatrixState state = {};
+    state.input_index = 2;
+    state.rollover = 2;
+    state.num_buttons = 12; // 3x4 matrix
+    state.pressed[0] = 0x81;
+    state.pressed[1] = 0x08;
+    state.blocked[0] = 0x06;
+
+    uint8_t buffer[16];
+    size_t size = state.encode(buffer, sizeof(buffer));
+
+    TEST_ASSERT_EQUAL(8, size); // 1 type + 3 u8 + 2 bitmaps of 2 bytes
+    TEST_ASSERT_EQUAL_UINT8(MESSAGE_TYPE_MATRIX_STATE, buffer[0]);
+    TEST_ASSERT_EQUAL_UINT8(2, buffer[1]);
+    TEST_ASSERT_EQUAL_UINT8(2, buffer[2]);
+    TEST_ASSERT_EQUAL_UINT8(12, buffer[3]);
+    TEST_ASSERT_EQUAL_UINT8(0x81, buffer[4]);
+    TEST_ASSERT_EQUAL_UINT8(0x08, buffer[5]);
+    TEST_ASSERT_EQUAL_UINT8(0x06, buffer[6]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, buffer[7]);
+}
+
+void test_matrix_state_roundtrip()
+{
+    MatrixState original = {};
+    original.input_index = 0;
+    original.rollover = MATRIX_ROLLOVER_NKRO;
+    original.num_buttons = MAX_MATRIX_STATE_BUTTONS;
+    for (uint8_t i = 0; i < MAX_MATRIX_STATE_BUTTONS / 8; i++) {
+        original.pressed[i] = (uint8_t)(0x11 * i);
+        original.blocked[i] = (uint8_t)(0x80 >> i);
+    }
+
+    uint8_t buffer[32];
+    size_t size = original.encode(buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL(4 + 2 * (MAX_MATRIX_STATE_BUTTONS / 8), size);
+
+    MatrixState decoded;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size));
+    TEST_ASSERT_EQUAL_UINT8(original.input_index, decoded.input_index);
+    TEST_ASSERT_EQUAL_UINT8(original.rollover, decoded.rollover);
+    TEST_ASSERT_EQUAL_UINT8(original.num_buttons, decoded.num_buttons);
+    for (uint8_t i = 0; i < MAX_MATRIX_STATE_BUTTONS / 8; i++) {
+        TEST_ASSERT_EQUAL_UINT8(original.pressed[i], decoded.pressed[i]);
+        TEST_ASSERT_EQUAL_UINT8(original.blocked[i], decoded.blocked[i]);
+    }
+}
+
+void test_matrix_state_too_many_buttons()
+{
+    MatrixState state = {};
+    state.num_buttons = MAX_MATRIX_STATE_BUTTONS + 1;
+
+    uint8_t buffer[32];
+    TEST_ASSERT_EQUAL(0, state.encode(buffer, sizeof(buffer)));
+
+    uint8_t message[4 + 2 * 9] = { MESSAGE_TYPE_MATRIX_STATE, 0, 0, MAX_MATRIX_STATE_BUTTONS + 1 };
+    TEST_ASSERT_FALSE(state.decode(message, sizeof(message)));
+}
+
+void test_matrix_state_decode_truncated_bitmap()
+{
+    uint8_t buffer[] = { MESSAGE_TYPE_MATRIX_STATE, 0, 0, 12, 0xFF, 0x00, 0x00 }; // Needs 2 + 2 bitmap bytes
+
+    MatrixState state;
+    TEST_ASSERT_FALSE(state.decode(buffer, sizeof(buffer)));
+}
+
+void test_message_decode_matrix_state()
+{
+    uint8_t buffer[] = { MESSAGE_TYPE_MATRIX_STATE, 1, 2, 4, 0x05, 0x02 };
+
+    Message msg;
+    TEST_ASSERT_TRUE(msg.decode(buffer, sizeof(buffer)));
+    TEST_ASSERT_TRUE(msg.isMatrixState());
+    TEST_ASSERT_EQUAL_UINT8(1, msg.matrix_state.input_index);
+    TEST_ASSERT_EQUAL_UINT8(2, msg.matrix_state.rollover);
+    TEST_ASSERT_EQUAL_UINT8(4, msg.matrix_state.num_buttons);
+    TEST_ASSERT_EQUAL_UINT8(0x05, msg.matrix_state.pressed[0]);
+    TEST_ASSERT_EQUAL_UINT8(0x02, msg.matrix_state.blocked[0]);
+}
+
 // Main test runner
 void setUp(void)
 {
@@ -750,6 +1442,8 @@ int main(int argc, char** argv)
     // Configure tests (Analog)
     RUN_TEST(test_configure_encode);
     RUN_TEST(test_configure_decode);
+    RUN_TEST(test_configure_decode_analog_filter);
+    RUN_TEST(test_configure_decode_analog_deadband);
     RUN_TEST(test_configure_decode_insufficient_data);
     RUN_TEST(test_configure_roundtrip);
 
@@ -764,6 +1458,13 @@ int main(int argc, char** argv)
     RUN_TEST(test_configure_matrix_roundtrip);
     RUN_TEST(test_configure_matrix_decode_insufficient_data);
     RUN_TEST(test_configure_matrix_decode_too_many_pins);
+    RUN_TEST(test_configure_notched_encode);
+    RUN_TEST(test_configure_notched_roundtrip);
+    RUN_TEST(test_configure_notched_decode_insufficient_data);
+    RUN_TEST(test_configure_notched_decode_too_many_boundaries);
+    RUN_TEST(test_configure_encoder_encode);
+    RUN_TEST(test_configure_encoder_decode_defaults);
+    RUN_TEST(test_configure_encoder_roundtrip);
     RUN_TEST(test_configure_decode_unknown_type);
 
     // ConfigurationStored tests
@@ -776,12 +1477,39 @@ int main(int argc, char** argv)
     RUN_TEST(test_configuration_error_decode);
     RUN_TEST(test_configuration_error_roundtrip);
 
+    // InputValue tests
+    RUN_TEST(test_input_value_encode);
+    RUN_TEST(test_input_value_roundtrip);
+    RUN_TEST(test_input_value_decode_without_timestamp);
+
     // SetOutput tests
     RUN_TEST(test_set_output_encode);
     RUN_TEST(test_set_output_decode);
     RUN_TEST(test_set_output_roundtrip);
     RUN_TEST(test_set_output_decode_insufficient_data);
 
+    // GetStats/Stats tests
+    RUN_TEST(test_get_stats_encode);
+    RUN_TEST(test_get_stats_decode);
+    RUN_TEST(test_stats_encode);
+    RUN_TEST(test_stats_encode_too_many_entries);
+    RUN_TEST(test_stats_roundtrip);
+    RUN_TEST(test_stats_decode_insufficient_data);
+    RUN_TEST(test_stats_decode_too_many_entries);
+
+    // Calibrate/CalibrationData tests
+    RUN_TEST(test_calibrate_encode);
+    RUN_TEST(test_calibrate_roundtrip);
+    RUN_TEST(test_calibrate_decode_insufficient_data);
+    RUN_TEST(test_calibration_data_roundtrip);
+    RUN_TEST(test_calibration_data_encode_buffer_too_small);
+
+    // MatrixState tests
+    RUN_TEST(test_matrix_state_encode);
+    RUN_TEST(test_matrix_state_roundtrip);
+    RUN_TEST(test_matrix_state_too_many_buttons);
+    RUN_TEST(test_matrix_state_decode_truncated_bitmap);
+
     // Message union tests
     RUN_TEST(test_message_decode_identity_request);
     RUN_TEST(test_message_decode_identity_response);
@@ -791,6 +1519,11 @@ int main(int argc, char** argv)
     RUN_TEST(test_message_decode_configuration_stored);
     RUN_TEST(test_message_decode_configuration_error);
     RUN_TEST(test_message_decode_set_output);
+    RUN_TEST(test_message_decode_get_stats);
+    RUN_TEST(test_message_decode_stats);
+    RUN_TEST(test_message_decode_calibrate);
+    RUN_TEST(test_message_decode_calibration_data);
+    RUN_TEST(test_message_decode_matrix_state);
     RUN_TEST(test_message_decode_invalid_type);
 
     // Error handling tests
@@ -0,0 +1,111 @@
+#include "../../src/quadrature.h"
+#include <unity.h>
+
+using namespace Sensor;
+
+// Pin states of one forward cycle (A leads B), starting after 11
+static const uint8_t FORWARD[4] = { 0x01, 0x00, 0x02, 0x03 };
+static const uint8_t BACKWARD[4] = { 0x02, 0x00, 0x01, 0x03 };
+
+// Feed a sequence of pin states, returning the detents counted
+static int feed(QuadratureDecoder& d, const uint8_t* states, int count)
+{
+    int detents = 0;
+    for (int i = 0; i < count; i++) {
+        detents += d.update(states[i]);
+    }
+    return detents;
+}
+
+// Test that a full cycle counts one detent, in either direction
+void test_quadrature_full_cycle()
+{
+    QuadratureDecoder d;
+    d.reset(0x03, 4);
+
+    // No detent before the cycle is complete
+    TEST_ASSERT_EQUAL(0, feed(d, FORWARD, 3));
+    TEST_ASSERT_EQUAL(1, d.update(FORWARD[3]));
+
+    TEST_ASSERT_EQUAL(-1, feed(d, BACKWARD, 4));
+    TEST_ASSERT_EQUAL(2, feed(d, FORWARD, 4) + feed(d, FORWARD, 4));
+}
+
+// Test that bounce on one pin cancels out
+void test_quadrature_bounce_cancels()
+{
+    QuadratureDecoder d;
+    d.reset(0x03, 4);
+
+    // A chatters between 1 and 0 on its way down
+    const uint8_t chatter[] = { 0x01, 0x03, 0x01, 0x03, 0x01, 0x00, 0x01, 0x00, 0x02, 0x03 };
+    TEST_ASSERT_EQUAL(1, feed(d, chatter, sizeof(chatter)));
+}
+
+// Test that a jump of both pins counts nothing, and the detent is recovered at rest
+void test_quadrature_missed_step()
+{
+    QuadratureDecoder d;
+    d.reset(0x03, 4);
+
+    // 01 -> 10 skips 00: only 2 of the 4 steps count
+    const uint8_t skipped[] = { 0x01, 0x02, 0x03 };
+    TEST_ASSERT_EQUAL(1, feed(d, skipped, sizeof(skipped)));
+
+    // Next detent isn't affected
+    TEST_ASSERT_EQUAL(1, feed(d, FORWARD, 4));
+
+    // Turned halfway and back: no detent
+    const uint8_t back[] = { 0x01, 0x00, 0x01, 0x03 };
+    TEST_ASSERT_EQUAL(0, feed(d, back, sizeof(back)));
+}
+
+// Test encoders with 1 or 2 steps per detent
+void test_quadrature_steps_per_detent()
+{
+    QuadratureDecoder half;
+    half.reset(0x03, 2);
+    TEST_ASSERT_EQUAL(0, half.update(0x01));
+    TEST_ASSERT_EQUAL(1, half.update(0x00));
+    TEST_ASSERT_EQUAL(1, feed(half, FORWARD + 2, 2));
+
+    QuadratureDecoder quarter;
+    quarter.reset(0x03, 1);
+    TEST_ASSERT_EQUAL(4, feed(quarter, FORWARD, 4));
+    TEST_ASSERT_EQUAL(-4, feed(quarter, BACKWARD, 4));
+}
+
+// Test acceleration by the time per detent
+void test_quadrature_acceleration()
+{
+    // Off, or slow: 1 per detent
+    TEST_ASSERT_EQUAL_INT16(5, accelerateDetents(5, 1000, 0));
+    TEST_ASSERT_EQUAL_INT16(3, accelerateDetents(3, 3 * ENCODER_ACCEL_SLOW_US, 10));
+    TEST_ASSERT_EQUAL_INT16(-3, accelerateDetents(-3, 3 * ENCODER_ACCEL_SLOW_US, 10));
+
+    // Half the slow time per detent: half the extra counts
+    TEST_ASSERT_EQUAL_INT16(2 * 6, accelerateDetents(2, ENCODER_ACCEL_SLOW_US, 10));
+    TEST_ASSERT_EQUAL_INT16(-2 * 6, accelerateDetents(-2, ENCODER_ACCEL_SLOW_US, 10));
+
+    // Full speed: 1 + acceleration per detent, clamped to 16 bits
+    TEST_ASSERT_EQUAL_INT16(4 * 11, accelerateDetents(4, 0, 10));
+    TEST_ASSERT_EQUAL_INT16(INT16_MAX, accelerateDetents(1000, 0, 255));
+    TEST_ASSERT_EQUAL_INT16(INT16_MIN, accelerateDetents(-1000, 0, 255));
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_quadrature_full_cycle);
+    RUN_TEST(test_quadrature_bounce_cancels);
+    RUN_TEST(test_quadrature_missed_step);
+    RUN_TEST(test_quadrature_steps_per_detent);
+    RUN_TEST(test_quadrature_acceleration);
+
+    return UNITY_END();
+}
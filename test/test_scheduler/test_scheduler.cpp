@@ -0,0 +1,288 @@
+#include "../../src/scheduler.h"
+#include <unity.h>
+
+using namespace Scheduler;
+
+// Per-task run counters
+static int g_runs_a = 0;
+static int g_runs_b = 0;
+static int g_runs_c = 0;
+
+// Run order tracking (task letters in the order they ran)
+static char g_order[16];
+static uint8_t g_order_len = 0;
+
+void task_a()
+{
+    g_runs_a++;
+    if (g_order_len < sizeof(g_order)) g_order[g_order_len++] = 'a';
+}
+
+void task_b()
+{
+    g_runs_b++;
+    if (g_order_len < sizeof(g_order)) g_order[g_order_len++] = 'b';
+}
+
+void task_c()
+{
+    g_runs_c++;
+    if (g_order_len < sizeof(g_order)) g_order[g_order_len++] = 'c';
+}
+
+// Test that tasks can be registered up to MAX_TASKS
+void test_scheduler_add_task()
+{
+    TaskScheduler s;
+
+    for (uint8_t i = 0; i < TaskScheduler::MAX_TASKS; i++) {
+        TEST_ASSERT_EQUAL(i, s.addTask(task_a, 1000, 1000));
+    }
+
+    TEST_ASSERT_EQUAL(TaskScheduler::INVALID_TASK, s.addTask(task_a, 1000, 1000));
+    TEST_ASSERT_EQUAL(TaskScheduler::MAX_TASKS, s.getTaskCount());
+}
+
+// Test that a null callback is rejected
+void test_scheduler_rejects_null_callback()
+{
+    TaskScheduler s;
+
+    TEST_ASSERT_EQUAL(TaskScheduler::INVALID_TASK, s.addTask(nullptr, 1000, 1000));
+    TEST_ASSERT_EQUAL(0, s.getTaskCount());
+}
+
+// Test that all tasks run on the first update
+void test_scheduler_first_update_runs_all()
+{
+    TaskScheduler s;
+    s.addTask(task_a, 1000, 1000);
+    s.addTask(task_b, 10000, 1000);
+
+    s.update(5000000);
+
+    TEST_ASSERT_EQUAL(1, g_runs_a);
+    TEST_ASSERT_EQUAL(1, g_runs_b);
+    TEST_ASSERT_EQUAL(0, s.getTotalMissedDeadlines());
+}
+
+// Test that tasks run at their own periods
+void test_scheduler_periods()
+{
+    TaskScheduler s;
+    s.addTask(task_a, 1000, 1000); // 1 kHz
+    s.addTask(task_b, 10000, 1000); // 100 Hz
+
+    // Update every 100us for 20ms
+    for (unsigned long t = 0; t < 20000; t += 100) {
+        s.update(t);
+    }
+
+    TEST_ASSERT_EQUAL(20, g_runs_a);
+    TEST_ASSERT_EQUAL(2, g_runs_b);
+    TEST_ASSERT_EQUAL(0, s.getTotalMissedDeadlines());
+}
+
+// Test that a zero-period task runs on every update
+void test_scheduler_zero_period_runs_every_update()
+{
+    TaskScheduler s;
+    s.addTask(task_a, 0, 0);
+
+    for (unsigned long t = 0; t < 50; t++) {
+        s.update(t);
+    }
+
+    TEST_ASSERT_EQUAL(50, g_runs_a);
+    TEST_ASSERT_EQUAL(0, s.getMissedDeadlines(0));
+}
+
+// Test that due tasks run earliest-deadline-first
+void test_scheduler_earliest_deadline_first()
+{
+    TaskScheduler s;
+    s.addTask(task_a, 1000, 800);
+    s.addTask(task_b, 1000, 200);
+    s.addTask(task_c, 1000, 500);
+
+    s.update(0);
+
+    TEST_ASSERT_EQUAL(3, g_order_len);
+    TEST_ASSERT_EQUAL('b', g_order[0]);
+    TEST_ASSERT_EQUAL('c', g_order[1]);
+    TEST_ASSERT_EQUAL('a', g_order[2]);
+}
+
+// Test that a late start beyond the deadline is counted
+void test_scheduler_missed_deadline()
+{
+    TaskScheduler s;
+    uint8_t id = s.addTask(task_a, 1000, 200);
+
+    s.update(0); // Release at 0, on time
+    s.update(1100); // Release at 1000, started 100us late - within deadline
+    TEST_ASSERT_EQUAL(0, s.getMissedDeadlines(id));
+
+    s.update(2500); // Release at 2000, started 500us late - missed
+    TEST_ASSERT_EQUAL(1, s.getMissedDeadlines(id));
+    TEST_ASSERT_EQUAL(3, g_runs_a);
+}
+
+// Test that a stall skips releases instead of bursting, counting each as missed
+void test_scheduler_overrun_skips_releases()
+{
+    TaskScheduler s;
+    uint8_t id = s.addTask(task_a, 1000, 200);
+
+    s.update(0);
+    s.update(5500); // Stalled for 5 periods
+
+    // Runs once (no burst catch-up)
+    TEST_ASSERT_EQUAL(2, g_runs_a);
+    // Late start + releases at 2000, 3000, 4000, 5000 skipped
+    TEST_ASSERT_EQUAL(5, s.getMissedDeadlines(id));
+
+    // Phase is kept: next release at 6000
+    s.update(5900);
+    TEST_ASSERT_EQUAL(2, g_runs_a);
+    s.update(6000);
+    TEST_ASSERT_EQUAL(3, g_runs_a);
+}
+
+// Test resetting missed deadline counters
+void test_scheduler_reset_missed_deadlines()
+{
+    TaskScheduler s;
+    s.addTask(task_a, 1000, 100);
+
+    s.update(0);
+    s.update(1500);
+    TEST_ASSERT_EQUAL(1, s.getTotalMissedDeadlines());
+
+    s.resetMissedDeadlines();
+    TEST_ASSERT_EQUAL(0, s.getTotalMissedDeadlines());
+}
+
+// Test changing a task period
+void test_scheduler_set_period()
+{
+    TaskScheduler s;
+    uint8_t id = s.addTask(task_a, 10000, 10000);
+
+    s.update(0);
+    TEST_ASSERT_EQUAL(1, g_runs_a);
+
+    // Shorter period takes effect immediately
+    s.setPeriod(id, 1000);
+    s.update(100);
+    TEST_ASSERT_EQUAL(2, g_runs_a);
+    s.update(1100);
+    TEST_ASSERT_EQUAL(3, g_runs_a);
+
+    // Longer period waits a full period
+    s.setPeriod(id, 100000);
+    s.update(2100);
+    TEST_ASSERT_EQUAL(3, g_runs_a);
+    s.update(101100);
+    TEST_ASSERT_EQUAL(4, g_runs_a);
+    TEST_ASSERT_EQUAL(0, s.getMissedDeadlines(id));
+}
+
+// Test that a triggered task runs early without shifting its schedule
+void test_scheduler_trigger()
+{
+    TaskScheduler s;
+    uint8_t id = s.addTask(task_a, 1000, 500);
+
+    s.update(0);
+    TEST_ASSERT_EQUAL(1, g_runs_a);
+
+    // Not released until 1000, but triggered at 300
+    s.trigger(id);
+    s.update(300);
+    TEST_ASSERT_EQUAL(2, g_runs_a);
+
+    // Trigger is consumed
+    s.update(400);
+    TEST_ASSERT_EQUAL(2, g_runs_a);
+
+    // Regular release still at 1000, no missed deadlines
+    s.update(1000);
+    TEST_ASSERT_EQUAL(3, g_runs_a);
+    TEST_ASSERT_EQUAL(0, s.getMissedDeadlines(id));
+}
+
+// Test time until the next periodic release (used to decide when to sleep)
+void test_scheduler_time_until_next_release()
+{
+    TaskScheduler s;
+    s.addTask(task_a, 0, 0); // Every update - ignored
+    uint8_t id = s.addTask(task_b, 1000, 500);
+    s.addTask(task_c, 10000, 500);
+
+    s.update(0);
+
+    TEST_ASSERT_EQUAL(1000, s.timeUntilNextRelease(0));
+    TEST_ASSERT_EQUAL(600, s.timeUntilNextRelease(400));
+    TEST_ASSERT_EQUAL(0, s.timeUntilNextRelease(1000));
+
+    // A triggered task is due now
+    s.trigger(id);
+    TEST_ASSERT_EQUAL(0, s.timeUntilNextRelease(400));
+}
+
+// Test that micros() wraparound doesn't stall tasks
+void test_scheduler_time_wraparound()
+{
+    TaskScheduler s;
+    s.addTask(task_a, 1000, 500);
+
+    unsigned long start = (unsigned long)-2500;
+    for (unsigned long i = 0; i < 5000; i += 100) {
+        s.update(start + i);
+    }
+
+    TEST_ASSERT_EQUAL(5, g_runs_a);
+    TEST_ASSERT_EQUAL(0, s.getTotalMissedDeadlines());
+}
+
+// Test out-of-range task ids
+void test_scheduler_invalid_task_id()
+{
+    TaskScheduler s;
+
+    TEST_ASSERT_EQUAL(0, s.getMissedDeadlines(3));
+    s.setPeriod(3, 1000); // Should not crash
+}
+
+void setUp(void)
+{
+    g_runs_a = 0;
+    g_runs_b = 0;
+    g_runs_c = 0;
+    g_order_len = 0;
+}
+
+void tearDown(void) {}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_scheduler_add_task);
+    RUN_TEST(test_scheduler_rejects_null_callback);
+    RUN_TEST(test_scheduler_first_update_runs_all);
+    RUN_TEST(test_scheduler_periods);
+    RUN_TEST(test_scheduler_zero_period_runs_every_update);
+    RUN_TEST(test_scheduler_earliest_deadline_first);
+    RUN_TEST(test_scheduler_missed_deadline);
+    RUN_TEST(test_scheduler_overrun_skips_releases);
+    RUN_TEST(test_scheduler_reset_missed_deadlines);
+    RUN_TEST(test_scheduler_set_period);
+    RUN_TEST(test_scheduler_trigger);
+    RUN_TEST(test_scheduler_time_until_next_release);
+    RUN_TEST(test_scheduler_time_wraparound);
+    RUN_TEST(test_scheduler_invalid_task_id);
+
+    return UNITY_END();
+}